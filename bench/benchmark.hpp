@@ -0,0 +1,321 @@
+#ifndef BENCH_BENCHMARK_HPP
+#define BENCH_BENCHMARK_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <deque>
+#include <functional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/*
+ * Minimal benchmark harness in the spirit of Google Benchmark:
+ *
+ *   void BenchPushBack(bench::State& state) {
+ *       while (state.KeepRunning()) {
+ *           ...work on state.Size() elements...
+ *       }
+ *       state.SetItemsProcessed(state.Iterations() * state.Size());
+ *   }
+ *   BENCHMARK(BenchPushBack).Range(16, 1 << 20);
+ *
+ * Every benchmark runs once per size of its range (powers of Multiplier),
+ * the iteration count grows until a run takes --min_time seconds. Results
+ * are printed as a table and written as JSON with --json=<path>.
+ *
+ * Options: --filter=<substring> --max_size=<n> --min_time=<seconds>
+ *          --json=<path>
+ */
+
+namespace bench {
+
+using Clock = std::chrono::steady_clock;
+
+/* Keeps the compiler from dropping computations whose result is unused */
+template <typename Type>
+inline void DoNotOptimize(const Type& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+inline void ClobberMemory() {
+    asm volatile("" : : : "memory");
+}
+
+class State {
+public:
+    State(size_t size, size_t iterations) : size_(size), iterations_(iterations), left_(iterations) {
+    }
+
+    /* Times the loop body, the first call starts the clock */
+    bool KeepRunning() {
+        if (left_ == iterations_ && !running_) {
+            this->ResumeTiming();
+        }
+
+        if (left_ == 0) {
+            this->PauseTiming();
+            return false;
+        }
+
+        left_--;
+        return true;
+    }
+
+    /* Excludes per-iteration setup from the measurement */
+    void PauseTiming() {
+        if (running_) {
+            elapsed_ += Clock::now() - start_;
+            running_ = false;
+        }
+    }
+
+    void ResumeTiming() {
+        if (!running_) {
+            start_ = Clock::now();
+            running_ = true;
+        }
+    }
+
+    size_t Size() const {
+        return size_;
+    }
+
+    size_t Iterations() const {
+        return iterations_;
+    }
+
+    double Seconds() const {
+        return std::chrono::duration<double>(elapsed_).count();
+    }
+
+    void SetItemsProcessed(size_t items) {
+        items_ = items;
+    }
+
+    void SetBytesProcessed(size_t bytes) {
+        bytes_ = bytes;
+    }
+
+    size_t ItemsProcessed() const {
+        return items_;
+    }
+
+    size_t BytesProcessed() const {
+        return bytes_;
+    }
+
+private:
+    size_t size_ = 0;
+    size_t iterations_ = 0;
+    size_t left_ = 0;
+    size_t items_ = 0;
+    size_t bytes_ = 0;
+
+    bool running_ = false;
+    Clock::time_point start_ = {};
+    Clock::duration elapsed_ = Clock::duration::zero();
+};
+
+class Benchmark {
+public:
+    Benchmark(std::string name, std::function<void(State&)> func) : name_(std::move(name)), func_(std::move(func)) {
+    }
+
+    /* Sizes lo, lo * multiplier, ... up to hi inclusive, 0 is followed by 1 */
+    Benchmark& Range(size_t lo, size_t hi) {
+        lo_ = lo;
+        hi_ = hi;
+        return *this;
+    }
+
+    Benchmark& Multiplier(size_t multiplier) {
+        multiplier_ = multiplier;
+        return *this;
+    }
+
+    const std::string& Name() const {
+        return name_;
+    }
+
+    std::vector<size_t> Sizes(size_t max_size) const {
+        std::vector<size_t> sizes;
+        for (size_t size = lo_; size <= std::min(hi_, max_size); size = std::max(size * multiplier_, size + 1)) {
+            sizes.push_back(size);
+            if (size > SIZE_MAX / std::max<size_t>(multiplier_, 2)) {
+                break;
+            }
+        }
+        return sizes;
+    }
+
+    void Run(State& state) const {
+        func_(state);
+    }
+
+private:
+    std::string name_;
+    std::function<void(State&)> func_;
+    size_t lo_ = 16;
+    size_t hi_ = 1 << 20;
+    size_t multiplier_ = 4;
+};
+
+struct Result {
+    std::string name = "";
+    size_t size = 0;
+    size_t iterations = 0;
+    double ns_per_iteration = 0;
+    double items_per_second = 0;
+    double bytes_per_second = 0;
+};
+
+struct Options {
+    std::string filter = "";
+    std::string json_path = "";
+    size_t max_size = 1 << 24;
+    double min_time = 0.2;
+};
+
+/* A deque keeps references returned by Register() valid */
+inline std::deque<Benchmark>& Registry() {
+    static std::deque<Benchmark> benchmarks;
+    return benchmarks;
+}
+
+inline Benchmark& Register(const char* name, void (*func)(State&)) {
+    Registry().emplace_back(name, func);
+    return Registry().back();
+}
+
+#define BENCH_CONCAT_IMPL(lhs, rhs) lhs##rhs
+#define BENCH_CONCAT(lhs, rhs) BENCH_CONCAT_IMPL(lhs, rhs)
+
+#define BENCHMARK(...)                                                              \
+    [[maybe_unused]] static ::bench::Benchmark& BENCH_CONCAT(benchmark_, __LINE__) = \
+        ::bench::Register(#__VA_ARGS__, __VA_ARGS__)
+
+namespace detail {
+
+inline Options ParseOptions(int argc, char** argv) {
+    Options options;
+    for (int arg = 1; arg < argc; arg++) {
+        const char* value = std::strchr(argv[arg], '=');
+        std::string key(argv[arg], value ? static_cast<size_t>(value - argv[arg]) : std::strlen(argv[arg]));
+        value = value ? value + 1 : "";
+
+        if (key == "--filter") {
+            options.filter = value;
+        } else if (key == "--json") {
+            options.json_path = value;
+        } else if (key == "--max_size") {
+            options.max_size = static_cast<size_t>(std::strtod(value, nullptr));
+        } else if (key == "--min_time") {
+            options.min_time = std::strtod(value, nullptr);
+        } else {
+            std::fprintf(stderr, "unknown option %s\n", argv[arg]);
+            std::exit(1);
+        }
+    }
+
+    return options;
+}
+
+inline Result RunOne(const Benchmark& benchmark, size_t size, double min_time) {
+    size_t iterations = 1;
+    while (true) {
+        State state(size, iterations);
+        benchmark.Run(state);
+        double seconds = state.Seconds();
+
+        if (seconds >= min_time || iterations >= 1000000000) {
+            Result result;
+            result.name = benchmark.Name() + "/" + std::to_string(size);
+            result.size = size;
+            result.iterations = iterations;
+            result.ns_per_iteration = seconds * 1e9 / static_cast<double>(iterations);
+            /* A run too short for the clock has no rate, JSON has no inf */
+            result.items_per_second = (seconds > 0) ? static_cast<double>(state.ItemsProcessed()) / seconds : 0;
+            result.bytes_per_second = (seconds > 0) ? static_cast<double>(state.BytesProcessed()) / seconds : 0;
+            return result;
+        }
+
+        /* Aim slightly past min_time, grow at most 10x per attempt */
+        double scale = (seconds > 0) ? min_time * 1.4 / seconds : 10.0;
+        size_t scaled = static_cast<size_t>(static_cast<double>(iterations) * std::min(scale, 10.0));
+        iterations = std::max(iterations + 1, scaled);
+    }
+}
+
+inline void WriteJson(const Options& options, const std::vector<Result>& results) {
+    FILE* file = std::fopen(options.json_path.c_str(), "w");
+    if (!file) {
+        std::perror(options.json_path.c_str());
+        std::exit(1);
+    }
+
+    std::time_t now = std::time(nullptr);
+    char date[32] = {};
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    std::fprintf(file, "{\n  \"context\": {\n");
+    std::fprintf(file, "    \"date\": \"%s\",\n", date);
+    std::fprintf(file, "    \"num_cpus\": %u,\n", std::thread::hardware_concurrency());
+    std::fprintf(file, "    \"max_size\": %zu,\n", options.max_size);
+    std::fprintf(file, "    \"min_time\": %g\n", options.min_time);
+    std::fprintf(file, "  },\n  \"benchmarks\": [\n");
+    for (size_t pos = 0; pos < results.size(); pos++) {
+        const Result& result = results[pos];
+        std::fprintf(file,
+                     "    {\"name\": \"%s\", \"size\": %zu, \"iterations\": %zu, \"real_time_ns\": %.3f, "
+                     "\"items_per_second\": %.3f, \"bytes_per_second\": %.3f}%s\n",
+                     result.name.c_str(), result.size, result.iterations, result.ns_per_iteration,
+                     result.items_per_second, result.bytes_per_second, (pos + 1 < results.size()) ? "," : "");
+    }
+    std::fprintf(file, "  ]\n}\n");
+    std::fclose(file);
+}
+
+}  // namespace detail
+
+inline int RunBenchmarks(int argc, char** argv) {
+    Options options = detail::ParseOptions(argc, argv);
+    std::vector<Result> results;
+
+    std::printf("%-60s %16s %12s %14s\n", "Benchmark", "Time", "Iterations", "Items/s");
+    for (const Benchmark& benchmark : Registry()) {
+        if (benchmark.Name().find(options.filter) == std::string::npos) {
+            continue;
+        }
+
+        for (size_t size : benchmark.Sizes(options.max_size)) {
+            Result result = detail::RunOne(benchmark, size, options.min_time);
+            std::printf("%-60s %13.1f ns %12zu %14.4g\n", result.name.c_str(), result.ns_per_iteration,
+                        result.iterations, result.items_per_second);
+            std::fflush(stdout);
+            results.push_back(result);
+        }
+    }
+
+    if (!options.json_path.empty()) {
+        detail::WriteJson(options, results);
+    }
+
+    return 0;
+}
+
+}  // namespace bench
+
+#define BENCHMARK_MAIN()                       \
+    int main(int argc, char** argv) {          \
+        return ::bench::RunBenchmarks(argc, argv); \
+    }
+
+#endif  // BENCH_BENCHMARK_HPP
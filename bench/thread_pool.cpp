@@ -0,0 +1,65 @@
+#include <atomic>
+#include <cstddef>
+#include <thread>
+
+#include <stdlike/thread_pool.hpp>
+#include <stdlike/vector.hpp>
+
+#include "benchmark.hpp"
+
+namespace {
+
+/* Benchmark sizes are thread counts here */
+const size_t kMaxThreads = std::max(1u, std::thread::hardware_concurrency());
+
+constexpr size_t kTasksPerRound = 1 << 10;
+
+/* Cost of one Spawn + run + Join accounting, tasks do nothing */
+void BenchSpawnOverhead(bench::State& state) {
+    stdlike::ThreadPool pool(state.Size(), true);
+    while (state.KeepRunning()) {
+        stdlike::ThreadPool::TaskGroup group;
+        for (size_t task = 0; task < kTasksPerRound; task++) {
+            pool.Spawn(group, []() {
+            });
+        }
+        pool.Join(group);
+    }
+    state.SetItemsProcessed(state.Iterations() * kTasksPerRound);
+}
+
+/* Recursive fork-join down to single-index leaves, exercises the deques and stealing */
+void BenchForkJoin(bench::State& state) {
+    stdlike::ThreadPool pool(state.Size(), true);
+    std::atomic<size_t> leaves = 0;
+    while (state.KeepRunning()) {
+        pool.ParallelFor(0, kTasksPerRound, 1, [&leaves](size_t, size_t) {
+            leaves.fetch_add(1, std::memory_order_relaxed);
+        });
+    }
+    state.SetItemsProcessed(leaves.load());
+}
+
+/* ParallelFor over a Vector<double>, memory bound */
+void BenchParallelForScaling(bench::State& state) {
+    static stdlike::Vector<double> vec(1 << 25, 1.0);
+    stdlike::ThreadPool pool(state.Size(), true);
+    double* data = vec.Data();
+    while (state.KeepRunning()) {
+        pool.ParallelFor(0, vec.Size(), 1 << 15, [data](size_t begin, size_t end) {
+            for (size_t pos = begin; pos < end; pos++) {
+                data[pos] = data[pos] * 1.0001 + 1.0;
+            }
+        });
+    }
+    state.SetItemsProcessed(state.Iterations() * vec.Size());
+    state.SetBytesProcessed(state.Iterations() * vec.Size() * sizeof(double) * 2);
+}
+
+}  // namespace
+
+BENCHMARK(BenchSpawnOverhead).Range(1, kMaxThreads).Multiplier(2);
+BENCHMARK(BenchForkJoin).Range(1, kMaxThreads).Multiplier(2);
+BENCHMARK(BenchParallelForScaling).Range(1, kMaxThreads).Multiplier(2);
+
+BENCHMARK_MAIN()
@@ -0,0 +1,501 @@
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <map>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <stdlike/algorithm.hpp>
+#include <stdlike/compact_vector.hpp>
+#include <stdlike/flat_map.hpp>
+#include <stdlike/jagged_vector.hpp>
+#include <stdlike/packed_vector.hpp>
+#include <stdlike/simd.hpp>
+#include <stdlike/vector.hpp>
+
+#include "benchmark.hpp"
+
+namespace {
+
+using StdVector = std::vector<int>;
+using Vector = stdlike::Vector<int>;
+using StdBitVector = std::vector<bool>;
+using BitVector = stdlike::Vector<bool>;
+using StdMap = std::map<int, int>;
+using FlatMap = stdlike::FlatMap<int, int>;
+
+constexpr size_t kMaxSize = size_t(1) << 30;
+
+/* Uniform spelling of the two container APIs */
+
+template <class Vec>
+struct ElementOf;
+
+template <class Type, class Alloc>
+struct ElementOf<std::vector<Type, Alloc>> {
+    using Element = Type;
+};
+
+template <class Type, class Alloc>
+struct ElementOf<stdlike::Vector<Type, Alloc>> {
+    using Element = Type;
+};
+
+template <class Vec>
+using Element = typename ElementOf<Vec>::Element;
+
+template <class Type>
+void PushBack(std::vector<Type>& vec, Type value) {
+    vec.push_back(value);
+}
+
+template <class Type>
+void PushBack(stdlike::Vector<Type>& vec, Type value) {
+    vec.PushBack(value);
+}
+
+template <class Type>
+void InsertAt(std::vector<Type>& vec, size_t pos, Type value) {
+    vec.insert(vec.begin() + static_cast<ptrdiff_t>(pos), value);
+}
+
+template <class Type>
+void InsertAt(stdlike::Vector<Type>& vec, size_t pos, Type value) {
+    vec.Insert(vec.begin() + static_cast<ptrdiff_t>(pos), value);
+}
+
+template <class Type>
+void EraseAt(std::vector<Type>& vec, size_t pos) {
+    vec.erase(vec.begin() + static_cast<ptrdiff_t>(pos));
+}
+
+template <class Type>
+void EraseAt(stdlike::Vector<Type>& vec, size_t pos) {
+    vec.Erase(vec.begin() + static_cast<ptrdiff_t>(pos));
+}
+
+template <class Type>
+void Resize(std::vector<Type>& vec, size_t size) {
+    vec.resize(size);
+}
+
+template <class Type>
+void Resize(stdlike::Vector<Type>& vec, size_t size) {
+    vec.Resize(size);
+}
+
+template <class Type>
+void Reserve(std::vector<Type>& vec, size_t size) {
+    vec.reserve(size);
+}
+
+template <class Type>
+void Reserve(stdlike::Vector<Type>& vec, size_t size) {
+    vec.Reserve(size);
+}
+
+template <class Type>
+size_t SizeOf(const std::vector<Type>& vec) {
+    return vec.size();
+}
+
+template <class Type>
+size_t SizeOf(const stdlike::Vector<Type>& vec) {
+    return vec.Size();
+}
+
+size_t CountOnes(const StdBitVector& vec) {
+    return static_cast<size_t>(std::count(vec.begin(), vec.end(), true));
+}
+
+size_t CountOnes(const BitVector& vec) {
+    return vec.Count();
+}
+
+template <class Type>
+size_t FindIndex(const std::vector<Type>& vec, Type value) {
+    return static_cast<size_t>(std::find(vec.begin(), vec.end(), value) - vec.begin());
+}
+
+template <class Type>
+size_t FindIndex(const stdlike::Vector<Type>& vec, Type value) {
+    return stdlike::Find(vec, value);
+}
+
+template <class Type>
+int64_t SumOf(const std::vector<Type>& vec) {
+    return std::accumulate(vec.begin(), vec.end(), int64_t(0));
+}
+
+template <class Type>
+int64_t SumOf(const stdlike::Vector<Type>& vec) {
+    return stdlike::Sum(vec);
+}
+
+bool MapContains(const StdMap& map, int key) {
+    return map.find(key) != map.end();
+}
+
+bool MapContains(const FlatMap& map, int key) {
+    return map.Contains(key);
+}
+
+template <class Type>
+Type Value(uint64_t seed) {
+    uint64_t mixed = seed * 0x9E3779B97F4A7C15ull;
+    if constexpr (std::is_same_v<Type, bool>) {
+        return (mixed >> 63) != 0;
+    } else {
+        return static_cast<Type>(mixed >> 33);
+    }
+}
+
+template <class Vec>
+Vec Filled(size_t size) {
+    Vec vec;
+    Resize(vec, size);
+    for (size_t pos = 0; pos < size; pos++) {
+        vec[pos] = Value<Element<Vec>>(pos);
+    }
+    return vec;
+}
+
+/* Benchmarks */
+
+template <class Vec>
+void BenchPushBack(bench::State& state) {
+    while (state.KeepRunning()) {
+        Vec vec;
+        for (size_t pos = 0; pos < state.Size(); pos++) {
+            PushBack(vec, Value<Element<Vec>>(pos));
+        }
+        bench::DoNotOptimize(SizeOf(vec));
+    }
+    state.SetItemsProcessed(state.Iterations() * state.Size());
+}
+
+/* One insert and one erase in the middle, both shift half the elements */
+template <class Vec>
+void BenchInsertErase(bench::State& state) {
+    Vec vec = Filled<Vec>(state.Size());
+    while (state.KeepRunning()) {
+        InsertAt(vec, state.Size() / 2, Value<Element<Vec>>(state.Size()));
+        EraseAt(vec, state.Size() / 2);
+        bench::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.Iterations() * state.Size());
+}
+
+template <class Vec>
+void BenchIterate(bench::State& state) {
+    Vec vec = Filled<Vec>(state.Size());
+    while (state.KeepRunning()) {
+        size_t sum = 0;
+        for (auto value : vec) {
+            sum += static_cast<size_t>(value);
+        }
+        bench::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.Iterations() * state.Size());
+    state.SetBytesProcessed(state.Iterations() * state.Size() * sizeof(Element<Vec>));
+}
+
+template <class Vec>
+void BenchSort(bench::State& state) {
+    Vec source = Filled<Vec>(state.Size());
+    Vec vec;
+    while (state.KeepRunning()) {
+        state.PauseTiming();
+        vec = source;
+        state.ResumeTiming();
+
+        std::sort(vec.begin(), vec.end());
+        bench::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.Iterations() * state.Size());
+}
+
+void BenchRadixSort(bench::State& state) {
+    Vector source = Filled<Vector>(state.Size());
+    Vector vec;
+    while (state.KeepRunning()) {
+        state.PauseTiming();
+        vec = source;
+        state.ResumeTiming();
+
+        stdlike::RadixSort(vec);
+        bench::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.Iterations() * state.Size());
+}
+
+void BenchParallelRadixSort(bench::State& state) {
+    Vector source = Filled<Vector>(state.Size());
+    Vector vec;
+    while (state.KeepRunning()) {
+        state.PauseTiming();
+        vec = source;
+        state.ResumeTiming();
+
+        stdlike::RadixSort(stdlike::par, vec);
+        bench::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.Iterations() * state.Size());
+}
+
+template <class Vec>
+void BenchCopy(bench::State& state) {
+    Vec source = Filled<Vec>(state.Size());
+    while (state.KeepRunning()) {
+        Vec copy(source);
+        bench::DoNotOptimize(SizeOf(copy));
+    }
+    state.SetItemsProcessed(state.Iterations() * state.Size());
+    state.SetBytesProcessed(state.Iterations() * state.Size() * sizeof(Element<Vec>));
+}
+
+/* Two moves per iteration, should not depend on the size */
+template <class Vec>
+void BenchMove(bench::State& state) {
+    Vec source = Filled<Vec>(state.Size());
+    while (state.KeepRunning()) {
+        Vec moved(std::move(source));
+        source = std::move(moved);
+        bench::ClobberMemory();
+    }
+}
+
+template <class Vec>
+void BenchResize(bench::State& state) {
+    while (state.KeepRunning()) {
+        Vec vec;
+        Resize(vec, state.Size());
+        bench::DoNotOptimize(SizeOf(vec));
+    }
+    state.SetItemsProcessed(state.Iterations() * state.Size());
+}
+
+template <class Vec>
+void BenchReserve(bench::State& state) {
+    while (state.KeepRunning()) {
+        Vec vec;
+        Reserve(vec, state.Size());
+        bench::DoNotOptimize(SizeOf(vec));
+    }
+}
+
+/* Values are non-negative, so -1 is never found and the whole vector is scanned */
+template <class Vec>
+void BenchFind(bench::State& state) {
+    Vec vec = Filled<Vec>(state.Size());
+    while (state.KeepRunning()) {
+        bench::DoNotOptimize(FindIndex(vec, -1));
+    }
+    state.SetItemsProcessed(state.Iterations() * state.Size());
+    state.SetBytesProcessed(state.Iterations() * state.Size() * sizeof(Element<Vec>));
+}
+
+template <class Vec>
+void BenchSum(bench::State& state) {
+    Vec vec = Filled<Vec>(state.Size());
+    while (state.KeepRunning()) {
+        bench::DoNotOptimize(SumOf(vec));
+    }
+    state.SetItemsProcessed(state.Iterations() * state.Size());
+    state.SetBytesProcessed(state.Iterations() * state.Size() * sizeof(Element<Vec>));
+}
+
+/* Size() vectors of 4 elements, e.g. posting lists; the handle size sets the memory of the outer vector */
+template <class Small>
+void BenchManySmall(bench::State& state) {
+    while (state.KeepRunning()) {
+        std::vector<Small> lists(state.Size());
+        for (Small& list : lists) {
+            for (int value = 0; value < 4; value++) {
+                list.PushBack(value);
+            }
+        }
+        bench::DoNotOptimize(lists.data());
+    }
+    state.SetItemsProcessed(state.Iterations() * state.Size());
+}
+
+/* Size() random edges over Size() / 8 vertices, each scan reads all adjacency lists */
+using NestedGraph = stdlike::Vector<stdlike::Vector<uint32_t>>;
+using JaggedGraph = stdlike::JaggedVector<uint32_t>;
+
+template <class Graph>
+Graph RandomGraph(size_t edges_n) {
+    size_t vertices_n = edges_n / 8 + 1;
+    stdlike::Vector<uint32_t> sources(edges_n, 0u);
+    stdlike::Vector<uint32_t> targets(edges_n, 0u);
+    for (size_t pos = 0; pos < edges_n; pos++) {
+        sources[pos] = static_cast<uint32_t>(Value<uint64_t>(pos) % vertices_n);
+        targets[pos] = static_cast<uint32_t>(Value<uint64_t>(edges_n + pos) % vertices_n);
+    }
+
+    if constexpr (std::is_same_v<Graph, JaggedGraph>) {
+        return JaggedGraph::FromPairs(vertices_n, sources, targets);
+    } else {
+        Graph graph(vertices_n);
+        for (size_t pos = 0; pos < edges_n; pos++) {
+            graph[sources[pos]].PushBack(targets[pos]);
+        }
+        return graph;
+    }
+}
+
+template <class Graph>
+void BenchAdjacencyScan(bench::State& state) {
+    Graph graph = RandomGraph<Graph>(state.Size());
+    while (state.KeepRunning()) {
+        uint64_t sum = 0;
+        for (const auto& neighbours : graph) {
+            for (uint32_t vertex : neighbours) {
+                sum += vertex;
+            }
+        }
+        bench::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.Iterations() * state.Size());
+}
+
+/* Size() entries, then Size() lookups of which about half hit */
+template <class Map>
+void BenchMapFind(bench::State& state) {
+    std::vector<std::pair<int, int>> entries;
+    for (size_t pos = 0; pos < state.Size(); pos++) {
+        entries.emplace_back(static_cast<int>(Value<uint64_t>(pos) % (2 * state.Size())), static_cast<int>(pos));
+    }
+    Map map;
+    if constexpr (std::is_same_v<Map, FlatMap>) {
+        map.InsertRange(entries);
+    } else {
+        map.insert(entries.begin(), entries.end());
+    }
+
+    while (state.KeepRunning()) {
+        size_t hits = 0;
+        for (size_t pos = 0; pos < state.Size(); pos++) {
+            hits += MapContains(map, static_cast<int>(Value<uint64_t>(~pos) % (2 * state.Size()))) ? 1 : 0;
+        }
+        bench::DoNotOptimize(hits);
+    }
+    state.SetItemsProcessed(state.Iterations() * state.Size());
+}
+
+/* Dictionary codes of 17 bits, a typical width for encoded columns */
+using PackedCodes = stdlike::PackedVector<17>;
+
+void BenchPackedPushBack(bench::State& state) {
+    while (state.KeepRunning()) {
+        PackedCodes vec;
+        for (size_t pos = 0; pos < state.Size(); pos++) {
+            vec.PushBack(pos & PackedCodes::kMask);
+        }
+        bench::DoNotOptimize(vec.Size());
+    }
+    state.SetItemsProcessed(state.Iterations() * state.Size());
+}
+
+void BenchPackedUnpack(bench::State& state) {
+    stdlike::Vector<uint32_t> codes(state.Size(), 0u);
+    for (size_t pos = 0; pos < state.Size(); pos++) {
+        codes[pos] = static_cast<uint32_t>(Value<uint64_t>(pos) & PackedCodes::kMask);
+    }
+    PackedCodes packed;
+    packed.Pack(codes);
+
+    while (state.KeepRunning()) {
+        packed.Unpack(codes);
+        bench::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.Iterations() * state.Size());
+    state.SetBytesProcessed(state.Iterations() * state.Size() * sizeof(uint32_t));
+}
+
+/* Scans for the only set bit, which is the last one */
+template <class Vec>
+void BenchBitFind(bench::State& state) {
+    Vec vec;
+    Resize(vec, state.Size());
+    vec[state.Size() - 1] = true;
+    while (state.KeepRunning()) {
+        auto found = std::find(vec.begin(), vec.end(), true);
+        bench::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(state.Iterations() * state.Size());
+}
+
+template <class Vec>
+void BenchBitCount(bench::State& state) {
+    Vec vec = Filled<Vec>(state.Size());
+    while (state.KeepRunning()) {
+        bench::DoNotOptimize(CountOnes(vec));
+    }
+    state.SetItemsProcessed(state.Iterations() * state.Size());
+}
+
+}  // namespace
+
+BENCHMARK(BenchPushBack<StdVector>).Range(16, kMaxSize);
+BENCHMARK(BenchPushBack<Vector>).Range(16, kMaxSize);
+BENCHMARK(BenchPushBack<StdBitVector>).Range(16, kMaxSize);
+BENCHMARK(BenchPushBack<BitVector>).Range(16, kMaxSize);
+
+BENCHMARK(BenchInsertErase<StdVector>).Range(16, kMaxSize);
+BENCHMARK(BenchInsertErase<Vector>).Range(16, kMaxSize);
+BENCHMARK(BenchInsertErase<StdBitVector>).Range(16, kMaxSize);
+BENCHMARK(BenchInsertErase<BitVector>).Range(16, kMaxSize);
+
+BENCHMARK(BenchIterate<StdVector>).Range(16, kMaxSize);
+BENCHMARK(BenchIterate<Vector>).Range(16, kMaxSize);
+BENCHMARK(BenchIterate<StdBitVector>).Range(16, kMaxSize);
+BENCHMARK(BenchIterate<BitVector>).Range(16, kMaxSize);
+
+BENCHMARK(BenchSort<StdVector>).Range(16, kMaxSize);
+BENCHMARK(BenchSort<Vector>).Range(16, kMaxSize);
+BENCHMARK(BenchRadixSort).Range(16, kMaxSize);
+BENCHMARK(BenchParallelRadixSort).Range(16, kMaxSize);
+
+BENCHMARK(BenchCopy<StdVector>).Range(16, kMaxSize);
+BENCHMARK(BenchCopy<Vector>).Range(16, kMaxSize);
+BENCHMARK(BenchCopy<StdBitVector>).Range(16, kMaxSize);
+BENCHMARK(BenchCopy<BitVector>).Range(16, kMaxSize);
+
+BENCHMARK(BenchMove<StdVector>).Range(16, kMaxSize);
+BENCHMARK(BenchMove<Vector>).Range(16, kMaxSize);
+
+BENCHMARK(BenchResize<StdVector>).Range(16, kMaxSize);
+BENCHMARK(BenchResize<Vector>).Range(16, kMaxSize);
+BENCHMARK(BenchResize<StdBitVector>).Range(16, kMaxSize);
+BENCHMARK(BenchResize<BitVector>).Range(16, kMaxSize);
+
+BENCHMARK(BenchReserve<StdVector>).Range(16, kMaxSize);
+BENCHMARK(BenchReserve<Vector>).Range(16, kMaxSize);
+
+BENCHMARK(BenchFind<StdVector>).Range(16, kMaxSize);
+BENCHMARK(BenchFind<Vector>).Range(16, kMaxSize);
+BENCHMARK(BenchSum<StdVector>).Range(16, kMaxSize);
+BENCHMARK(BenchSum<Vector>).Range(16, kMaxSize);
+
+BENCHMARK(BenchManySmall<Vector>).Range(16, kMaxSize / 16);
+BENCHMARK(BenchManySmall<stdlike::CompactVector<int>>).Range(16, kMaxSize / 16);
+
+BENCHMARK(BenchAdjacencyScan<NestedGraph>).Range(16, kMaxSize / 16);
+BENCHMARK(BenchAdjacencyScan<JaggedGraph>).Range(16, kMaxSize / 16);
+
+BENCHMARK(BenchMapFind<StdMap>).Range(16, kMaxSize / 16);
+BENCHMARK(BenchMapFind<FlatMap>).Range(16, kMaxSize / 16);
+
+BENCHMARK(BenchPackedPushBack).Range(16, kMaxSize);
+BENCHMARK(BenchPackedUnpack).Range(16, kMaxSize);
+
+BENCHMARK(BenchBitFind<StdBitVector>).Range(16, kMaxSize);
+BENCHMARK(BenchBitFind<BitVector>).Range(16, kMaxSize);
+BENCHMARK(BenchBitCount<StdBitVector>).Range(16, kMaxSize);
+BENCHMARK(BenchBitCount<BitVector>).Range(16, kMaxSize);
+
+BENCHMARK_MAIN()
@@ -0,0 +1,14 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by CMake Version 3.25
+cmake_policy(SET CMP0009 NEW)
+
+# bench_sources at CMakeLists.txt:93 (file)
+file(GLOB NEW_GLOB LIST_DIRECTORIES true "/root/repo/bench/*.cpp")
+set(OLD_GLOB
+  "/root/repo/bench/thread_pool.cpp"
+  "/root/repo/bench/vector.cpp"
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/build/asan/CMakeFiles/cmake.verify_globs")
+endif()
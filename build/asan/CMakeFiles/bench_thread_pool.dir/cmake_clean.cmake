@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_thread_pool.dir/bench/thread_pool.cpp.o"
+  "CMakeFiles/bench_thread_pool.dir/bench/thread_pool.cpp.o.d"
+  "bench_thread_pool"
+  "bench_thread_pool.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_thread_pool.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_vector.dir/bench/vector.cpp.o"
+  "CMakeFiles/bench_vector.dir/bench/vector.cpp.o.d"
+  "bench_vector"
+  "bench_vector.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_vector.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/vector.dir/main.cpp.o"
+  "CMakeFiles/vector.dir/main.cpp.o.d"
+  "vector"
+  "vector.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/vector.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
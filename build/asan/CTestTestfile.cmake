@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo
+# Build directory: /root/repo/build/asan
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test([=[vector.smoke]=] "/root/repo/build/asan/vector")
+set_tests_properties([=[vector.smoke]=] PROPERTIES  PASS_REGULAR_EXPRESSION "Found" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;82;add_test;/root/repo/CMakeLists.txt;0;")
@@ -1,23 +1,147 @@
+#ifndef SAFE_PRINT_HPP
+#define SAFE_PRINT_HPP
+
+#include <cstddef>
+#include <cstdint>
 #include <cstdio>
-#include <iostream>
-#include <utility>
+#include <algorithm>
+#include <charconv>
+#include <string>
+#include <string_view>
+#include <type_traits>
 
-#include <stdlike/move.hpp>
-#include <stdlike/forward.hpp>
+#include <stdlike/format.hpp>
+#include <stdlike/vector.hpp>
 
 namespace safe {
 
-template <typename T, typename... Args>
-void Print(const char* format, T&& arg, Args&&... args) {
-	while (*format != '%') {
-		putc(*format++, stdout);
-	}
-	if (*format != '%') {
-		std::cout << arg;
-		Print(++format,  stdlike::forward(args...));
-	} else {
-		putc(*format++, stdout);
-	}
+/*
+ * Print("x = %, y = %\n", x, y): every % is replaced by the next argument,
+ * %% prints a single %. The placeholder count is checked against the
+ * arguments at compile time. Output is assembled in a stack buffer and
+ * written with a single fwrite unless it exceeds the buffer.
+ */
+
+namespace detail {
+
+using PrintBuffer = stdlike::detail::FormatBuffer<FILE*>;
+
+template <typename Type>
+concept PrintableString = std::is_convertible_v<const Type&, std::string_view>;
+
+template <typename Type>
+struct IsNumericVector : std::false_type {};
+
+template <typename Type, class Alloc>
+struct IsNumericVector<stdlike::Vector<Type, Alloc>> : std::is_arithmetic<Type> {};
+
+template <typename Type>
+concept Printable = std::is_arithmetic_v<Type> || std::is_pointer_v<Type> || PrintableString<Type> ||
+                    IsNumericVector<Type>::value;
+
+/* Not constexpr, reaching it during constant evaluation is the compile error */
+inline void FormatError(const char*) {
 }
 
-} // namespace safe
+consteval size_t CountPlaceholders(std::string_view format) {
+    size_t count = 0;
+    for (size_t pos = 0; pos < format.size(); pos++) {
+        if (format[pos] != '%') {
+            continue;
+        }
+
+        if (pos + 1 < format.size() && format[pos + 1] == '%') {
+            pos++;
+        } else {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+template <typename... Args>
+class FormatString {
+public:
+    template <typename String>
+        requires std::is_convertible_v<const String&, std::string_view>
+    consteval FormatString(const String& format) : format_(format) {
+        if (CountPlaceholders(format_) != sizeof...(Args)) {
+            FormatError("safe::Print: placeholder count does not match the arguments");
+        }
+    }
+
+    std::string_view Get() const {
+        return format_;
+    }
+
+private:
+    std::string_view format_;
+};
+
+/* Writes format up to the next placeholder, %% is unescaped on the way */
+inline void PrintLiteral(PrintBuffer& buffer, std::string_view& format) {
+    while (!format.empty()) {
+        size_t percent = format.find('%');
+        buffer.Append(format.data(), std::min(percent, format.size()));
+        if (percent == std::string_view::npos) {
+            format = {};
+            return;
+        }
+
+        if (percent + 1 < format.size() && format[percent + 1] == '%') {
+            buffer.Append("%", 1);
+            format.remove_prefix(percent + 2);
+        } else {
+            format.remove_prefix(percent + 1);
+            return;
+        }
+    }
+}
+
+template <Printable Type>
+void PrintArgument(PrintBuffer& buffer, const Type& arg) {
+    if constexpr (std::is_same_v<Type, bool>) {
+        buffer.Append(arg ? "true" : "false", arg ? 4 : 5);
+    } else if constexpr (std::is_arithmetic_v<Type>) {
+        buffer.AppendNumber(arg, -1);
+    } else if constexpr (PrintableString<Type>) {
+        if constexpr (std::is_pointer_v<Type>) {
+            if (arg == nullptr) {
+                return buffer.Append("(null)", 6);
+            }
+        }
+        std::string_view text = arg;
+        buffer.Append(text.data(), text.size());
+    } else if constexpr (std::is_pointer_v<Type>) {
+        char hex[2 + 2 * sizeof(uintptr_t)] = {'0', 'x'};
+        std::to_chars_result result = std::to_chars(hex + 2, hex + sizeof(hex), reinterpret_cast<uintptr_t>(arg), 16);
+        buffer.Append(hex, static_cast<size_t>(result.ptr - hex));
+    } else {
+        buffer.Append("[", 1);
+        stdlike::Format(arg, [&buffer](const char* data, size_t size) {
+            buffer.Append(data, size);
+        }, stdlike::FormatOptions{", "});
+        buffer.Append("]", 1);
+    }
+}
+
+}  // namespace detail
+
+template <detail::Printable... Args>
+void Print(FILE* file, detail::FormatString<std::type_identity_t<Args>...> format, const Args&... args) {
+    detail::PrintBuffer buffer(file);
+    std::string_view rest = format.Get();
+
+    ((detail::PrintLiteral(buffer, rest), detail::PrintArgument(buffer, args)), ...);
+    detail::PrintLiteral(buffer, rest);
+}
+
+template <detail::Printable... Args>
+void Print(detail::FormatString<std::type_identity_t<Args>...> format, const Args&... args) {
+    Print<Args...>(stdout, format, args...);
+}
+
+}  // namespace safe
+
+#endif  // SAFE_PRINT_HPP
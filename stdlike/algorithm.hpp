@@ -0,0 +1,655 @@
+#ifndef STDLIKE_ALGORITHM_HPP
+#define STDLIKE_ALGORITHM_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <bit>
+#include <functional>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+#include <stdlike/execution.hpp>
+#include <stdlike/vector.hpp>
+
+namespace stdlike {
+
+/*
+ * Algorithms work on the raw contiguous storage of the vector. Parallel
+ * overloads split it into chunks of at least kParallelThreshold / 4
+ * elements, at most one per thread, and run the serial version when the
+ * input is shorter than two such chunks
+ */
+
+namespace detail {
+
+inline size_t ChunksCount(size_t size) {
+    size_t chunks_n = size / (kParallelThreshold / 4);
+    return chunks_n <= 1 ? 1 : std::min(ConcurrencyLevel(), chunks_n);
+}
+
+inline size_t ChunkBegin(size_t size, size_t chunks_n, size_t chunk) {
+    return size / chunks_n * chunk + std::min(chunk, size % chunks_n);
+}
+
+template <typename Func>
+void ForEachChunk(size_t size, size_t chunks_n, Func func) {
+    ParallelFor(0, chunks_n, 1, [size, chunks_n, &func](size_t first_chunk, size_t last_chunk) {
+        for (size_t chunk = first_chunk; chunk < last_chunk; chunk++) {
+            func(chunk, ChunkBegin(size, chunks_n, chunk), ChunkBegin(size, chunks_n, chunk + 1));
+        }
+    });
+}
+
+/* Merges sorted chunks pairwise, every round halves their number */
+template <typename Type, typename Compare>
+void MergeChunks(Type* first, size_t size, size_t chunks_n, Compare comp) {
+    for (size_t width = 1; width < chunks_n; width *= 2) {
+        size_t pairs_n = (chunks_n + 2 * width - 1) / (2 * width);
+        ParallelFor(0, pairs_n, 1, [=](size_t first_pair, size_t last_pair) {
+            for (size_t pair = first_pair; pair < last_pair; pair++) {
+                size_t left = pair * 2 * width;
+                size_t middle = std::min(chunks_n, left + width);
+                size_t right = std::min(chunks_n, left + 2 * width);
+                if (middle < right) {
+                    std::inplace_merge(first + ChunkBegin(size, chunks_n, left),
+                                       first + ChunkBegin(size, chunks_n, middle),
+                                       first + ChunkBegin(size, chunks_n, right), comp);
+                }
+            }
+        });
+    }
+}
+
+template <typename Type>
+concept NotBool = !std::is_same_v<Type, bool>;
+
+}  // namespace detail
+
+/* Sort */
+
+template <typename Type, typename Compare = std::less<>>
+void Sort(Type* first, Type* last, Compare comp = {}) {
+    std::sort(first, last, comp);
+}
+
+template <typename Type, typename Compare = std::less<>>
+void Sort(ParallelPolicy, Type* first, Type* last, Compare comp = {}) {
+    size_t size = static_cast<size_t>(last - first);
+    size_t chunks_n = detail::ChunksCount(size);
+    if (chunks_n == 1) {
+        return Sort(first, last, comp);
+    }
+
+    detail::ForEachChunk(size, chunks_n, [first, &comp](size_t, size_t begin, size_t end) {
+        std::sort(first + begin, first + end, comp);
+    });
+    detail::MergeChunks(first, size, chunks_n, comp);
+}
+
+/* StableSort */
+
+template <typename Type, typename Compare = std::less<>>
+void StableSort(Type* first, Type* last, Compare comp = {}) {
+    std::stable_sort(first, last, comp);
+}
+
+template <typename Type, typename Compare = std::less<>>
+void StableSort(ParallelPolicy, Type* first, Type* last, Compare comp = {}) {
+    size_t size = static_cast<size_t>(last - first);
+    size_t chunks_n = detail::ChunksCount(size);
+    if (chunks_n == 1) {
+        return StableSort(first, last, comp);
+    }
+
+    detail::ForEachChunk(size, chunks_n, [first, &comp](size_t, size_t begin, size_t end) {
+        std::stable_sort(first + begin, first + end, comp);
+    });
+    detail::MergeChunks(first, size, chunks_n, comp);
+}
+
+/*
+ * RadixSort: stable LSD sort by an integer or floating point key, 8 bits per
+ * pass. One counting pass builds the histograms of all digits, digits that
+ * are the same for every key are skipped. The scatter prefetches the
+ * destinations of elements a few positions ahead. Floats are ordered
+ * -NaN < -inf < ... < -0.0 < +0.0 < ... < +inf < NaN. The elements are
+ * copied with memcpy semantics, so they have to be trivially copyable.
+ */
+
+namespace detail {
+
+template <typename Key>
+concept RadixKey = (std::is_integral_v<Key> && !std::is_same_v<Key, bool>) || std::is_same_v<Key, float> ||
+                   std::is_same_v<Key, double>;
+
+struct RadixIdentity {
+    template <typename Type>
+    const Type& operator()(const Type& value) const {
+        return value;
+    }
+};
+
+template <typename Type, typename KeyFunc>
+using RadixKeyOf = std::remove_cvref_t<std::invoke_result_t<KeyFunc&, const Type&>>;
+
+template <typename Type, typename KeyFunc>
+concept RadixSortable = std::is_trivially_copyable_v<Type> && RadixKey<RadixKeyOf<Type, KeyFunc>>;
+
+inline constexpr size_t kRadixDigitBits = 8;
+inline constexpr size_t kRadixBuckets = size_t(1) << kRadixDigitBits;
+inline constexpr size_t kRadixSortMinSize = 256;
+inline constexpr size_t kRadixPrefetchDistance = 16;
+
+/* Unsigned integer with the order of key: flips the sign bit, and all bits of negative floats */
+template <RadixKey Key>
+auto RadixOrderedBits(Key key) {
+    if constexpr (std::is_floating_point_v<Key>) {
+        using Bits = std::conditional_t<sizeof(Key) == 4, uint32_t, uint64_t>;
+        constexpr Bits kSign = Bits(1) << (sizeof(Bits) * 8 - 1);
+        Bits bits = std::bit_cast<Bits>(key);
+        return (bits & kSign) != 0 ? static_cast<Bits>(~bits) : static_cast<Bits>(bits | kSign);
+    } else {
+        using Bits = std::make_unsigned_t<Key>;
+        if constexpr (std::is_signed_v<Key>) {
+            constexpr Bits kSign = static_cast<Bits>(Bits(1) << (sizeof(Bits) * 8 - 1));
+            return static_cast<Bits>(static_cast<Bits>(key) ^ kSign);
+        } else {
+            return key;
+        }
+    }
+}
+
+template <typename Type, typename KeyFunc>
+size_t RadixDigit(const Type& value, KeyFunc& key, size_t shift) {
+    return static_cast<size_t>(RadixOrderedBits(key(value)) >> shift) & (kRadixBuckets - 1);
+}
+
+/* Histograms of all digits in one pass, counts[digit * kRadixBuckets + bucket] */
+template <typename Type, typename KeyFunc>
+void RadixCountAll(const Type* data, size_t size, KeyFunc& key, size_t* counts) {
+    constexpr size_t kDigits = sizeof(RadixKeyOf<Type, KeyFunc>);
+    for (size_t pos = 0; pos < size; pos++) {
+        auto bits = RadixOrderedBits(key(data[pos]));
+        for (size_t digit = 0; digit < kDigits; digit++) {
+            size_t bucket = static_cast<size_t>(bits >> (digit * kRadixDigitBits)) & (kRadixBuckets - 1);
+            counts[digit * kRadixBuckets + bucket]++;
+        }
+    }
+}
+
+template <typename Type, typename KeyFunc>
+void RadixCountDigit(const Type* data, size_t size, KeyFunc& key, size_t shift, size_t* counts) {
+    for (size_t pos = 0; pos < size; pos++) {
+        counts[RadixDigit(data[pos], key, shift)]++;
+    }
+}
+
+/* A digit that is the same in every key does not move anything */
+inline bool RadixDigitIsConstant(const size_t* counts, size_t size) {
+    return std::find(counts, counts + kRadixBuckets, size) != counts + kRadixBuckets;
+}
+
+/* Stable scatter of in[begin, end) into out, offsets are the next free slot of every bucket */
+template <typename Type, typename KeyFunc>
+void RadixScatter(const Type* in, size_t begin, size_t end, Type* out, KeyFunc& key, size_t shift, size_t* offsets) {
+    size_t pos = begin;
+    for (; pos + kRadixPrefetchDistance < end; pos++) {
+        __builtin_prefetch(out + offsets[RadixDigit(in[pos + kRadixPrefetchDistance], key, shift)], 1);
+        out[offsets[RadixDigit(in[pos], key, shift)]++] = in[pos];
+    }
+    for (; pos < end; pos++) {
+        out[offsets[RadixDigit(in[pos], key, shift)]++] = in[pos];
+    }
+}
+
+template <typename Type, typename KeyFunc>
+void RadixSortSerial(Type* data, Type* scratch, size_t size, KeyFunc& key) {
+    constexpr size_t kDigits = sizeof(RadixKeyOf<Type, KeyFunc>);
+    std::vector<size_t> counts(kDigits * kRadixBuckets, 0);
+    RadixCountAll(data, size, key, counts.data());
+
+    Type* in = data;
+    Type* out = scratch;
+    for (size_t digit = 0; digit < kDigits; digit++) {
+        size_t* offsets = counts.data() + digit * kRadixBuckets;
+        if (RadixDigitIsConstant(offsets, size)) {
+            continue;
+        }
+
+        std::exclusive_scan(offsets, offsets + kRadixBuckets, offsets, size_t(0));
+        RadixScatter(in, 0, size, out, key, digit * kRadixDigitBits, offsets);
+        std::swap(in, out);
+    }
+
+    if (in != data) {
+        std::memcpy(static_cast<void*>(data), in, size * sizeof(Type));
+    }
+}
+
+/*
+ * Every pass counts the digit per chunk, then each chunk scatters into its
+ * own slice of every bucket: bucket-major, chunk-minor offsets keep it stable
+ */
+template <typename Type, typename KeyFunc>
+void RadixSortParallel(Type* data, Type* scratch, size_t size, KeyFunc& key, size_t chunks_n) {
+    constexpr size_t kDigits = sizeof(RadixKeyOf<Type, KeyFunc>);
+    std::vector<size_t> chunk_counts(chunks_n * kDigits * kRadixBuckets, 0);
+    ForEachChunk(size, chunks_n, [&](size_t chunk, size_t begin, size_t end) {
+        RadixCountAll(data + begin, end - begin, key, chunk_counts.data() + chunk * kDigits * kRadixBuckets);
+    });
+
+    std::vector<size_t> counts(kDigits * kRadixBuckets, 0);
+    for (size_t chunk = 0; chunk < chunks_n; chunk++) {
+        for (size_t pos = 0; pos < kDigits * kRadixBuckets; pos++) {
+            counts[pos] += chunk_counts[chunk * kDigits * kRadixBuckets + pos];
+        }
+    }
+
+    std::vector<size_t> offsets(chunks_n * kRadixBuckets);
+    Type* in = data;
+    Type* out = scratch;
+    for (size_t digit = 0; digit < kDigits; digit++) {
+        if (RadixDigitIsConstant(counts.data() + digit * kRadixBuckets, size)) {
+            continue;
+        }
+
+        size_t shift = digit * kRadixDigitBits;
+        ForEachChunk(size, chunks_n, [&](size_t chunk, size_t begin, size_t end) {
+            size_t* chunk_offsets = offsets.data() + chunk * kRadixBuckets;
+            std::fill(chunk_offsets, chunk_offsets + kRadixBuckets, size_t(0));
+            RadixCountDigit(in + begin, end - begin, key, shift, chunk_offsets);
+        });
+
+        size_t total = 0;
+        for (size_t bucket = 0; bucket < kRadixBuckets; bucket++) {
+            for (size_t chunk = 0; chunk < chunks_n; chunk++) {
+                size_t count = offsets[chunk * kRadixBuckets + bucket];
+                offsets[chunk * kRadixBuckets + bucket] = total;
+                total += count;
+            }
+        }
+
+        ForEachChunk(size, chunks_n, [&](size_t chunk, size_t begin, size_t end) {
+            RadixScatter(in, begin, end, out, key, shift, offsets.data() + chunk * kRadixBuckets);
+        });
+        std::swap(in, out);
+    }
+
+    if (in != data) {
+        ParallelFor(0, size, kParallelThreshold / 4, [data, in](size_t begin, size_t end) {
+            std::memcpy(static_cast<void*>(data + begin), in + begin, (end - begin) * sizeof(Type));
+        });
+    }
+}
+
+/* Uninitialized buffer from allocator, given back when it goes out of scope */
+template <typename Type, class Alloc>
+class ScratchBuffer {
+public:
+    ScratchBuffer(Alloc& allocator, size_t size)
+        : allocator_(allocator), data_(allocator.allocate(size)), size_(size) {
+    }
+
+    ScratchBuffer(const ScratchBuffer&) = delete;
+    ScratchBuffer& operator=(const ScratchBuffer&) = delete;
+
+    ~ScratchBuffer() {
+        allocator_.deallocate(data_, size_);
+    }
+
+    Type* Data() const {
+        return data_;
+    }
+
+private:
+    Alloc& allocator_;
+    Type* data_;
+    size_t size_;
+};
+
+/* Scratch buffer of the size of the input comes from allocator, key may throw */
+template <typename Type, typename KeyFunc, class Alloc>
+void RadixSortWith(Alloc& allocator, Type* first, size_t size, KeyFunc& key, size_t chunks_n) {
+    if (size < kRadixSortMinSize) {
+        std::stable_sort(first, first + size, [&key](const Type& lhs, const Type& rhs) {
+            return RadixOrderedBits(key(lhs)) < RadixOrderedBits(key(rhs));
+        });
+        return;
+    }
+
+    ScratchBuffer<Type, Alloc> scratch(allocator, size);
+    if (chunks_n == 1) {
+        RadixSortSerial(first, scratch.Data(), size, key);
+    } else {
+        RadixSortParallel(first, scratch.Data(), size, key, chunks_n);
+    }
+}
+
+}  // namespace detail
+
+template <typename Type, typename KeyFunc = detail::RadixIdentity>
+    requires detail::RadixSortable<Type, KeyFunc>
+void RadixSort(Type* first, Type* last, KeyFunc key = {}) {
+    Allocator<Type> allocator;
+    detail::RadixSortWith(allocator, first, static_cast<size_t>(last - first), key, 1);
+}
+
+template <typename Type, typename KeyFunc = detail::RadixIdentity>
+    requires detail::RadixSortable<Type, KeyFunc>
+void RadixSort(ParallelPolicy, Type* first, Type* last, KeyFunc key = {}) {
+    size_t size = static_cast<size_t>(last - first);
+    Allocator<Type> allocator;
+    detail::RadixSortWith(allocator, first, size, key, detail::ChunksCount(size));
+}
+
+/* TransformReduce */
+
+template <typename Type, typename Result, typename ReduceOp, typename TransformOp>
+Result TransformReduce(const Type* first, const Type* last, Result init, ReduceOp reduce, TransformOp transform) {
+    for (; first != last; ++first) {
+        init = reduce(init, transform(*first));
+    }
+
+    return init;
+}
+
+template <typename Type, typename Result, typename ReduceOp, typename TransformOp>
+Result TransformReduce(ParallelPolicy, const Type* first, const Type* last, Result init, ReduceOp reduce,
+                       TransformOp transform) {
+    size_t size = static_cast<size_t>(last - first);
+    size_t chunks_n = detail::ChunksCount(size);
+    if (chunks_n == 1) {
+        return TransformReduce(first, last, init, reduce, transform);
+    }
+
+    /* Every chunk is seeded with its own first element, init is accounted once */
+    std::vector<Result> partials(chunks_n, init);
+    detail::ForEachChunk(size, chunks_n, [&](size_t chunk, size_t begin, size_t end) {
+        Result partial = transform(first[begin]);
+        partials[chunk] = TransformReduce(first + begin + 1, first + end, partial, reduce, transform);
+    });
+
+    for (const Result& partial : partials) {
+        init = reduce(init, partial);
+    }
+
+    return init;
+}
+
+/* Reduce */
+
+template <typename Type, typename Result = Type, typename Op = std::plus<>>
+Result Reduce(const Type* first, const Type* last, Result init = Result(), Op op = {}) {
+    return TransformReduce(first, last, init, op, std::identity());
+}
+
+template <typename Type, typename Result = Type, typename Op = std::plus<>>
+Result Reduce(ParallelPolicy, const Type* first, const Type* last, Result init = Result(), Op op = {}) {
+    return TransformReduce(par, first, last, init, op, std::identity());
+}
+
+/* InclusiveScan, out may be equal to first */
+
+template <typename Type, typename Op = std::plus<>>
+void InclusiveScan(const Type* first, const Type* last, Type* out, Op op = {}) {
+    if (first == last) {
+        return;
+    }
+
+    Type sum = *first;
+    *out = sum;
+    while (++first != last) {
+        sum = op(sum, *first);
+        *++out = sum;
+    }
+}
+
+template <typename Type, typename Op = std::plus<>>
+void InclusiveScan(ParallelPolicy, const Type* first, const Type* last, Type* out, Op op = {}) {
+    size_t size = static_cast<size_t>(last - first);
+    size_t chunks_n = detail::ChunksCount(size);
+    if (chunks_n == 1) {
+        return InclusiveScan(first, last, out, op);
+    }
+
+    /* Pass 1: chunk totals, pass 2: scan every chunk with its carry */
+    std::vector<Type> totals(chunks_n, first[0]);
+    detail::ForEachChunk(size, chunks_n, [&](size_t chunk, size_t begin, size_t end) {
+        totals[chunk] = Reduce(first + begin + 1, first + end, first[begin], op);
+    });
+
+    for (size_t chunk = 2; chunk < chunks_n; chunk++) {
+        totals[chunk - 1] = op(totals[chunk - 2], totals[chunk - 1]);
+    }
+
+    detail::ForEachChunk(size, chunks_n, [&](size_t chunk, size_t begin, size_t end) {
+        if (chunk == 0) {
+            return InclusiveScan(first + begin, first + end, out + begin, op);
+        }
+
+        Type sum = totals[chunk - 1];
+        for (size_t pos = begin; pos < end; pos++) {
+            sum = op(sum, first[pos]);
+            out[pos] = sum;
+        }
+    });
+}
+
+/* ForEach */
+
+template <typename Type, typename Func>
+void ForEach(Type* first, Type* last, Func func) {
+    for (; first != last; ++first) {
+        func(*first);
+    }
+}
+
+template <typename Type, typename Func>
+void ForEach(ParallelPolicy, Type* first, Type* last, Func func) {
+    ParallelFor(0, static_cast<size_t>(last - first), kParallelThreshold / 4, [first, &func](size_t begin, size_t end) {
+        ForEach(first + begin, first + end, func);
+    });
+}
+
+/* Partition, returns the end of the range satisfying pred */
+
+template <typename Type, typename Predicate>
+Type* Partition(Type* first, Type* last, Predicate pred) {
+    return std::partition(first, last, pred);
+}
+
+template <typename Type, typename Predicate>
+Type* Partition(ParallelPolicy, Type* first, Type* last, Predicate pred) {
+    size_t size = static_cast<size_t>(last - first);
+    size_t chunks_n = detail::ChunksCount(size);
+    if (chunks_n == 1) {
+        return Partition(first, last, pred);
+    }
+
+    /* Partition chunks locally, then gather their halves through a scratch buffer */
+    std::vector<size_t> true_ends(chunks_n);
+    detail::ForEachChunk(size, chunks_n, [&](size_t chunk, size_t begin, size_t end) {
+        true_ends[chunk] = static_cast<size_t>(std::partition(first + begin, first + end, pred) - first);
+    });
+
+    std::vector<size_t> true_offsets(chunks_n + 1, 0);
+    for (size_t chunk = 0; chunk < chunks_n; chunk++) {
+        size_t chunk_trues = true_ends[chunk] - detail::ChunkBegin(size, chunks_n, chunk);
+        true_offsets[chunk + 1] = true_offsets[chunk] + chunk_trues;
+    }
+
+    size_t trues_n = true_offsets[chunks_n];
+    Allocator<Type> allocator;
+    Type* scratch = allocator.Allocate(size);
+
+    detail::ForEachChunk(size, chunks_n, [&](size_t chunk, size_t begin, size_t end) {
+        size_t false_offset = trues_n + (begin - true_offsets[chunk]);
+        std::uninitialized_move(first + begin, first + true_ends[chunk], scratch + true_offsets[chunk]);
+        std::uninitialized_move(first + true_ends[chunk], first + end, scratch + false_offset);
+    });
+
+    ParallelFor(0, size, kParallelThreshold / 4, [first, scratch](size_t begin, size_t end) {
+        std::move(scratch + begin, scratch + end, first + begin);
+        std::destroy(scratch + begin, scratch + end);
+    });
+
+    allocator.Deallocate(scratch, size);
+    return first + trues_n;
+}
+
+/* Vector overloads */
+
+template <detail::NotBool Type, class Alloc, typename Compare = std::less<>>
+void Sort(Vector<Type, Alloc>& vec, Compare comp = {}) {
+    Sort(vec.Data(), vec.Data() + vec.Size(), comp);
+}
+
+template <detail::NotBool Type, class Alloc, typename Compare = std::less<>>
+void Sort(ParallelPolicy, Vector<Type, Alloc>& vec, Compare comp = {}) {
+    Sort(par, vec.Data(), vec.Data() + vec.Size(), comp);
+}
+
+template <detail::NotBool Type, class Alloc, typename Compare = std::less<>>
+void StableSort(Vector<Type, Alloc>& vec, Compare comp = {}) {
+    StableSort(vec.Data(), vec.Data() + vec.Size(), comp);
+}
+
+template <detail::NotBool Type, class Alloc, typename Compare = std::less<>>
+void StableSort(ParallelPolicy, Vector<Type, Alloc>& vec, Compare comp = {}) {
+    StableSort(par, vec.Data(), vec.Data() + vec.Size(), comp);
+}
+
+/* Scratch space comes from the allocator of the vector */
+template <detail::NotBool Type, class Alloc, typename KeyFunc = detail::RadixIdentity>
+    requires detail::RadixSortable<Type, KeyFunc>
+void RadixSort(Vector<Type, Alloc>& vec, KeyFunc key = {}) {
+    Alloc allocator = vec.GetAllocator();
+    detail::RadixSortWith(allocator, vec.Data(), vec.Size(), key, 1);
+}
+
+template <detail::NotBool Type, class Alloc, typename KeyFunc = detail::RadixIdentity>
+    requires detail::RadixSortable<Type, KeyFunc>
+void RadixSort(ParallelPolicy, Vector<Type, Alloc>& vec, KeyFunc key = {}) {
+    Alloc allocator = vec.GetAllocator();
+    detail::RadixSortWith(allocator, vec.Data(), vec.Size(), key, detail::ChunksCount(vec.Size()));
+}
+
+template <detail::NotBool Type, class Alloc, typename Result = Type, typename Op = std::plus<>>
+Result Reduce(const Vector<Type, Alloc>& vec, Result init = Result(), Op op = {}) {
+    return Reduce(vec.Data(), vec.Data() + vec.Size(), init, op);
+}
+
+template <detail::NotBool Type, class Alloc, typename Result = Type, typename Op = std::plus<>>
+Result Reduce(ParallelPolicy, const Vector<Type, Alloc>& vec, Result init = Result(), Op op = {}) {
+    return Reduce(par, vec.Data(), vec.Data() + vec.Size(), init, op);
+}
+
+template <detail::NotBool Type, class Alloc, typename Result, typename ReduceOp, typename TransformOp>
+Result TransformReduce(const Vector<Type, Alloc>& vec, Result init, ReduceOp reduce, TransformOp transform) {
+    return TransformReduce(vec.Data(), vec.Data() + vec.Size(), init, reduce, transform);
+}
+
+template <detail::NotBool Type, class Alloc, typename Result, typename ReduceOp, typename TransformOp>
+Result TransformReduce(ParallelPolicy, const Vector<Type, Alloc>& vec, Result init, ReduceOp reduce,
+                       TransformOp transform) {
+    return TransformReduce(par, vec.Data(), vec.Data() + vec.Size(), init, reduce, transform);
+}
+
+template <detail::NotBool Type, class Alloc, typename Op = std::plus<>>
+void InclusiveScan(Vector<Type, Alloc>& vec, Op op = {}) {
+    InclusiveScan(vec.Data(), vec.Data() + vec.Size(), vec.Data(), op);
+}
+
+template <detail::NotBool Type, class Alloc, typename Op = std::plus<>>
+void InclusiveScan(ParallelPolicy, Vector<Type, Alloc>& vec, Op op = {}) {
+    InclusiveScan(par, vec.Data(), vec.Data() + vec.Size(), vec.Data(), op);
+}
+
+template <detail::NotBool Type, class Alloc, typename Func>
+void ForEach(Vector<Type, Alloc>& vec, Func func) {
+    ForEach(vec.Data(), vec.Data() + vec.Size(), func);
+}
+
+template <detail::NotBool Type, class Alloc, typename Func>
+void ForEach(ParallelPolicy, Vector<Type, Alloc>& vec, Func func) {
+    ForEach(par, vec.Data(), vec.Data() + vec.Size(), func);
+}
+
+/* Return the number of elements satisfying pred, they are moved to the front */
+
+template <detail::NotBool Type, class Alloc, typename Predicate>
+size_t Partition(Vector<Type, Alloc>& vec, Predicate pred) {
+    return static_cast<size_t>(Partition(vec.Data(), vec.Data() + vec.Size(), pred) - vec.Data());
+}
+
+template <detail::NotBool Type, class Alloc, typename Predicate>
+size_t Partition(ParallelPolicy, Vector<Type, Alloc>& vec, Predicate pred) {
+    return static_cast<size_t>(Partition(par, vec.Data(), vec.Data() + vec.Size(), pred) - vec.Data());
+}
+
+/* Vector<bool> overloads, work on whole words */
+
+template <class Alloc>
+    requires detail::BitVectorAllocator<Alloc>
+size_t Reduce(const Vector<bool, Alloc>& vec) {
+    return vec.Count();
+}
+
+template <class Alloc>
+    requires detail::BitVectorAllocator<Alloc>
+size_t Reduce(ParallelPolicy, const Vector<bool, Alloc>& vec) {
+    size_t words_n = (vec.Size() + 31) / 32;
+    size_t chunks_n = detail::ChunksCount(vec.Size());
+    std::vector<size_t> partials(chunks_n, 0);
+
+    detail::ForEachChunk(words_n, chunks_n, [&](size_t chunk, size_t begin, size_t end) {
+        partials[chunk] = vec.Count(begin * 32, std::min(vec.Size(), end * 32));
+    });
+
+    return std::accumulate(partials.begin(), partials.end(), size_t(0));
+}
+
+/* Sorted bit vector is a run of zeros followed by a run of ones */
+
+template <class Alloc>
+    requires detail::BitVectorAllocator<Alloc>
+void Sort(Vector<bool, Alloc>& vec) {
+    size_t zeros_n = vec.Size() - vec.Count();
+    vec.Fill(0, zeros_n, false);
+    vec.Fill(zeros_n, vec.Size(), true);
+}
+
+template <class Alloc>
+    requires detail::BitVectorAllocator<Alloc>
+void Sort(ParallelPolicy, Vector<bool, Alloc>& vec) {
+    size_t zeros_n = vec.Size() - Reduce(par, vec);
+    size_t words_n = (vec.Size() + 31) / 32;
+
+    /* Chunks own whole words, so no two threads write the same word */
+    detail::ForEachChunk(words_n, detail::ChunksCount(vec.Size()), [&](size_t, size_t begin, size_t end) {
+        size_t first = begin * 32;
+        size_t last = std::min(vec.Size(), end * 32);
+        size_t middle = std::clamp(zeros_n, first, last);
+        vec.Fill(first, middle, false);
+        vec.Fill(middle, last, true);
+    });
+}
+
+template <class Alloc>
+    requires detail::BitVectorAllocator<Alloc>
+void StableSort(Vector<bool, Alloc>& vec) {
+    Sort(vec);
+}
+
+template <class Alloc>
+    requires detail::BitVectorAllocator<Alloc>
+void StableSort(ParallelPolicy, Vector<bool, Alloc>& vec) {
+    Sort(par, vec);
+}
+
+}  // namespace stdlike
+
+#endif  // STDLIKE_ALGORITHM_HPP
@@ -1,10 +1,35 @@
+#ifndef STDLIKE_ALLOCATOR_HPP
+#define STDLIKE_ALLOCATOR_HPP
+
 #include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <concepts>
+#include <limits>
 #include <memory>
 #include <new>
 #include <numeric>
 
+#include <stdlike/instrument.hpp>
+
 namespace stdlike {
 
+namespace detail {
+
+/* Allocators that hand out zero-filled memory cheaper than it can be filled */
+template <class Alloc>
+concept ZeroAllocator = requires(Alloc& alloc, size_t elems_n) {
+    { alloc.AllocateZeroed(elems_n) } -> std::same_as<typename Alloc::pointer>;
+};
+
+}  // namespace detail
+
+/*
+ * malloc/calloc/aligned_alloc family, so that zeroed blocks can come from
+ * calloc: for large sizes it maps fresh pages and skips the memset, the
+ * kernel zeroes each page on first touch
+ */
+
 template <typename Type>
 class Allocator {
 public:
@@ -39,14 +64,18 @@ public:
         return const_cast<const_pointer>(addr);
     }
 
-    [[nodiscard]] constexpr pointer Allocate(size_type elems_n, [[maybe_unused]] const void* hint = nullptr) {
-	    std::align_val_t align = std::align_val_t(alignof(value_type));
-        return static_cast<pointer>(::operator new(elems_n * sizeof(value_type), align));
+    [[nodiscard]] pointer Allocate(size_type elems_n, [[maybe_unused]] const void* hint = nullptr STDLIKE_SITE_PARAM) {
+        STDLIKE_INSTRUMENT_HOOK(Allocation(site, elems_n * sizeof(value_type)));
+        return static_cast<pointer>(RawAllocate(elems_n, false));
+    }
+
+    [[nodiscard]] pointer AllocateZeroed(size_type elems_n STDLIKE_SITE_PARAM) {
+        STDLIKE_INSTRUMENT_HOOK(Allocation(site, elems_n * sizeof(value_type)));
+        return static_cast<pointer>(RawAllocate(elems_n, true));
     }
 
-    void Deallocate(pointer ptr, size_type elems_n) {
-	    std::align_val_t align = std::align_val_t(alignof(value_type));
-        ::operator delete(ptr, elems_n * sizeof(value_type), align);
+    void Deallocate(pointer ptr, [[maybe_unused]] size_type elems_n) {
+        std::free(ptr);
     }
 
     size_type MaxSize() const {
@@ -81,8 +110,8 @@ public:
         return address(value);
     }
 
-    [[nodiscard]] constexpr pointer allocate(size_type elems_n, [[maybe_unused]] const void* hint = nullptr) {
-        return Allocate(elems_n);
+    [[nodiscard]] pointer allocate(size_type elems_n, [[maybe_unused]] const void* hint = nullptr STDLIKE_SITE_PARAM) {
+        return Allocate(elems_n, hint STDLIKE_SITE_ARG);
     }
 
     void deallocate(pointer ptr, size_type elems_n) {
@@ -110,6 +139,34 @@ public:
 	void destroy(Other* ptr) {
 		Destroy(ptr);
 	}
+
+private:
+    static void* RawAllocate(size_type elems_n, bool zeroed) {
+        if (elems_n == 0) {
+            return nullptr;
+        }
+
+        if (elems_n > std::numeric_limits<size_type>::max() / sizeof(value_type)) {
+            throw std::bad_alloc();
+        }
+
+        size_t bytes = elems_n * sizeof(value_type);
+        void* ptr = nullptr;
+        if constexpr (alignof(value_type) <= alignof(std::max_align_t)) {
+            ptr = zeroed ? std::calloc(elems_n, sizeof(value_type)) : std::malloc(bytes);
+        } else {
+            /* There is no aligned calloc, sizeof is a multiple of alignof as aligned_alloc wants */
+            ptr = std::aligned_alloc(alignof(value_type), bytes);
+            if (ptr && zeroed) {
+                std::memset(ptr, 0, bytes);
+            }
+        }
+
+        if (!ptr) {
+            throw std::bad_alloc();
+        }
+        return ptr;
+    }
 };
 
 template <>
@@ -118,3 +175,5 @@ class Allocator<bool> {
 };
 
 }  // namespace stdlike
+
+#endif  // STDLIKE_ALLOCATOR_HPP
@@ -0,0 +1,230 @@
+#ifndef STDLIKE_BIT_SPAN_HPP
+#define STDLIKE_BIT_SPAN_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+#include <cstring>
+#include <bit>
+#include <compare>
+#include <iterator>
+#include <type_traits>
+
+namespace stdlike {
+
+/*
+ * Non-owning view of size bits of a byte buffer, starting offset bits into
+ * it. Bits are LSB-first within every byte, which is the layout of Arrow
+ * validity bitmaps and Parquet/roaring style bitmaps, so external buffers
+ * are wrapped as is. The span touches SizeInBytes() bytes from Data(),
+ * nothing is assumed about the alignment or padding of the buffer.
+ *
+ * BitSpan may write bits, ConstBitSpan only reads them. Like std::span it
+ * is a cheap value: copies refer to the same bits.
+ */
+template <typename Byte>
+class BasicBitSpan {
+    static_assert(std::is_same_v<std::remove_const_t<Byte>, uint8_t>, "BitSpan views uint8_t buffers");
+
+public:
+    static constexpr bool kConst = std::is_const_v<Byte>;
+
+    /* ConstIterator: the first byte of the span and a bit position from it */
+
+    class ConstIterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using difference_type = ptrdiff_t;
+        using value_type = bool;
+        using pointer = void;
+        using reference = bool;
+
+        ConstIterator() = default;
+
+        ConstIterator(const uint8_t* data, size_t bit) : data_(data), bit_(bit) {
+        }
+
+        bool operator*() const {
+            return ((data_[bit_ >> 3] >> (bit_ & 7)) & 1u) != 0;
+        }
+
+        bool operator[](difference_type diff) const {
+            return *(*this + diff);
+        }
+
+        ConstIterator& operator++() {
+            bit_++;
+            return *this;
+        }
+
+        ConstIterator operator++(int) {
+            ConstIterator old = *this;
+            bit_++;
+            return old;
+        }
+
+        ConstIterator& operator--() {
+            bit_--;
+            return *this;
+        }
+
+        ConstIterator operator--(int) {
+            ConstIterator old = *this;
+            bit_--;
+            return old;
+        }
+
+        ConstIterator& operator+=(difference_type diff) {
+            bit_ = static_cast<size_t>(static_cast<difference_type>(bit_) + diff);
+            return *this;
+        }
+
+        ConstIterator& operator-=(difference_type diff) {
+            return *this += -diff;
+        }
+
+        friend ConstIterator operator+(ConstIterator iter, difference_type diff) {
+            return iter += diff;
+        }
+
+        friend ConstIterator operator+(difference_type diff, ConstIterator iter) {
+            return iter += diff;
+        }
+
+        friend ConstIterator operator-(ConstIterator iter, difference_type diff) {
+            return iter -= diff;
+        }
+
+        friend difference_type operator-(const ConstIterator& lhs, const ConstIterator& rhs) {
+            return static_cast<difference_type>(lhs.bit_) - static_cast<difference_type>(rhs.bit_);
+        }
+
+        friend bool operator==(const ConstIterator& lhs, const ConstIterator& rhs) {
+            return lhs.bit_ == rhs.bit_;
+        }
+
+        friend std::strong_ordering operator<=>(const ConstIterator& lhs, const ConstIterator& rhs) {
+            return lhs.bit_ <=> rhs.bit_;
+        }
+
+    private:
+        const uint8_t* data_ = nullptr;
+        size_t bit_ = 0;
+    };
+
+    /* BasicBitSpan */
+
+    BasicBitSpan() = default;
+
+    BasicBitSpan(Byte* data, size_t size, size_t offset = 0)
+        : data_(data + offset / 8), offset_(offset % 8), size_(size) {
+    }
+
+    /* BitSpan -> ConstBitSpan */
+    template <typename Other>
+        requires(kConst && !std::is_const_v<Other>)
+    BasicBitSpan(const BasicBitSpan<Other>& other) : data_(other.Data()), offset_(other.Offset()), size_(other.Size()) {
+    }
+
+    /* Observers */
+
+    Byte* Data() const {
+        return data_;
+    }
+
+    /* Bit offset into Data(), always < 8 */
+    size_t Offset() const {
+        return offset_;
+    }
+
+    size_t Size() const {
+        return size_;
+    }
+
+    bool Empty() const {
+        return size_ == 0;
+    }
+
+    size_t SizeInBytes() const {
+        return (offset_ + size_ + 7) / 8;
+    }
+
+    BasicBitSpan Subspan(size_t start, size_t count) const {
+        assert(start + count <= size_);
+        return BasicBitSpan(data_, count, offset_ + start);
+    }
+
+    /* Element access */
+
+    bool Test(size_t pos) const {
+        assert(pos < size_);
+        size_t bit = offset_ + pos;
+        return ((data_[bit / 8] >> (bit % 8)) & 1u) != 0;
+    }
+
+    bool operator[](size_t pos) const {
+        return this->Test(pos);
+    }
+
+    void Set(size_t pos, bool value) const
+        requires(!kConst)
+    {
+        assert(pos < size_);
+        size_t bit = offset_ + pos;
+        uint8_t mask = static_cast<uint8_t>(1u << (bit % 8));
+        uint8_t byte = data_[bit / 8];
+        data_[bit / 8] = value ? static_cast<uint8_t>(byte | mask) : static_cast<uint8_t>(byte & ~mask);
+    }
+
+    ConstIterator Begin() const {
+        return ConstIterator(data_, offset_);
+    }
+
+    ConstIterator End() const {
+        return ConstIterator(data_, offset_ + size_);
+    }
+
+    ConstIterator begin() const {
+        return Begin();
+    }
+
+    ConstIterator end() const {
+        return End();
+    }
+
+    /* Number of set bits, eight bytes at a time */
+    size_t Count() const {
+        size_t first = offset_;
+        size_t last = offset_ + size_;
+        size_t count = 0;
+
+        for (; first < last && first % 8 != 0; first++) {
+            count += (data_[first / 8] >> (first % 8)) & 1u;
+        }
+        for (; first + 64 <= last; first += 64) {
+            uint64_t word = 0;
+            std::memcpy(&word, data_ + first / 8, sizeof(word));
+            count += static_cast<size_t>(std::popcount(word));
+        }
+        for (; first + 8 <= last; first += 8) {
+            count += static_cast<size_t>(std::popcount(data_[first / 8]));
+        }
+        for (; first < last; first++) {
+            count += (data_[first / 8] >> (first % 8)) & 1u;
+        }
+
+        return count;
+    }
+
+private:
+    Byte* data_ = nullptr;
+    size_t offset_ = 0;
+    size_t size_ = 0;
+};
+
+using BitSpan = BasicBitSpan<uint8_t>;
+using ConstBitSpan = BasicBitSpan<const uint8_t>;
+
+}  // namespace stdlike
+
+#endif  // STDLIKE_BIT_SPAN_HPP
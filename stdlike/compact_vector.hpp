@@ -0,0 +1,443 @@
+#ifndef STDLIKE_COMPACT_VECTOR_HPP
+#define STDLIKE_COMPACT_VECTOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+#include <cstring>
+#include <algorithm>
+#include <compare>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include <stdlike/allocator.hpp>
+#include <stdlike/hash.hpp>
+#include <stdlike/trace.hpp>
+#include <stdlike/vector.hpp>
+
+namespace stdlike {
+
+/*
+ * Vector with a one-pointer handle, for structures that hold millions of
+ * small vectors. Size and capacity are 32-bit and live in a header in
+ * front of the elements on the heap, an empty vector owns no block at all.
+ * With an empty allocator sizeof(CompactVector) == sizeof(void*), against
+ * 24 bytes for Vector. More than 2^32 - 1 elements throw std::length_error.
+ *
+ * Iterators are plain pointers, any growth invalidates them.
+ */
+template <typename Type, class Alloc = Allocator<Type>>
+class CompactVector {
+    struct Header {
+        uint32_t size = 0;
+        uint32_t capacity = 0;
+    };
+
+    /* The block is allocated in units aligned for both the header and the elements */
+    static constexpr size_t kAlignment = std::max(alignof(Header), alignof(Type));
+    static constexpr size_t kDataOffset = (sizeof(Header) + alignof(Type) - 1) / alignof(Type) * alignof(Type);
+
+    struct alignas(kAlignment) Unit {
+        unsigned char bytes[kAlignment];
+    };
+
+    using UnitAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<Unit>;
+
+public:
+    using Iterator = Type*;
+    using ConstIterator = const Type*;
+
+    static constexpr size_t kMaxSize = std::numeric_limits<uint32_t>::max();
+
+    /* CompactVector<Type> */
+
+    CompactVector() = default;
+
+    explicit CompactVector(size_t init_size, const Type& value = Type()) {
+        if (init_size > 0) {
+            this->ChangeCapacity(init_size);
+            try {
+                std::uninitialized_fill_n(this->Data(), init_size, value);
+            } catch (...) {
+                this->FreeBlock(std::exchange(header_, nullptr));
+                throw;
+            }
+            header_->size = static_cast<uint32_t>(init_size);
+        }
+    }
+
+    CompactVector(const CompactVector& other) : allocator_(other.allocator_) {
+        if (!other.Empty()) {
+            this->ChangeCapacity(other.Size());
+            try {
+                std::uninitialized_copy(other.Begin(), other.End(), this->Data());
+            } catch (...) {
+                this->FreeBlock(std::exchange(header_, nullptr));
+                throw;
+            }
+            header_->size = other.header_->size;
+        }
+    }
+
+    CompactVector(CompactVector&& temp) noexcept
+        : header_(std::exchange(temp.header_, nullptr)), allocator_(temp.allocator_) {
+    }
+
+    ~CompactVector() {
+        if (header_) {
+            std::destroy(Begin(), End());
+            this->FreeBlock(header_);
+            header_ = nullptr;
+        }
+    }
+
+    CompactVector& operator=(const CompactVector& other) {
+        if (this != &other) {
+            CompactVector copy(other);
+            this->Swap(copy);
+        }
+        return *this;
+    }
+
+    CompactVector& operator=(CompactVector&& temp) noexcept {
+        this->Swap(temp);
+        return *this;
+    }
+
+    /* Comparison, same rules as Vector */
+
+    friend bool operator==(const CompactVector& lhs, const CompactVector& rhs)
+        requires std::equality_comparable<Type>
+    {
+        if (lhs.Size() != rhs.Size()) {
+            return false;
+        }
+        if constexpr (detail::BytewiseComparable<Type>) {
+            return lhs.Empty() || std::memcmp(lhs.Data(), rhs.Data(), lhs.Size() * sizeof(Type)) == 0;
+        } else {
+            return std::equal(lhs.Begin(), lhs.End(), rhs.Begin());
+        }
+    }
+
+    friend auto operator<=>(const CompactVector& lhs, const CompactVector& rhs)
+        requires std::three_way_comparable<Type>
+    {
+        return std::lexicographical_compare_three_way(lhs.Begin(), lhs.End(), rhs.Begin(), rhs.End());
+    }
+
+    /* Iterators */
+
+    Iterator Begin() {
+        return this->Data();
+    }
+
+    Iterator End() {
+        return this->Data() + this->Size();
+    }
+
+    ConstIterator Begin() const {
+        return this->Data();
+    }
+
+    ConstIterator End() const {
+        return this->Data() + this->Size();
+    }
+
+    Iterator begin() {
+        return Begin();
+    }
+
+    Iterator end() {
+        return End();
+    }
+
+    ConstIterator begin() const {
+        return Begin();
+    }
+
+    ConstIterator end() const {
+        return End();
+    }
+
+    /* Capacity */
+
+    bool Empty() const {
+        return this->Size() == 0;
+    }
+
+    size_t Size() const {
+        return header_ ? header_->size : 0;
+    }
+
+    size_t Capacity() const {
+        return header_ ? header_->capacity : 0;
+    }
+
+    void Reserve(size_t new_capacity) {
+        if (new_capacity > this->Capacity()) {
+            this->ChangeCapacity(new_capacity);
+        }
+    }
+
+    /* An empty vector gives its block back */
+    void ShrinkToFit() {
+        if (this->Capacity() > this->Size()) {
+            this->ChangeCapacity(this->Size());
+        }
+    }
+
+    /* Element access */
+
+    const Type& At(size_t pos) const {
+        assert(pos < this->Size());
+        return this->Data()[pos];
+    }
+
+    Type& At(size_t pos) {
+        assert(pos < this->Size());
+        return this->Data()[pos];
+    }
+
+    const Type& operator[](size_t pos) const {
+        return this->Data()[pos];
+    }
+
+    Type& operator[](size_t pos) {
+        return this->Data()[pos];
+    }
+
+    const Type& Front() const {
+        return this->Data()[0];
+    }
+
+    Type& Front() {
+        return this->Data()[0];
+    }
+
+    const Type& Back() const {
+        return this->Data()[this->Size() - 1];
+    }
+
+    Type& Back() {
+        return this->Data()[this->Size() - 1];
+    }
+
+    const Type* Data() const {
+        return header_ ? DataOf(header_) : nullptr;
+    }
+
+    Type* Data() {
+        return header_ ? DataOf(header_) : nullptr;
+    }
+
+    Alloc GetAllocator() const {
+        return allocator_;
+    }
+
+    /* Modifiers */
+
+    void Clear() {
+        if (header_) {
+            std::destroy(Begin(), End());
+            header_->size = 0;
+        }
+    }
+
+    Iterator Insert(ConstIterator pos, const Type& value) {
+        size_t offset = static_cast<size_t>(pos - this->Begin());
+        assert(offset <= this->Size());
+        Type copy(value); /* value may live in this vector */
+        this->Grow(1);
+
+        Type* data = this->Data();
+        size_t size = this->Size();
+        if (offset == size) {
+            ::new (static_cast<void*>(data + size)) Type(std::move(copy));
+        } else {
+            STDLIKE_TRACE_SCOPE(kShift, (size - offset) * sizeof(Type));
+            ::new (static_cast<void*>(data + size)) Type(std::move(data[size - 1]));
+            std::move_backward(data + offset, data + size - 1, data + size);
+            data[offset] = std::move(copy);
+        }
+
+        header_->size++;
+        return data + offset;
+    }
+
+    Iterator Erase(ConstIterator pos) {
+        size_t offset = static_cast<size_t>(pos - this->Begin());
+        assert(offset < this->Size());
+
+        Type* data = this->Data();
+        STDLIKE_TRACE_SCOPE(kShift, (this->Size() - offset) * sizeof(Type));
+        std::move(data + offset + 1, data + this->Size(), data + offset);
+        std::destroy_at(data + --header_->size);
+        return data + offset;
+    }
+
+    void PushBack(const Type& value) {
+        if (this->Size() == this->Capacity()) {
+            Type copy(value); /* value may live in this vector */
+            this->Grow(1);
+            ::new (static_cast<void*>(this->End())) Type(std::move(copy));
+        } else {
+            ::new (static_cast<void*>(this->End())) Type(value);
+        }
+        header_->size++;
+    }
+
+    void PushBack(Type&& value) {
+        if (this->Size() == this->Capacity()) {
+            Type temp(std::move(value));
+            this->Grow(1);
+            ::new (static_cast<void*>(this->End())) Type(std::move(temp));
+        } else {
+            ::new (static_cast<void*>(this->End())) Type(std::move(value));
+        }
+        header_->size++;
+    }
+
+    void PopBack() {
+        if (!this->Empty()) {
+            std::destroy_at(this->Data() + --header_->size);
+        }
+    }
+
+    void Resize(size_t new_size, const Type& value = Type()) {
+        size_t size = this->Size();
+        if (new_size <= size) {
+            if (header_) {
+                std::destroy(this->Data() + new_size, this->End());
+                header_->size = static_cast<uint32_t>(new_size);
+            }
+            return;
+        }
+
+        Type copy(value); /* value may live in this vector */
+        this->Grow(new_size - size);
+        std::uninitialized_fill(this->Data() + size, this->Data() + new_size, copy);
+        header_->size = static_cast<uint32_t>(new_size);
+    }
+
+    void Swap(CompactVector& other) noexcept {
+        std::swap(header_, other.header_);
+        std::swap(allocator_, other.allocator_);
+    }
+
+private:
+    /* Helper functions */
+
+    /* Room for elems_n more elements, capacity at least doubles up to kMaxSize */
+    void Grow(size_t elems_n) {
+        if (elems_n > kMaxSize - this->Size()) {
+            throw std::length_error("stdlike::CompactVector: more than 2^32 - 1 elements");
+        }
+
+        size_t needed = this->Size() + elems_n;
+        if (needed > this->Capacity()) {
+            this->ChangeCapacity(std::min(kMaxSize, std::max(needed, this->Capacity() * 2)));
+        }
+    }
+
+    /* Strong guarantee: elements that may throw on move are copied, a failed copy frees the new block */
+    void ChangeCapacity(size_t new_capacity) {
+        if (new_capacity > kMaxSize) {
+            throw std::length_error("stdlike::CompactVector: more than 2^32 - 1 elements");
+        }
+
+        size_t size = this->Size();
+        assert(new_capacity >= size);
+        if (new_capacity == 0) {
+            this->FreeBlock(std::exchange(header_, nullptr));
+            return;
+        }
+
+        STDLIKE_TRACE_SCOPE(kReallocation, new_capacity * sizeof(Type));
+        Header* new_header = this->AllocateBlock(new_capacity);
+        new_header->size = static_cast<uint32_t>(size);
+        if (header_) {
+            Type* new_data = DataOf(new_header);
+            if constexpr (std::is_trivially_copyable_v<Type>) {
+                std::memcpy(static_cast<void*>(new_data), this->Data(), size * sizeof(Type));
+            } else {
+                try {
+                    if constexpr (std::is_nothrow_move_constructible_v<Type> || !std::is_copy_constructible_v<Type>) {
+                        std::uninitialized_move(this->Begin(), this->End(), new_data);
+                    } else {
+                        std::uninitialized_copy(this->Begin(), this->End(), new_data);
+                    }
+                } catch (...) {
+                    this->FreeBlock(new_header);
+                    throw;
+                }
+                std::destroy(this->Begin(), this->End());
+            }
+            this->FreeBlock(header_);
+        }
+        header_ = new_header;
+    }
+
+    /* Elements start kDataOffset bytes into the block */
+    static Type* DataOf(Header* header) {
+        return std::launder(reinterpret_cast<Type*>(reinterpret_cast<unsigned char*>(header) + kDataOffset));
+    }
+
+    static size_t UnitsFor(size_t capacity) {
+        return (kDataOffset + capacity * sizeof(Type) + sizeof(Unit) - 1) / sizeof(Unit);
+    }
+
+    Header* AllocateBlock(size_t capacity) {
+        UnitAlloc units(allocator_);
+        Unit* block = std::allocator_traits<UnitAlloc>::allocate(units, UnitsFor(capacity));
+        Header* header = ::new (static_cast<void*>(block)) Header();
+        header->capacity = static_cast<uint32_t>(capacity);
+        return header;
+    }
+
+    void FreeBlock(Header* header) {
+        if (header) {
+            UnitAlloc units(allocator_);
+            size_t units_n = UnitsFor(header->capacity);
+            std::allocator_traits<UnitAlloc>::deallocate(units, reinterpret_cast<Unit*>(header), units_n);
+        }
+    }
+
+private:
+    Header* header_ = nullptr;
+    [[no_unique_address]] Alloc allocator_ = {};
+};
+
+/* Hash, consistent with operator== */
+
+template <typename Type, class Alloc>
+    requires(detail::BytewiseComparable<Type> || requires(const Type& value) { std::hash<Type>()(value); })
+struct Hash<CompactVector<Type, Alloc>> {
+    uint64_t operator()(const CompactVector<Type, Alloc>& vec) const {
+        if constexpr (detail::BytewiseComparable<Type>) {
+            return Hash64(vec.Data(), vec.Size() * sizeof(Type));
+        } else {
+            uint64_t hash = Hash64(nullptr, 0, vec.Size());
+            for (const Type& value : vec) {
+                hash = detail::HashMergeRound(hash, std::hash<Type>()(value));
+            }
+            return hash;
+        }
+    }
+};
+
+}  // namespace stdlike
+
+template <typename Type, class Alloc>
+    requires requires(const stdlike::CompactVector<Type, Alloc>& vec) {
+        stdlike::Hash<stdlike::CompactVector<Type, Alloc>>()(vec);
+    }
+struct std::hash<stdlike::CompactVector<Type, Alloc>> {
+    size_t operator()(const stdlike::CompactVector<Type, Alloc>& vec) const {
+        return static_cast<size_t>(stdlike::Hash<stdlike::CompactVector<Type, Alloc>>()(vec));
+    }
+};
+
+#endif  // STDLIKE_COMPACT_VECTOR_HPP
@@ -0,0 +1,47 @@
+#ifndef STDLIKE_EXECUTION_HPP
+#define STDLIKE_EXECUTION_HPP
+
+#include <cstddef>
+
+#include <stdlike/thread_pool.hpp>
+
+namespace stdlike {
+
+/* Execution policies */
+
+struct SequencedPolicy {};
+struct ParallelPolicy {};
+
+inline constexpr SequencedPolicy seq{};
+inline constexpr ParallelPolicy par{};
+
+/*
+ * Ranges shorter than this are processed by the calling thread only,
+ * spawning workers for them costs more than it saves
+ */
+inline constexpr size_t kParallelThreshold = 1 << 16;
+
+/* Threads working on a parallel operation: the workers of the default pool and the caller */
+inline size_t ConcurrencyLevel() {
+    return ThreadPool::Default().ThreadsCount() + 1;
+}
+
+/*
+ * Calls func(chunk_begin, chunk_end) for disjoint chunks covering [begin, end)
+ * of at most grain elements each on the default pool. The calling thread
+ * takes part in the work, the first exception thrown by any chunk is
+ * rethrown after all of them finish.
+ */
+template <typename Func>
+void ParallelFor(size_t begin, size_t end, size_t grain, Func func) {
+    ThreadPool::Default().ParallelFor(begin, end, grain, func);
+}
+
+template <typename Func>
+void ParallelFor(size_t begin, size_t end, Func func) {
+    ParallelFor(begin, end, kParallelThreshold / 4, func);
+}
+
+}  // namespace stdlike
+
+#endif  // STDLIKE_EXECUTION_HPP
@@ -0,0 +1,437 @@
+#ifndef STDLIKE_FLAT_MAP_HPP
+#define STDLIKE_FLAT_MAP_HPP
+
+#include <cstddef>
+#include <cassert>
+#include <algorithm>
+#include <compare>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+#include <stdlike/allocator.hpp>
+#include <stdlike/flat_set.hpp>
+#include <stdlike/vector.hpp>
+
+namespace stdlike {
+
+/*
+ * Map with unique keys kept sorted, keys and values in two parallel
+ * Vectors: a lookup is a branchless binary search that touches keys only,
+ * and memory per entry is sizeof(Key) + sizeof(Value). Same costs as
+ * FlatSet: Insert and Erase shift both tails, InsertRange sorts the new
+ * entries and merges them in one pass.
+ *
+ * Dereferencing an iterator gives std::pair<const Key&, Value&>, so
+ * `for (auto [key, value] : map)` works. Any insertion or erasure
+ * invalidates iterators.
+ */
+template <typename Key, typename Value, typename Compare = std::less<Key>, class KeyAlloc = Allocator<Key>,
+          class ValueAlloc = Allocator<Value>>
+class FlatMap {
+    static_assert(!std::is_same_v<Key, bool>, "Vector<bool> packs bits, use uint8_t keys");
+    static_assert(!std::is_same_v<Value, bool>, "Vector<bool> packs bits, use uint8_t values");
+
+public:
+    /* MapIterator: the container and an entry index */
+
+    template <bool kConst>
+    class MapIterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using difference_type = ptrdiff_t;
+        using value_type = std::pair<Key, Value>;
+        using pointer = void;
+        using reference = std::pair<const Key&, std::conditional_t<kConst, const Value&, Value&>>;
+
+        using Owner = std::conditional_t<kConst, const FlatMap, FlatMap>;
+
+        MapIterator() = default;
+
+        MapIterator(Owner* container, size_t pos) : container_(container), pos_(pos) {
+        }
+
+        /* Iterator -> ConstIterator */
+        template <bool kOtherConst>
+            requires(kConst && !kOtherConst)
+        MapIterator(const MapIterator<kOtherConst>& other) : container_(other.container_), pos_(other.pos_) {
+        }
+
+        reference operator*() const {
+            return reference(container_->keys_[pos_], container_->values_[pos_]);
+        }
+
+        reference operator[](difference_type diff) const {
+            return *(*this + diff);
+        }
+
+        const Key& GetKey() const {
+            return container_->keys_[pos_];
+        }
+
+        auto& GetValue() const {
+            return container_->values_[pos_];
+        }
+
+        /* Entry index, the same in Keys() and Values() */
+        size_t Index() const {
+            return pos_;
+        }
+
+        MapIterator& operator++() {
+            pos_++;
+            return *this;
+        }
+
+        MapIterator operator++(int) {
+            MapIterator old = *this;
+            pos_++;
+            return old;
+        }
+
+        MapIterator& operator--() {
+            pos_--;
+            return *this;
+        }
+
+        MapIterator operator--(int) {
+            MapIterator old = *this;
+            pos_--;
+            return old;
+        }
+
+        MapIterator& operator+=(difference_type diff) {
+            pos_ = static_cast<size_t>(static_cast<difference_type>(pos_) + diff);
+            return *this;
+        }
+
+        MapIterator& operator-=(difference_type diff) {
+            return *this += -diff;
+        }
+
+        friend MapIterator operator+(MapIterator iter, difference_type diff) {
+            return iter += diff;
+        }
+
+        friend MapIterator operator+(difference_type diff, MapIterator iter) {
+            return iter += diff;
+        }
+
+        friend MapIterator operator-(MapIterator iter, difference_type diff) {
+            return iter -= diff;
+        }
+
+        friend difference_type operator-(const MapIterator& lhs, const MapIterator& rhs) {
+            return static_cast<difference_type>(lhs.pos_) - static_cast<difference_type>(rhs.pos_);
+        }
+
+        friend bool operator==(const MapIterator& lhs, const MapIterator& rhs) {
+            return lhs.pos_ == rhs.pos_;
+        }
+
+        friend std::strong_ordering operator<=>(const MapIterator& lhs, const MapIterator& rhs) {
+            return lhs.pos_ <=> rhs.pos_;
+        }
+
+    private:
+        template <bool>
+        friend class MapIterator;
+
+        Owner* container_ = nullptr;
+        size_t pos_ = 0;
+    };
+
+    using Iterator = MapIterator<false>;
+    using ConstIterator = MapIterator<true>;
+
+    /* FlatMap<Key, Value> */
+
+    FlatMap() = default;
+
+    explicit FlatMap(const Compare& comp) : comp_(comp) {
+    }
+
+    FlatMap(std::initializer_list<std::pair<Key, Value>> entries, const Compare& comp = Compare()) : comp_(comp) {
+        this->InsertRange(entries);
+    }
+
+    /* Takes over keys that are already sorted and unique and their values, no sorting done */
+    FlatMap(SortedUnique, Vector<Key, KeyAlloc> keys, Vector<Value, ValueAlloc> values, const Compare& comp = Compare())
+        : keys_(std::move(keys)), values_(std::move(values)), comp_(comp) {
+        assert(keys_.Size() == values_.Size());
+        assert(this->IsSortedUnique());
+    }
+
+    /* Comparison: the same keys with the same values */
+
+    friend bool operator==(const FlatMap& lhs, const FlatMap& rhs)
+        requires(std::equality_comparable<Key> && std::equality_comparable<Value>)
+    {
+        return lhs.keys_ == rhs.keys_ && lhs.values_ == rhs.values_;
+    }
+
+    /* Iterators */
+
+    Iterator Begin() {
+        return Iterator(this, 0);
+    }
+
+    Iterator End() {
+        return Iterator(this, this->Size());
+    }
+
+    ConstIterator Begin() const {
+        return ConstIterator(this, 0);
+    }
+
+    ConstIterator End() const {
+        return ConstIterator(this, this->Size());
+    }
+
+    Iterator begin() {
+        return Begin();
+    }
+
+    Iterator end() {
+        return End();
+    }
+
+    ConstIterator begin() const {
+        return Begin();
+    }
+
+    ConstIterator end() const {
+        return End();
+    }
+
+    /* Capacity */
+
+    bool Empty() const {
+        return keys_.Empty();
+    }
+
+    size_t Size() const {
+        return keys_.Size();
+    }
+
+    void Reserve(size_t new_capacity) {
+        keys_.Reserve(new_capacity);
+        values_.Reserve(new_capacity);
+    }
+
+    void ShrinkToFit() {
+        keys_.ShrinkToFit();
+        values_.ShrinkToFit();
+    }
+
+    /* Lookup */
+
+    ConstIterator LowerBound(const Key& key) const {
+        return ConstIterator(this, detail::BranchlessLowerBound(keys_.Data(), keys_.Size(), key, comp_));
+    }
+
+    Iterator LowerBound(const Key& key) {
+        return Iterator(this, detail::BranchlessLowerBound(keys_.Data(), keys_.Size(), key, comp_));
+    }
+
+    ConstIterator UpperBound(const Key& key) const {
+        return ConstIterator(this, detail::BranchlessUpperBound(keys_.Data(), keys_.Size(), key, comp_));
+    }
+
+    Iterator UpperBound(const Key& key) {
+        return Iterator(this, detail::BranchlessUpperBound(keys_.Data(), keys_.Size(), key, comp_));
+    }
+
+    /* End() if there is no such key */
+    ConstIterator Find(const Key& key) const {
+        return ConstIterator(this, this->FindIndex(key));
+    }
+
+    Iterator Find(const Key& key) {
+        return Iterator(this, this->FindIndex(key));
+    }
+
+    bool Contains(const Key& key) const {
+        return this->FindIndex(key) != this->Size();
+    }
+
+    size_t Count(const Key& key) const {
+        return this->Contains(key) ? 1 : 0;
+    }
+
+    /* The key must be present */
+    const Value& At(const Key& key) const {
+        size_t pos = this->FindIndex(key);
+        assert(pos < this->Size());
+        return values_[pos];
+    }
+
+    Value& At(const Key& key) {
+        size_t pos = this->FindIndex(key);
+        assert(pos < this->Size());
+        return values_[pos];
+    }
+
+    /* Inserts a value-initialized Value for a missing key */
+    Value& operator[](const Key& key) {
+        return this->Insert(key, Value()).first.GetValue();
+    }
+
+    /* The sorted keys and their values, entry i is (Keys()[i], Values()[i]) */
+
+    const Vector<Key, KeyAlloc>& Keys() const {
+        return keys_;
+    }
+
+    const Vector<Value, ValueAlloc>& Values() const {
+        return values_;
+    }
+
+    /* Modifiers */
+
+    void Clear() {
+        keys_.Clear();
+        values_.Clear();
+    }
+
+    /* The entry of key and whether it was inserted, a present value is left as is */
+    std::pair<Iterator, bool> Insert(const Key& key, const Value& value) {
+        size_t pos = detail::BranchlessLowerBound(keys_.Data(), keys_.Size(), key, comp_);
+        if (pos < keys_.Size() && !comp_(key, keys_[pos])) {
+            return {Iterator(this, pos), false};
+        }
+
+        values_.Insert(values_.Begin() + static_cast<ptrdiff_t>(pos), value);
+        try {
+            keys_.Insert(keys_.Begin() + static_cast<ptrdiff_t>(pos), key);
+        } catch (...) {
+            values_.Erase(values_.Begin() + static_cast<ptrdiff_t>(pos));
+            throw;
+        }
+        return {Iterator(this, pos), true};
+    }
+
+    /* Like Insert, but a present value is overwritten */
+    std::pair<Iterator, bool> InsertOrAssign(const Key& key, const Value& value) {
+        auto [pos, inserted] = this->Insert(key, value);
+        if (!inserted) {
+            pos.GetValue() = value;
+        }
+        return {pos, inserted};
+    }
+
+    /*
+     * Adds all (key, value) pairs of range with one sort of the new entries
+     * and one merge with the present ones, O(Size() + n log n) for n new
+     * entries. Present keys keep their values, among equal new keys the
+     * first one in range wins.
+     */
+    template <std::ranges::input_range Range>
+        requires std::convertible_to<std::ranges::range_reference_t<Range>, std::pair<Key, Value>>
+    void InsertRange(Range&& range) {
+        Vector<std::pair<Key, Value>> added;
+        if constexpr (std::ranges::sized_range<Range>) {
+            added.Reserve(static_cast<size_t>(std::ranges::size(range)));
+        }
+        for (auto&& entry : range) {
+            added.PushBack(entry);
+        }
+        if (added.Empty()) {
+            return;
+        }
+
+        std::stable_sort(added.Data(), added.Data() + added.Size(), [this](const auto& lhs, const auto& rhs) {
+            return comp_(lhs.first, rhs.first);
+        });
+
+        Vector<Key, KeyAlloc> keys;
+        Vector<Value, ValueAlloc> values;
+        keys.Reserve(keys_.Size() + added.Size());
+        values.Reserve(keys_.Size() + added.Size());
+        size_t old_pos = 0;
+        const std::pair<Key, Value>* new_first = added.Data();
+        const std::pair<Key, Value>* new_last = new_first + added.Size();
+        auto push_present = [&] {
+            keys.PushBack(keys_[old_pos]);
+            values.PushBack(values_[old_pos]);
+            old_pos++;
+        };
+        auto push_added = [&] {
+            if (keys.Empty() || comp_(keys.Back(), new_first->first)) {
+                keys.PushBack(new_first->first);
+                values.PushBack(new_first->second);
+            }
+            ++new_first;
+        };
+
+        while (old_pos < keys_.Size() && new_first != new_last) {
+            if (comp_(keys_[old_pos], new_first->first)) {
+                push_present();
+            } else if (comp_(new_first->first, keys_[old_pos])) {
+                push_added();
+            } else {
+                ++new_first; /* The present entry wins */
+            }
+        }
+        while (old_pos < keys_.Size()) {
+            push_present();
+        }
+        while (new_first != new_last) {
+            push_added();
+        }
+        keys_.Swap(keys);
+        values_.Swap(values);
+    }
+
+    void InsertRange(std::initializer_list<std::pair<Key, Value>> entries) {
+        this->InsertRange(std::ranges::subrange(entries.begin(), entries.end()));
+    }
+
+    /* Number of entries erased, 0 or 1 */
+    size_t Erase(const Key& key) {
+        size_t pos = this->FindIndex(key);
+        if (pos == this->Size()) {
+            return 0;
+        }
+        this->Erase(ConstIterator(this, pos));
+        return 1;
+    }
+
+    Iterator Erase(ConstIterator pos) {
+        size_t index = pos.Index();
+        assert(index < this->Size());
+        keys_.Erase(keys_.Begin() + static_cast<ptrdiff_t>(index));
+        values_.Erase(values_.Begin() + static_cast<ptrdiff_t>(index));
+        return Iterator(this, index);
+    }
+
+    void Swap(FlatMap& other) {
+        keys_.Swap(other.keys_);
+        values_.Swap(other.values_);
+        std::swap(comp_, other.comp_);
+    }
+
+private:
+    size_t FindIndex(const Key& key) const {
+        size_t pos = detail::BranchlessLowerBound(keys_.Data(), keys_.Size(), key, comp_);
+        return pos < keys_.Size() && !comp_(key, keys_[pos]) ? pos : keys_.Size();
+    }
+
+    bool IsSortedUnique() const {
+        return std::adjacent_find(keys_.Data(), keys_.Data() + keys_.Size(), [this](const Key& lhs, const Key& rhs) {
+                   return !comp_(lhs, rhs);
+               }) == keys_.Data() + keys_.Size();
+    }
+
+private:
+    Vector<Key, KeyAlloc> keys_ = {};
+    Vector<Value, ValueAlloc> values_ = {};
+    [[no_unique_address]] Compare comp_ = {};
+};
+
+}  // namespace stdlike
+
+#endif  // STDLIKE_FLAT_MAP_HPP
@@ -0,0 +1,281 @@
+#ifndef STDLIKE_FLAT_SET_HPP
+#define STDLIKE_FLAT_SET_HPP
+
+#include <cstddef>
+#include <cassert>
+#include <algorithm>
+#include <compare>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+#include <stdlike/allocator.hpp>
+#include <stdlike/vector.hpp>
+
+namespace stdlike {
+
+/* Tag for constructors taking input that is already sorted and free of duplicates */
+struct SortedUnique {};
+
+inline constexpr SortedUnique sorted_unique{};
+
+namespace detail {
+
+/*
+ * First position in [first, first + size) where pred turns false, pred
+ * must be true on a prefix. The loop runs exactly log2(size) times and the
+ * step is a conditional move, so there is no mispredicted branch per level.
+ */
+template <typename Type, typename Pred>
+size_t BranchlessPartitionPoint(const Type* first, size_t size, Pred pred) {
+    if (size == 0) {
+        return 0;
+    }
+
+    const Type* base = first;
+    while (size > 1) {
+        size_t half = size / 2;
+        /* Both candidates for the next probe, so large arrays miss the cache in parallel */
+        __builtin_prefetch(base + half / 2);
+        __builtin_prefetch(base + half + half / 2);
+        base = pred(base[half]) ? base + half : base;
+        size -= half;
+    }
+    return static_cast<size_t>(base - first) + (pred(*base) ? 1 : 0);
+}
+
+template <typename Key, typename Compare>
+size_t BranchlessLowerBound(const Key* first, size_t size, const Key& key, const Compare& comp) {
+    return BranchlessPartitionPoint(first, size, [&](const Key& elem) {
+        return comp(elem, key);
+    });
+}
+
+template <typename Key, typename Compare>
+size_t BranchlessUpperBound(const Key* first, size_t size, const Key& key, const Compare& comp) {
+    return BranchlessPartitionPoint(first, size, [&](const Key& elem) {
+        return !comp(key, elem);
+    });
+}
+
+}  // namespace detail
+
+/*
+ * Set of unique keys kept sorted in one Vector, for lookup tables that are
+ * read far more often than they change. Memory per key is sizeof(Key), a
+ * lookup is a branchless binary search over contiguous keys.
+ *
+ * Insert and Erase shift the tail, O(Size()) each; add many keys with one
+ * InsertRange, which sorts the new keys and merges them in one pass.
+ * Iterators are pointers to the keys, any insertion or erasure
+ * invalidates them.
+ */
+template <typename Key, typename Compare = std::less<Key>, class Alloc = Allocator<Key>>
+class FlatSet {
+    static_assert(!std::is_same_v<Key, bool>, "Vector<bool> packs bits, use uint8_t keys");
+
+public:
+    using Iterator = const Key*;
+    using ConstIterator = const Key*;
+
+    /* FlatSet<Key> */
+
+    FlatSet() = default;
+
+    explicit FlatSet(const Compare& comp) : comp_(comp) {
+    }
+
+    FlatSet(std::initializer_list<Key> keys, const Compare& comp = Compare()) : comp_(comp) {
+        this->InsertRange(keys);
+    }
+
+    /* Takes over keys that are already sorted and unique, no sorting done */
+    FlatSet(SortedUnique, Vector<Key, Alloc> keys, const Compare& comp = Compare())
+        : keys_(std::move(keys)), comp_(comp) {
+        assert(this->IsSortedUnique());
+    }
+
+    /* Comparison: the same keys */
+
+    friend bool operator==(const FlatSet& lhs, const FlatSet& rhs)
+        requires std::equality_comparable<Key>
+    {
+        return lhs.keys_ == rhs.keys_;
+    }
+
+    /* Iterators */
+
+    ConstIterator Begin() const {
+        return keys_.Data();
+    }
+
+    ConstIterator End() const {
+        return keys_.Data() + keys_.Size();
+    }
+
+    ConstIterator begin() const {
+        return Begin();
+    }
+
+    ConstIterator end() const {
+        return End();
+    }
+
+    /* Capacity */
+
+    bool Empty() const {
+        return keys_.Empty();
+    }
+
+    size_t Size() const {
+        return keys_.Size();
+    }
+
+    void Reserve(size_t new_capacity) {
+        keys_.Reserve(new_capacity);
+    }
+
+    void ShrinkToFit() {
+        keys_.ShrinkToFit();
+    }
+
+    /* Lookup */
+
+    ConstIterator LowerBound(const Key& key) const {
+        return this->Begin() + detail::BranchlessLowerBound(keys_.Data(), keys_.Size(), key, comp_);
+    }
+
+    ConstIterator UpperBound(const Key& key) const {
+        return this->Begin() + detail::BranchlessUpperBound(keys_.Data(), keys_.Size(), key, comp_);
+    }
+
+    /* End() if there is no such key */
+    ConstIterator Find(const Key& key) const {
+        ConstIterator pos = this->LowerBound(key);
+        return pos != this->End() && !comp_(key, *pos) ? pos : this->End();
+    }
+
+    bool Contains(const Key& key) const {
+        return this->Find(key) != this->End();
+    }
+
+    size_t Count(const Key& key) const {
+        return this->Contains(key) ? 1 : 0;
+    }
+
+    /* The sorted keys */
+    const Vector<Key, Alloc>& Keys() const {
+        return keys_;
+    }
+
+    /* Modifiers */
+
+    void Clear() {
+        keys_.Clear();
+    }
+
+    /* The position of key and whether it was inserted */
+    std::pair<ConstIterator, bool> Insert(const Key& key) {
+        size_t pos = detail::BranchlessLowerBound(keys_.Data(), keys_.Size(), key, comp_);
+        if (pos < keys_.Size() && !comp_(key, keys_[pos])) {
+            return {this->Begin() + pos, false};
+        }
+        keys_.Insert(keys_.Begin() + static_cast<ptrdiff_t>(pos), key);
+        return {this->Begin() + pos, true};
+    }
+
+    /*
+     * Adds all keys of range with one sort of the new keys and one merge
+     * with the present ones, O(Size() + n log n) for n new keys
+     */
+    template <std::ranges::input_range Range>
+        requires std::convertible_to<std::ranges::range_reference_t<Range>, Key>
+    void InsertRange(Range&& range) {
+        Vector<Key, Alloc> added;
+        if constexpr (std::ranges::sized_range<Range>) {
+            added.Reserve(static_cast<size_t>(std::ranges::size(range)));
+        }
+        for (auto&& key : range) {
+            added.PushBack(key);
+        }
+        if (added.Empty()) {
+            return;
+        }
+
+        std::sort(added.Data(), added.Data() + added.Size(), comp_);
+        Vector<Key, Alloc> merged;
+        merged.Reserve(keys_.Size() + added.Size());
+        const Key* old_first = keys_.Data();
+        const Key* old_last = old_first + keys_.Size();
+        const Key* new_first = added.Data();
+        const Key* new_last = new_first + added.Size();
+        auto push_added = [&] {
+            /* Equal new keys are inserted once */
+            if (merged.Empty() || comp_(merged.Back(), *new_first)) {
+                merged.PushBack(*new_first);
+            }
+            ++new_first;
+        };
+
+        while (old_first != old_last && new_first != new_last) {
+            if (comp_(*old_first, *new_first)) {
+                merged.PushBack(*old_first++);
+            } else if (comp_(*new_first, *old_first)) {
+                push_added();
+            } else {
+                ++new_first; /* The present key wins */
+            }
+        }
+        while (old_first != old_last) {
+            merged.PushBack(*old_first++);
+        }
+        while (new_first != new_last) {
+            push_added();
+        }
+        keys_.Swap(merged);
+    }
+
+    void InsertRange(std::initializer_list<Key> keys) {
+        this->InsertRange(std::ranges::subrange(keys.begin(), keys.end()));
+    }
+
+    /* Number of keys erased, 0 or 1 */
+    size_t Erase(const Key& key) {
+        ConstIterator pos = this->Find(key);
+        if (pos == this->End()) {
+            return 0;
+        }
+        this->Erase(pos);
+        return 1;
+    }
+
+    ConstIterator Erase(ConstIterator pos) {
+        ptrdiff_t offset = pos - this->Begin();
+        assert(offset >= 0 && static_cast<size_t>(offset) < keys_.Size());
+        keys_.Erase(keys_.Begin() + offset);
+        return this->Begin() + offset;
+    }
+
+    void Swap(FlatSet& other) {
+        keys_.Swap(other.keys_);
+        std::swap(comp_, other.comp_);
+    }
+
+private:
+    bool IsSortedUnique() const {
+        return std::adjacent_find(this->Begin(), this->End(), [this](const Key& lhs, const Key& rhs) {
+                   return !comp_(lhs, rhs);
+               }) == this->End();
+    }
+
+private:
+    Vector<Key, Alloc> keys_ = {};
+    [[no_unique_address]] Compare comp_ = {};
+};
+
+}  // namespace stdlike
+
+#endif  // STDLIKE_FLAT_SET_HPP
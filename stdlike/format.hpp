@@ -0,0 +1,316 @@
+#ifndef STDLIKE_FORMAT_HPP
+#define STDLIKE_FORMAT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <array>
+#include <charconv>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include <stdlike/vector.hpp>
+
+namespace stdlike {
+
+/*
+ * Bulk text conversion of vectors with std::to_chars / std::from_chars.
+ * Output is collected in a stack buffer and handed to the sink in large
+ * pieces. A sink is a std::string (appended to), a std::ostream, a FILE*
+ * or any callable taking (const char* data, size_t size).
+ */
+
+struct FormatOptions {
+    std::string_view separator = " ";
+    int precision = -1; /* significant digits for floats, shortest round-trip if negative */
+};
+
+namespace detail {
+
+inline constexpr size_t kFormatBufferSize = 4096;
+inline constexpr size_t kMaxNumberChars = 64;
+
+template <typename Type>
+concept CharLike = std::is_same_v<Type, char> || std::is_same_v<Type, signed char> ||
+                   std::is_same_v<Type, unsigned char>;
+
+template <typename Type>
+concept Formattable = std::is_arithmetic_v<Type> && !std::is_same_v<Type, bool>;
+
+/* Anything but the options, so Format(vec, options) is the std::string overload */
+template <typename Sink>
+concept FormatSink = !std::is_same_v<std::remove_cvref_t<Sink>, FormatOptions>;
+
+template <typename Sink>
+void SinkWrite(Sink& sink, const char* data, size_t size) {
+    if constexpr (std::is_same_v<Sink, std::string>) {
+        sink.append(data, size);
+    } else if constexpr (std::is_base_of_v<std::ostream, Sink>) {
+        sink.write(data, static_cast<std::streamsize>(size));
+    } else if constexpr (std::is_same_v<Sink, FILE*>) {
+        std::fwrite(data, 1, size, sink);
+    } else {
+        sink(data, size);
+    }
+}
+
+/* Accumulates output and passes it to the sink in kFormatBufferSize pieces */
+template <typename Sink>
+class FormatBuffer {
+public:
+    explicit FormatBuffer(Sink& sink) : sink_(sink) {
+    }
+
+    FormatBuffer(const FormatBuffer&) = delete;
+    FormatBuffer& operator=(const FormatBuffer&) = delete;
+
+    ~FormatBuffer() {
+        this->Flush();
+    }
+
+    void Append(const char* data, size_t size) {
+        if (used_ + size > kFormatBufferSize) {
+            this->Flush();
+            if (size > kFormatBufferSize) {
+                return SinkWrite(sink_, data, size);
+            }
+        }
+
+        std::memcpy(buffer_ + used_, data, size);
+        used_ += size;
+    }
+
+    /*
+     * Numbers usually fit into kMaxNumberChars. Floats with a large explicit
+     * precision may not, they get the whole buffer and, failing that, a
+     * scratch buffer that grows until the number fits.
+     */
+    template <Formattable Type>
+    void AppendNumber(Type value, int precision) {
+        if (used_ + kMaxNumberChars > kFormatBufferSize) {
+            this->Flush();
+        }
+
+        std::to_chars_result result = ToChars(buffer_ + used_, buffer_ + kFormatBufferSize, value, precision);
+        if (result.ec == std::errc::value_too_large && used_ > 0) {
+            this->Flush();
+            result = ToChars(buffer_, buffer_ + kFormatBufferSize, value, precision);
+        }
+
+        if (result.ec == std::errc()) {
+            used_ = static_cast<size_t>(result.ptr - buffer_);
+            return;
+        }
+
+        Vector<char> scratch;
+        for (size_t size = 2 * kFormatBufferSize; result.ec == std::errc::value_too_large; size *= 2) {
+            scratch.ResizeForOverwrite(size);
+            result = ToChars(scratch.Data(), scratch.Data() + size, value, precision);
+        }
+        SinkWrite(sink_, scratch.Data(), static_cast<size_t>(result.ptr - scratch.Data()));
+    }
+
+    void Flush() {
+        if (used_ > 0) {
+            SinkWrite(sink_, buffer_, used_);
+            used_ = 0;
+        }
+    }
+
+private:
+    template <Formattable Type>
+    static std::to_chars_result ToChars(char* first, char* last, Type value, int precision) {
+        if constexpr (CharLike<Type>) {
+            *first = static_cast<char>(value);
+            return {first + 1, std::errc()};
+        } else if constexpr (std::is_floating_point_v<Type>) {
+            return (precision < 0) ? std::to_chars(first, last, value)
+                                   : std::to_chars(first, last, value, std::chars_format::general, precision);
+        } else {
+            return std::to_chars(first, last, value);
+        }
+    }
+
+private:
+    Sink& sink_;
+    size_t used_ = 0;
+    char buffer_[kFormatBufferSize];
+};
+
+/* "b s" pairs for every bit of a byte, in the bit order of Vector<bool> words */
+template <BitOrder kOrder>
+inline constexpr std::array<std::array<char, 16>, 256> kBitPairs = []() {
+    std::array<std::array<char, 16>, 256> pairs = {};
+    for (size_t byte = 0; byte < 256; byte++) {
+        for (size_t bit = 0; bit < 8; bit++) {
+            size_t shift = (kOrder == BitOrder::kMsbFirst) ? 7 - bit : bit;
+            pairs[byte][2 * bit] = ((byte >> shift) & 1) ? '1' : '0';
+            pairs[byte][2 * bit + 1] = ' ';
+        }
+    }
+    return pairs;
+}();
+
+template <typename Type>
+bool ParseToken(const char* first, const char* last, Type& value) {
+    if constexpr (CharLike<Type>) {
+        value = static_cast<Type>(*first);
+        return last - first == 1;
+    } else {
+        std::from_chars_result result = std::from_chars(first, last, value);
+        return result.ec == std::errc() && result.ptr == last;
+    }
+}
+
+inline bool IsSeparator(char symbol) {
+    return symbol == ' ' || symbol == ',' || symbol == '\n' || symbol == '\t' || symbol == '\r' || symbol == ';';
+}
+
+}  // namespace detail
+
+/* Format */
+
+template <detail::Formattable Type, class Alloc, detail::FormatSink Sink>
+void Format(const Vector<Type, Alloc>& vec, Sink&& sink, FormatOptions options = {}) {
+    using SinkType = std::remove_reference_t<Sink>;
+    detail::FormatBuffer<SinkType> buffer(sink);
+
+    const Type* data = vec.Data();
+    for (size_t pos = 0; pos < vec.Size(); pos++) {
+        if (pos != 0) {
+            buffer.Append(options.separator.data(), options.separator.size());
+        }
+        buffer.AppendNumber(data[pos], options.precision);
+    }
+}
+
+/*
+ * Bits are printed as 0/1, a byte of bits at a time for the " " separator.
+ * The last word always takes the slow path, it must not end with a separator.
+ */
+template <class Alloc, detail::FormatSink Sink>
+    requires detail::BitVectorAllocator<Alloc>
+void Format(const Vector<bool, Alloc>& vec, Sink&& sink, FormatOptions options = {}) {
+    constexpr BitOrder kOrder = Vector<bool, Alloc>::kBitOrder;
+    using SinkType = std::remove_reference_t<Sink>;
+    detail::FormatBuffer<SinkType> buffer(sink);
+
+    size_t size = vec.Size();
+    size_t pos = 0;
+    if (options.separator == " ") {
+        const uint32_t* words = vec.Data();
+        for (; pos + 32 < size; pos += 32) {
+            uint32_t word = words[pos / 32];
+            for (int byte = 0; byte < 4; byte++) {
+                int shift = (kOrder == BitOrder::kMsbFirst) ? 24 - 8 * byte : 8 * byte;
+                buffer.Append(detail::kBitPairs<kOrder>[(word >> shift) & 0xFF].data(), 16);
+            }
+        }
+    }
+
+    for (; pos < size; pos++) {
+        buffer.Append(vec[pos] ? "1" : "0", 1);
+        if (pos + 1 != size) {
+            buffer.Append(options.separator.data(), options.separator.size());
+        }
+    }
+}
+
+template <class Type, class Alloc>
+std::string Format(const Vector<Type, Alloc>& vec, FormatOptions options = {}) {
+    std::string text;
+    Format(vec, text, options);
+    return text;
+}
+
+/*
+ * Parse: replaces the contents of vec with the numbers of text. Numbers may
+ * be separated by spaces, tabs, newlines, commas or semicolons. Returns the
+ * count of parsed elements, throws std::invalid_argument on a bad token.
+ */
+
+template <detail::Formattable Type, class Alloc>
+size_t Parse(std::string_view text, Vector<Type, Alloc>& vec) {
+    constexpr size_t kChunkSize = 256;
+    Type chunk[kChunkSize];
+    size_t chunk_used = 0;
+
+    auto flush = [&vec, &chunk, &chunk_used]() {
+        std::memcpy(vec.AppendUninitialized(chunk_used), chunk, chunk_used * sizeof(Type));
+        chunk_used = 0;
+    };
+
+    vec.Clear();
+    const char* cur = text.data();
+    const char* end = text.data() + text.size();
+    while (true) {
+        while (cur < end && detail::IsSeparator(*cur)) {
+            cur++;
+        }
+        if (cur == end) {
+            break;
+        }
+
+        const char* token_end = cur;
+        while (token_end < end && !detail::IsSeparator(*token_end)) {
+            token_end++;
+        }
+
+        if (!detail::ParseToken(cur, token_end, chunk[chunk_used])) {
+            throw std::invalid_argument("stdlike::Parse: bad token '" + std::string(cur, token_end) + "'");
+        }
+
+        if (++chunk_used == kChunkSize) {
+            flush();
+        }
+        cur = token_end;
+    }
+
+    flush();
+    return vec.Size();
+}
+
+template <class Alloc>
+    requires detail::BitVectorAllocator<Alloc>
+size_t Parse(std::string_view text, Vector<bool, Alloc>& vec) {
+    vec.Clear();
+    for (char symbol : text) {
+        if (symbol == '0' || symbol == '1') {
+            vec.PushBack(symbol == '1');
+        } else if (!detail::IsSeparator(symbol)) {
+            throw std::invalid_argument("stdlike::Parse: bad bit '" + std::string(1, symbol) + "'");
+        }
+    }
+
+    return vec.Size();
+}
+
+/* Stream output, fast paths are used unless the stream has custom formatting */
+
+template <class Type, class Alloc>
+std::ostream& operator<<(std::ostream& stream, const Vector<Type, Alloc>& vec) {
+    constexpr std::ios_base::fmtflags kDefaultFlags = std::ios_base::skipws | std::ios_base::dec;
+    if constexpr (detail::Formattable<Type> || (std::is_same_v<Type, bool> && detail::BitVectorAllocator<Alloc>)) {
+        if (stream.flags() == kDefaultFlags && stream.width() == 0) {
+            Format(vec, stream, FormatOptions{" ", static_cast<int>(stream.precision())});
+            return stream;
+        }
+    }
+
+    for (size_t i = 0; i < vec.Size(); i++) {
+        stream << vec.At(i);
+        if (i != vec.Size() - 1) {
+            stream << " ";
+        }
+    }
+
+    return stream;
+}
+
+}  // namespace stdlike
+
+#endif  // STDLIKE_FORMAT_HPP
@@ -0,0 +1,109 @@
+#ifndef STDLIKE_HASH_HPP
+#define STDLIKE_HASH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace stdlike {
+
+/*
+ * 64-bit hash of a byte buffer, XXH64 algorithm. Four independent lanes
+ * consume 32 bytes per step, so the main loop is limited by multiply
+ * throughput rather than latency.
+ */
+
+namespace detail {
+
+inline constexpr uint64_t kHashPrime1 = 0x9E3779B185EBCA87ull;
+inline constexpr uint64_t kHashPrime2 = 0xC2B2AE3D27D4EB4Full;
+inline constexpr uint64_t kHashPrime3 = 0x165667B19E3779F9ull;
+inline constexpr uint64_t kHashPrime4 = 0x85EBCA77C2B2AE63ull;
+inline constexpr uint64_t kHashPrime5 = 0x27D4EB2F165667C5ull;
+
+inline uint64_t Rotl64(uint64_t value, int shift) {
+    return (value << shift) | (value >> (64 - shift));
+}
+
+inline uint64_t Load64(const unsigned char* bytes) {
+    uint64_t value = 0;
+    std::memcpy(&value, bytes, sizeof(value));
+    return value;
+}
+
+inline uint32_t Load32(const unsigned char* bytes) {
+    uint32_t value = 0;
+    std::memcpy(&value, bytes, sizeof(value));
+    return value;
+}
+
+inline uint64_t HashRound(uint64_t acc, uint64_t input) {
+    acc += input * kHashPrime2;
+    acc = Rotl64(acc, 31);
+    return acc * kHashPrime1;
+}
+
+inline uint64_t HashMergeRound(uint64_t acc, uint64_t lane) {
+    acc ^= HashRound(0, lane);
+    return acc * kHashPrime1 + kHashPrime4;
+}
+
+}  // namespace detail
+
+inline uint64_t Hash64(const void* data, size_t bytes_n, uint64_t seed = 0) {
+    using namespace detail;
+
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    const unsigned char* end = bytes + bytes_n;
+    uint64_t hash = 0;
+
+    if (bytes_n >= 32) {
+        uint64_t lanes[4] = {seed + kHashPrime1 + kHashPrime2, seed + kHashPrime2, seed, seed - kHashPrime1};
+        for (; end - bytes >= 32; bytes += 32) {
+            for (size_t lane = 0; lane < 4; lane++) {
+                lanes[lane] = HashRound(lanes[lane], Load64(bytes + 8 * lane));
+            }
+        }
+
+        hash = Rotl64(lanes[0], 1) + Rotl64(lanes[1], 7) + Rotl64(lanes[2], 12) + Rotl64(lanes[3], 18);
+        for (uint64_t lane : lanes) {
+            hash = HashMergeRound(hash, lane);
+        }
+    } else {
+        hash = seed + kHashPrime5;
+    }
+
+    hash += bytes_n;
+
+    for (; end - bytes >= 8; bytes += 8) {
+        hash ^= HashRound(0, Load64(bytes));
+        hash = Rotl64(hash, 27) * kHashPrime1 + kHashPrime4;
+    }
+
+    if (end - bytes >= 4) {
+        hash ^= static_cast<uint64_t>(Load32(bytes)) * kHashPrime1;
+        hash = Rotl64(hash, 23) * kHashPrime2 + kHashPrime3;
+        bytes += 4;
+    }
+
+    for (; bytes < end; bytes++) {
+        hash ^= static_cast<uint64_t>(*bytes) * kHashPrime5;
+        hash = Rotl64(hash, 11) * kHashPrime1;
+    }
+
+    hash ^= hash >> 33;
+    hash *= kHashPrime2;
+    hash ^= hash >> 29;
+    hash *= kHashPrime3;
+    hash ^= hash >> 32;
+
+    return hash;
+}
+
+/* Hash functor, specialized next to the types it hashes (e.g. Vector in vector.hpp) */
+template <typename Type>
+struct Hash {};
+
+}  // namespace stdlike
+
+#endif  // STDLIKE_HASH_HPP
@@ -0,0 +1,307 @@
+#ifndef STDLIKE_INSTRUMENT_HPP
+#define STDLIKE_INSTRUMENT_HPP
+
+/*
+ * Allocation instrumentation, compiled in with -DSTDLIKE_INSTRUMENT=<mode>:
+ *
+ *   0 - off (default), hooks expand to nothing
+ *   1 - global statistics behind one mutex
+ *   2 - thread-local statistics, merged when a report is taken
+ *
+ * Vector operations that may allocate take a trailing defaulted
+ * std::source_location, so every allocation, reallocation, Reserve and
+ * ShrinkToFit is attributed to the line that called into the vector.
+ * stdlike::instrument::Report() prints the sites ordered by reallocations,
+ * the ones at the top are the candidates for an up-front Reserve.
+ */
+
+#ifndef STDLIKE_INSTRUMENT
+#define STDLIKE_INSTRUMENT 0
+#endif
+
+#if STDLIKE_INSTRUMENT
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <algorithm>
+#include <mutex>
+#include <source_location>
+#include <unordered_map>
+#include <vector>
+
+/* Parameter lists and hook calls of instrumented functions */
+#define STDLIKE_SITE_PARAM , std::source_location site = std::source_location::current()
+#define STDLIKE_SITE_PARAM_FIRST std::source_location site = std::source_location::current()
+#define STDLIKE_SITE_ARG , site
+#define STDLIKE_SITE_ARG_FIRST site
+#define STDLIKE_INSTRUMENT_HOOK(...) ::stdlike::instrument::__VA_ARGS__
+#define STDLIKE_INSTRUMENT_SCOPE(site) ::stdlike::instrument::SiteScope instrument_scope_(site)
+
+namespace stdlike::instrument {
+
+enum class Event {
+    kConstruct,    /* first buffer of a vector */
+    kReallocation, /* growth or shrink that moved the elements */
+    kReserve,
+    kShrinkToFit,
+};
+
+struct SiteStats {
+    uint64_t allocations = 0;
+    uint64_t bytes_allocated = 0;
+    uint64_t reallocations = 0;
+    uint64_t bytes_copied = 0;
+    uint64_t reserves = 0;
+    uint64_t shrinks = 0;
+    uint64_t peak_capacity = 0; /* bytes */
+    uint64_t max_slack = 0;     /* bytes of capacity - size */
+    uint64_t slack_sum = 0;
+    uint64_t slack_samples = 0;
+
+    void Merge(const SiteStats& other) {
+        allocations += other.allocations;
+        bytes_allocated += other.bytes_allocated;
+        reallocations += other.reallocations;
+        bytes_copied += other.bytes_copied;
+        reserves += other.reserves;
+        shrinks += other.shrinks;
+        peak_capacity = std::max(peak_capacity, other.peak_capacity);
+        max_slack = std::max(max_slack, other.max_slack);
+        slack_sum += other.slack_sum;
+        slack_samples += other.slack_samples;
+    }
+};
+
+struct SiteReport {
+    const char* file = nullptr;
+    const char* function = nullptr;
+    uint32_t line = 0;
+    SiteStats stats = {};
+};
+
+namespace detail {
+
+/* source_location strings are static, comparing pointers is enough */
+struct SiteKey {
+    const char* file = nullptr;
+    const char* function = nullptr;
+    uint32_t line = 0;
+    uint32_t column = 0;
+
+    bool operator==(const SiteKey&) const = default;
+};
+
+struct SiteKeyHash {
+    size_t operator()(const SiteKey& key) const {
+        size_t hash = reinterpret_cast<uintptr_t>(key.file);
+        hash = hash * 0x9E3779B97F4A7C15ull + key.line;
+        return hash * 0x9E3779B97F4A7C15ull + key.column;
+    }
+};
+
+using SiteMap = std::unordered_map<SiteKey, SiteStats, SiteKeyHash>;
+
+inline SiteKey MakeKey(const std::source_location& site) {
+    return {site.file_name(), site.function_name(), site.line(), site.column()};
+}
+
+inline void MergeInto(SiteMap& into, const SiteMap& from) {
+    for (const auto& [key, stats] : from) {
+        into[key].Merge(stats);
+    }
+}
+
+struct ThreadStats;
+
+/* Retired statistics plus the live per-thread tables */
+struct Registry {
+    std::mutex mutex = {};
+    SiteMap sites = {};
+    std::vector<ThreadStats*> threads = {};
+};
+
+inline Registry& GlobalRegistry() {
+    static Registry registry;
+    return registry;
+}
+
+/* Owned by one thread, the mutex is only contended while a report is taken */
+struct ThreadStats {
+    std::mutex mutex = {};
+    SiteMap sites = {};
+
+    ThreadStats() {
+        Registry& registry = GlobalRegistry();
+        std::lock_guard<std::mutex> guard(registry.mutex);
+        registry.threads.push_back(this);
+    }
+
+    ThreadStats(const ThreadStats&) = delete;
+    ThreadStats& operator=(const ThreadStats&) = delete;
+
+    ~ThreadStats() {
+        Registry& registry = GlobalRegistry();
+        std::lock_guard<std::mutex> guard(registry.mutex);
+        MergeInto(registry.sites, sites);
+        std::erase(registry.threads, this);
+    }
+};
+
+inline thread_local const std::source_location* current_site = nullptr;
+
+inline ThreadStats& LocalStats() {
+    static thread_local ThreadStats thread_stats;
+    return thread_stats;
+}
+
+/* Runs func(SiteStats&) for the site under the lock of the current mode */
+template <typename Func>
+void Update(const std::source_location& site, Func func) {
+    const std::source_location& target = current_site ? *current_site : site;
+#if STDLIKE_INSTRUMENT == 2
+    ThreadStats& thread_stats = LocalStats();
+    std::lock_guard<std::mutex> guard(thread_stats.mutex);
+    func(thread_stats.sites[MakeKey(target)]);
+#else
+    Registry& registry = GlobalRegistry();
+    std::lock_guard<std::mutex> guard(registry.mutex);
+    func(registry.sites[MakeKey(target)]);
+#endif
+}
+
+}  // namespace detail
+
+/*
+ * Attributes allocator calls made inside a vector operation to the caller
+ * of the operation instead of the line inside the vector
+ */
+class SiteScope {
+public:
+    explicit SiteScope(const std::source_location& site) : previous_(detail::current_site) {
+        if (!previous_) {
+            detail::current_site = &site;
+        }
+    }
+
+    SiteScope(const SiteScope&) = delete;
+    SiteScope& operator=(const SiteScope&) = delete;
+
+    ~SiteScope() {
+        detail::current_site = previous_;
+    }
+
+private:
+    const std::source_location* previous_ = nullptr;
+};
+
+/* Hooks */
+
+inline void Allocation(const std::source_location& site, size_t bytes) {
+    detail::Update(site, [bytes](SiteStats& stats) {
+        stats.allocations++;
+        stats.bytes_allocated += bytes;
+    });
+}
+
+/* Capacities and sizes are in bytes, copied is what the event moved */
+inline void CapacityChange(const std::source_location& site, Event event, size_t new_capacity, size_t size,
+                           size_t copied) {
+    detail::Update(site, [event, new_capacity, size, copied](SiteStats& stats) {
+        switch (event) {
+            case Event::kConstruct:
+                break;
+            case Event::kReallocation:
+                stats.reallocations++;
+                stats.bytes_copied += copied;
+                break;
+            case Event::kReserve:
+                stats.reserves++;
+                break;
+            case Event::kShrinkToFit:
+                stats.shrinks++;
+                break;
+            default:
+                break;
+        }
+
+        size_t slack = new_capacity - std::min(size, new_capacity);
+        stats.peak_capacity = std::max<uint64_t>(stats.peak_capacity, new_capacity);
+        stats.max_slack = std::max<uint64_t>(stats.max_slack, slack);
+        stats.slack_sum += slack;
+        stats.slack_samples++;
+    });
+}
+
+/* Reports */
+
+/* Merged statistics of all threads, ordered by reallocations */
+inline std::vector<SiteReport> Snapshot() {
+    detail::Registry& registry = detail::GlobalRegistry();
+    std::lock_guard<std::mutex> guard(registry.mutex);
+
+    detail::SiteMap merged = registry.sites;
+    for (detail::ThreadStats* thread : registry.threads) {
+        std::lock_guard<std::mutex> thread_guard(thread->mutex);
+        detail::MergeInto(merged, thread->sites);
+    }
+
+    std::vector<SiteReport> reports;
+    reports.reserve(merged.size());
+    for (const auto& [key, stats] : merged) {
+        reports.push_back({key.file, key.function, key.line, stats});
+    }
+
+    std::sort(reports.begin(), reports.end(), [](const SiteReport& lhs, const SiteReport& rhs) {
+        if (lhs.stats.reallocations != rhs.stats.reallocations) {
+            return lhs.stats.reallocations > rhs.stats.reallocations;
+        }
+        return lhs.stats.bytes_copied > rhs.stats.bytes_copied;
+    });
+
+    return reports;
+}
+
+inline void Reset() {
+    detail::Registry& registry = detail::GlobalRegistry();
+    std::lock_guard<std::mutex> guard(registry.mutex);
+
+    registry.sites.clear();
+    for (detail::ThreadStats* thread : registry.threads) {
+        std::lock_guard<std::mutex> thread_guard(thread->mutex);
+        thread->sites.clear();
+    }
+}
+
+inline void Report(FILE* file = stderr, size_t max_sites = 20) {
+    std::vector<SiteReport> reports = Snapshot();
+
+    std::fprintf(file, "%-48s %8s %8s %8s %14s %12s %12s %12s\n", "site", "allocs", "reallocs", "reserves",
+                 "bytes copied", "peak cap", "max slack", "avg slack");
+    for (size_t pos = 0; pos < std::min(max_sites, reports.size()); pos++) {
+        const SiteReport& report = reports[pos];
+        const SiteStats& stats = report.stats;
+
+        char location[48] = {};
+        std::snprintf(location, sizeof(location), "%s:%u", report.file, report.line);
+        uint64_t avg_slack = stats.slack_samples ? stats.slack_sum / stats.slack_samples : 0;
+        std::fprintf(file, "%-48s %8lu %8lu %8lu %14lu %12lu %12lu %12lu\n", location, stats.allocations,
+                     stats.reallocations, stats.reserves, stats.bytes_copied, stats.peak_capacity, stats.max_slack,
+                     avg_slack);
+    }
+}
+
+}  // namespace stdlike::instrument
+
+#else
+
+#define STDLIKE_SITE_PARAM
+#define STDLIKE_SITE_PARAM_FIRST
+#define STDLIKE_SITE_ARG
+#define STDLIKE_SITE_ARG_FIRST
+#define STDLIKE_INSTRUMENT_HOOK(...) ((void)0)
+#define STDLIKE_INSTRUMENT_SCOPE(site) ((void)0)
+
+#endif  // STDLIKE_INSTRUMENT
+
+#endif  // STDLIKE_INSTRUMENT_HPP
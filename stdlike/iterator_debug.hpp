@@ -0,0 +1,49 @@
+#ifndef STDLIKE_ITERATOR_DEBUG_HPP
+#define STDLIKE_ITERATOR_DEBUG_HPP
+
+/*
+ * Iterator hardening, set with -DSTDLIKE_ITERATOR_DEBUG=<level>:
+ *
+ *   0 - Vector<Type> iterators are plain pointers and Vector<bool> iterators
+ *       are a word pointer and a bit offset, nothing else is stored or checked
+ *   1 - iterators also remember their vector and its generation, which every
+ *       reallocation (and move or copy assignment) bumps. Dereferencing a
+ *       stale or out of range iterator, or handing one to Insert/Erase,
+ *       aborts with the location of the check
+ *
+ * Defaults to 1 in _DEBUG builds and to 0 otherwise. The level changes the
+ * layout of Vector, all translation units of a program must agree on it.
+ */
+
+#ifndef STDLIKE_ITERATOR_DEBUG
+#ifdef _DEBUG
+#define STDLIKE_ITERATOR_DEBUG 1
+#else
+#define STDLIKE_ITERATOR_DEBUG 0
+#endif
+#endif
+
+#if STDLIKE_ITERATOR_DEBUG
+
+#include <cstdio>
+#include <cstdlib>
+
+#define STDLIKE_ITERATOR_CHECK(cond, message) \
+    ((cond) ? (void)0 : ::stdlike::detail::IteratorCheckFailed(message, __FILE__, __LINE__))
+
+namespace stdlike::detail {
+
+[[noreturn]] inline void IteratorCheckFailed(const char* message, const char* file, int line) {
+    std::fprintf(stderr, "%s:%d: iterator check failed: %s\n", file, line, message);
+    std::abort();
+}
+
+}  // namespace stdlike::detail
+
+#else
+
+#define STDLIKE_ITERATOR_CHECK(cond, message) ((void)0)
+
+#endif  // STDLIKE_ITERATOR_DEBUG
+
+#endif  // STDLIKE_ITERATOR_DEBUG_HPP
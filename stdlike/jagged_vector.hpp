@@ -0,0 +1,496 @@
+#ifndef STDLIKE_JAGGED_VECTOR_HPP
+#define STDLIKE_JAGGED_VECTOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+#include <cstring>
+#include <algorithm>
+#include <atomic>
+#include <compare>
+#include <concepts>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include <stdlike/algorithm.hpp>
+#include <stdlike/allocator.hpp>
+#include <stdlike/execution.hpp>
+#include <stdlike/vector.hpp>
+
+namespace stdlike {
+
+/*
+ * Vector of variable-length rows in CSR layout: the values of all rows are
+ * stored back to back in one Vector, row i is [Offsets()[i], Offsets()[i + 1])
+ * of Values(). Replaces Vector<Vector<Type>> for adjacency lists and the like,
+ * two heap blocks in total instead of one per row, and walking the rows in
+ * order streams through memory.
+ *
+ * Rows are appended at the end only. Row spans and iterators are invalidated
+ * by any append, the same way Vector iterators are.
+ */
+template <typename Type, class Alloc = Allocator<Type>>
+class JaggedVector {
+public:
+    using Row = std::span<Type>;
+    using ConstRow = std::span<const Type>;
+
+    /* RowIterator: the container and a row index, dereferences to the row span */
+
+    template <bool kConst>
+    class RowIterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using difference_type = ptrdiff_t;
+        using value_type = std::conditional_t<kConst, ConstRow, Row>;
+        using pointer = void;
+        using reference = value_type;
+
+        using Owner = std::conditional_t<kConst, const JaggedVector, JaggedVector>;
+
+        RowIterator() = default;
+
+        RowIterator(Owner* container, size_t row) : container_(container), row_(row) {
+        }
+
+        /* Iterator -> ConstIterator */
+        template <bool kOtherConst>
+            requires(kConst && !kOtherConst)
+        RowIterator(const RowIterator<kOtherConst>& other) : container_(other.container_), row_(other.row_) {
+        }
+
+        reference operator*() const {
+            return (*container_)[row_];
+        }
+
+        reference operator[](difference_type diff) const {
+            return *(*this + diff);
+        }
+
+        RowIterator& operator++() {
+            row_++;
+            return *this;
+        }
+
+        RowIterator operator++(int) {
+            RowIterator old = *this;
+            row_++;
+            return old;
+        }
+
+        RowIterator& operator--() {
+            row_--;
+            return *this;
+        }
+
+        RowIterator operator--(int) {
+            RowIterator old = *this;
+            row_--;
+            return old;
+        }
+
+        RowIterator& operator+=(difference_type diff) {
+            row_ = static_cast<size_t>(static_cast<difference_type>(row_) + diff);
+            return *this;
+        }
+
+        RowIterator& operator-=(difference_type diff) {
+            return *this += -diff;
+        }
+
+        friend RowIterator operator+(RowIterator iter, difference_type diff) {
+            return iter += diff;
+        }
+
+        friend RowIterator operator+(difference_type diff, RowIterator iter) {
+            return iter += diff;
+        }
+
+        friend RowIterator operator-(RowIterator iter, difference_type diff) {
+            return iter -= diff;
+        }
+
+        friend difference_type operator-(const RowIterator& lhs, const RowIterator& rhs) {
+            return static_cast<difference_type>(lhs.row_) - static_cast<difference_type>(rhs.row_);
+        }
+
+        friend bool operator==(const RowIterator& lhs, const RowIterator& rhs) {
+            return lhs.row_ == rhs.row_;
+        }
+
+        friend std::strong_ordering operator<=>(const RowIterator& lhs, const RowIterator& rhs) {
+            return lhs.row_ <=> rhs.row_;
+        }
+
+    private:
+        template <bool>
+        friend class RowIterator;
+
+        Owner* container_ = nullptr;
+        size_t row_ = 0;
+    };
+
+    using Iterator = RowIterator<false>;
+    using ConstIterator = RowIterator<true>;
+
+    /*
+     * Collects (row, value) pairs in any order when row sizes are not known
+     * up front, Build() then places every value in one counting pass
+     */
+    class Builder {
+    public:
+        void Add(size_t row, const Type& value) {
+            rows_.PushBack(row);
+            values_.PushBack(value);
+            rows_n_ = std::max(rows_n_, row + 1);
+        }
+
+        /* Rows with no values in the middle or at the end, Build() makes at least rows_n rows */
+        void ReserveRows(size_t rows_n) {
+            rows_n_ = std::max(rows_n_, rows_n);
+        }
+
+        size_t Size() const {
+            return values_.Size();
+        }
+
+        /* Values of a row keep the order they were added in */
+        JaggedVector Build() const {
+            return JaggedVector::FromPairs(rows_n_, rows_, values_);
+        }
+
+        /* Order of values within a row is unspecified */
+        JaggedVector Build(ParallelPolicy) const {
+            return JaggedVector::FromPairs(par, rows_n_, rows_, values_);
+        }
+
+        void Clear() {
+            rows_.Clear();
+            values_.Clear();
+            rows_n_ = 0;
+        }
+
+    private:
+        Vector<size_t> rows_ = {};
+        Vector<Type, Alloc> values_ = {};
+        size_t rows_n_ = 0;
+    };
+
+    /* JaggedVector<Type> */
+
+    JaggedVector() = default;
+
+    JaggedVector(std::initializer_list<std::initializer_list<Type>> rows) {
+        for (const auto& row : rows) {
+            this->AppendRow(row);
+        }
+    }
+
+    JaggedVector(const JaggedVector& other) = default;
+    JaggedVector(JaggedVector&& temp) = default;
+    JaggedVector& operator=(const JaggedVector& other) = default;
+    JaggedVector& operator=(JaggedVector&& temp) = default;
+
+    /*
+     * Row row_of[i] gets values[i] for every i < pairs_n, e.g. an edge list
+     * (sources, targets) becomes the adjacency lists of rows_n vertices.
+     * A row keeps its values in input order.
+     */
+    template <std::unsigned_integral Index>
+    static JaggedVector FromPairs(size_t rows_n, const Index* row_of, const Type* values, size_t pairs_n) {
+        JaggedVector result;
+        result.offsets_ = Vector<size_t>(rows_n + 1, 0);
+        size_t* offsets = result.offsets_.Data();
+        for (size_t pos = 0; pos < pairs_n; pos++) {
+            assert(row_of[pos] < rows_n);
+            offsets[static_cast<size_t>(row_of[pos]) + 1]++;
+        }
+        InclusiveScan(offsets + 1, offsets + rows_n + 1, offsets + 1);
+
+        /* offsets[row] walks the row while scattering and ends at the next row's start */
+        result.values_.ResizeForOverwrite(pairs_n);
+        Type* out = result.values_.Data();
+        for (size_t pos = 0; pos < pairs_n; pos++) {
+            out[offsets[row_of[pos]]++] = values[pos];
+        }
+        std::memmove(offsets + 1, offsets, rows_n * sizeof(size_t));
+        offsets[0] = 0;
+        return result;
+    }
+
+    /*
+     * Parallel counting and scattering with atomic per-row cursors, so the
+     * order of values within a row is unspecified. Inputs shorter than
+     * kParallelThreshold go through the serial version.
+     */
+    template <std::unsigned_integral Index>
+    static JaggedVector FromPairs(ParallelPolicy, size_t rows_n, const Index* row_of, const Type* values,
+                                  size_t pairs_n) {
+        if (pairs_n < kParallelThreshold) {
+            return FromPairs(rows_n, row_of, values, pairs_n);
+        }
+
+        JaggedVector result;
+        result.offsets_ = Vector<size_t>(rows_n + 1, 0);
+        size_t* offsets = result.offsets_.Data();
+        ParallelFor(0, pairs_n, [=](size_t begin, size_t end) {
+            for (size_t pos = begin; pos < end; pos++) {
+                assert(row_of[pos] < rows_n);
+                size_t row = static_cast<size_t>(row_of[pos]);
+                std::atomic_ref<size_t>(offsets[row + 1]).fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+        InclusiveScan(par, offsets + 1, offsets + rows_n + 1, offsets + 1);
+
+        Vector<size_t> cursors(default_init, rows_n);
+        std::memcpy(cursors.Data(), offsets, rows_n * sizeof(size_t));
+        result.values_.ResizeForOverwrite(pairs_n);
+        Type* out = result.values_.Data();
+        ParallelFor(0, pairs_n, [=, cursors = cursors.Data()](size_t begin, size_t end) {
+            for (size_t pos = begin; pos < end; pos++) {
+                size_t dest = std::atomic_ref<size_t>(cursors[row_of[pos]]).fetch_add(1, std::memory_order_relaxed);
+                out[dest] = values[pos];
+            }
+        });
+        return result;
+    }
+
+    template <std::unsigned_integral Index, class IndexAlloc, class ValueAlloc>
+    static JaggedVector FromPairs(size_t rows_n, const Vector<Index, IndexAlloc>& row_of,
+                                  const Vector<Type, ValueAlloc>& values) {
+        assert(row_of.Size() == values.Size());
+        return FromPairs(rows_n, row_of.Data(), values.Data(), values.Size());
+    }
+
+    template <std::unsigned_integral Index, class IndexAlloc, class ValueAlloc>
+    static JaggedVector FromPairs(ParallelPolicy, size_t rows_n, const Vector<Index, IndexAlloc>& row_of,
+                                  const Vector<Type, ValueAlloc>& values) {
+        assert(row_of.Size() == values.Size());
+        return FromPairs(par, rows_n, row_of.Data(), values.Data(), values.Size());
+    }
+
+    /* Comparison: same rows with the same values */
+
+    friend bool operator==(const JaggedVector& lhs, const JaggedVector& rhs)
+        requires std::equality_comparable<Type>
+    {
+        if (lhs.Size() != rhs.Size()) {
+            return false;
+        }
+        return lhs.Empty() || (lhs.offsets_ == rhs.offsets_ && lhs.values_ == rhs.values_);
+    }
+
+    /* Iterators */
+
+    Iterator Begin() {
+        return Iterator(this, 0);
+    }
+
+    Iterator End() {
+        return Iterator(this, this->Size());
+    }
+
+    ConstIterator Begin() const {
+        return ConstIterator(this, 0);
+    }
+
+    ConstIterator End() const {
+        return ConstIterator(this, this->Size());
+    }
+
+    Iterator begin() {
+        return Begin();
+    }
+
+    Iterator end() {
+        return End();
+    }
+
+    ConstIterator begin() const {
+        return Begin();
+    }
+
+    ConstIterator end() const {
+        return End();
+    }
+
+    /* Capacity */
+
+    bool Empty() const {
+        return this->Size() == 0;
+    }
+
+    /* Number of rows */
+    size_t Size() const {
+        return offsets_.Empty() ? 0 : offsets_.Size() - 1;
+    }
+
+    /* Number of values in all rows */
+    size_t ValuesCount() const {
+        return values_.Size();
+    }
+
+    size_t RowSize(size_t row) const {
+        assert(row < this->Size());
+        return offsets_[row + 1] - offsets_[row];
+    }
+
+    void Reserve(size_t rows_n, size_t values_n) {
+        offsets_.Reserve(rows_n + 1);
+        values_.Reserve(values_n);
+    }
+
+    void ShrinkToFit() {
+        offsets_.ShrinkToFit();
+        values_.ShrinkToFit();
+    }
+
+    /* Element access */
+
+    ConstRow operator[](size_t row) const {
+        return ConstRow(values_.Data() + offsets_[row], offsets_[row + 1] - offsets_[row]);
+    }
+
+    Row operator[](size_t row) {
+        return Row(values_.Data() + offsets_[row], offsets_[row + 1] - offsets_[row]);
+    }
+
+    ConstRow At(size_t row) const {
+        assert(row < this->Size());
+        return (*this)[row];
+    }
+
+    Row At(size_t row) {
+        assert(row < this->Size());
+        return (*this)[row];
+    }
+
+    ConstRow Back() const {
+        return (*this)[this->Size() - 1];
+    }
+
+    Row Back() {
+        return (*this)[this->Size() - 1];
+    }
+
+    /* Raw CSR arrays, Offsets() has Size() + 1 entries unless the vector is empty */
+
+    const Vector<Type, Alloc>& Values() const {
+        return values_;
+    }
+
+    const Vector<size_t>& Offsets() const {
+        return offsets_;
+    }
+
+    /* Modifiers */
+
+    /*
+     * Appends a row with the values of range, sized contiguous ranges are copied in one go.
+     * The range may view rows of this vector: a contiguous one is found again after the
+     * values move, any other range is read into a temporary before the values move.
+     */
+    template <std::ranges::input_range Range>
+        requires std::convertible_to<std::ranges::range_reference_t<Range>, Type>
+    Row AppendRow(Range&& range) {
+        constexpr bool kSameContiguous =
+            std::ranges::contiguous_range<Range> &&
+            std::is_same_v<std::remove_cv_t<std::ranges::range_value_t<Range>>, Type>;
+
+        if constexpr (!std::ranges::sized_range<Range>) {
+            Vector<Type, Alloc> temp;
+            for (auto&& value : range) {
+                temp.PushBack(value);
+            }
+            return this->AppendRow(std::span<const Type>(temp.Data(), temp.Size()));
+        } else if constexpr (!kSameContiguous) {
+            size_t row_size = static_cast<size_t>(std::ranges::size(range));
+            if (values_.Size() + row_size > values_.Capacity()) {
+                Vector<Type, Alloc> temp;
+                temp.Reserve(row_size);
+                for (auto&& value : range) {
+                    temp.PushBack(value);
+                }
+                return this->AppendRow(std::span<const Type>(temp.Data(), temp.Size()));
+            }
+            this->EnsureFirstOffset();
+            std::ranges::copy(range, values_.AppendUninitialized(row_size));
+        } else {
+            size_t row_size = static_cast<size_t>(std::ranges::size(range));
+            const Type* source = std::ranges::data(range);
+            const Type* old_begin = values_.Data();
+            const Type* old_end = old_begin + values_.Size();
+            bool aliased = row_size > 0 && !std::less<const Type*>()(source, old_begin) &&
+                           std::less<const Type*>()(source, old_end);
+            size_t source_pos = aliased ? static_cast<size_t>(source - old_begin) : 0;
+
+            this->EnsureFirstOffset();
+            Type* out = values_.AppendUninitialized(row_size);
+            if (aliased) {
+                source = values_.Data() + source_pos;
+            }
+            if constexpr (std::is_trivially_copyable_v<Type>) {
+                if (row_size > 0) {
+                    std::memcpy(static_cast<void*>(out), source, row_size * sizeof(Type));
+                }
+            } else {
+                std::copy(source, source + row_size, out);
+            }
+        }
+        offsets_.PushBack(values_.Size());
+        return this->Back();
+    }
+
+    Row AppendRow(std::initializer_list<Type> values) {
+        return this->AppendRow(std::span<const Type>(values.begin(), values.size()));
+    }
+
+    /* Starts an empty row, fill it with PushBack() when its size is not known yet */
+    void AppendRow() {
+        this->EnsureFirstOffset();
+        offsets_.PushBack(values_.Size());
+    }
+
+    /* Appends value to the last row */
+    void PushBack(const Type& value) {
+        assert(!this->Empty());
+        values_.PushBack(value);
+        offsets_.Back()++;
+    }
+
+    void PopRow() {
+        assert(!this->Empty());
+        offsets_.PopBack();
+        values_.Resize(offsets_.Back());
+    }
+
+    void Clear() {
+        offsets_.Clear();
+        values_.Clear();
+    }
+
+    void Swap(JaggedVector& other) {
+        offsets_.Swap(other.offsets_);
+        values_.Swap(other.values_);
+    }
+
+private:
+    void EnsureFirstOffset() {
+        if (offsets_.Empty()) {
+            offsets_.PushBack(0);
+        }
+    }
+
+private:
+    Vector<Type, Alloc> values_ = {};
+    Vector<size_t> offsets_ = {};
+};
+
+}  // namespace stdlike
+
+#endif  // STDLIKE_JAGGED_VECTOR_HPP
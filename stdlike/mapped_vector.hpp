@@ -0,0 +1,354 @@
+#ifndef STDLIKE_MAPPED_VECTOR_HPP
+#define STDLIKE_MAPPED_VECTOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+#include <cerrno>
+#include <algorithm>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <stdlike/move.hpp>
+#include <stdlike/unique_fd.hpp>
+
+namespace stdlike {
+
+enum class MapMode {
+    kReadWrite, /* created if missing */
+    kReadOnly,
+};
+
+enum class MapAdvice {
+    kNormal = MADV_NORMAL,
+    kSequential = MADV_SEQUENTIAL,
+    kRandom = MADV_RANDOM,
+    kWillNeed = MADV_WILLNEED,
+    kDontNeed = MADV_DONTNEED,
+};
+
+/*
+ * Vector stored in a memory-mapped file. The file is a small header
+ * followed by the raw elements, so reopening it is just an mmap and the
+ * page cache shares the data between processes. Growth extends the file
+ * with ftruncate and the mapping with mremap, pointers into the vector
+ * are invalidated by it just like by Vector reallocation.
+ *
+ * Modifiers of a kReadOnly vector throw std::logic_error. Element access
+ * is not checked, read a kReadOnly vector through a const reference.
+ */
+template <typename Type>
+class MappedVector {
+    static_assert(std::is_trivially_copyable_v<Type>, "MappedVector stores elements as raw bytes");
+    static_assert(alignof(Type) <= 64, "Elements start 64 bytes into the file");
+
+public:
+    explicit MappedVector(const char* path, MapMode mode = MapMode::kReadWrite) : mode_(mode) {
+        /* fd_ closes the file if the constructor throws */
+        int flags = (mode_ == MapMode::kReadWrite) ? O_RDWR | O_CREAT : O_RDONLY;
+        fd_ = detail::UniqueFd(::open(path, flags | O_CLOEXEC, 0644));
+        if (fd_.Get() < 0) {
+            ThrowErrno("open");
+        }
+
+        struct stat info = {};
+        if (::fstat(fd_.Get(), &info) != 0) {
+            ThrowErrno("fstat");
+        }
+
+        size_t file_bytes = static_cast<size_t>(info.st_size);
+        if (file_bytes == 0) {
+            if (mode_ == MapMode::kReadOnly) {
+                throw std::runtime_error("MappedVector: empty file opened read-only");
+            }
+            this->Truncate(kDataOffset);
+            file_bytes = kDataOffset;
+            this->Map(file_bytes);
+            *header_ = Header();
+        } else {
+            this->Map(file_bytes);
+            this->Validate(file_bytes);
+        }
+    }
+
+    MappedVector(const MappedVector&) = delete;
+    MappedVector& operator=(const MappedVector&) = delete;
+
+    MappedVector(MappedVector&& temp) {
+        *this = stdlike::move(temp);
+    }
+
+    MappedVector& operator=(MappedVector&& temp) {
+        std::swap(temp.mode_, mode_);
+        std::swap(temp.fd_, fd_);
+        std::swap(temp.mapping_, mapping_);
+        std::swap(temp.mapped_bytes_, mapped_bytes_);
+        std::swap(temp.header_, header_);
+        std::swap(temp.data_, data_);
+
+        return *this;
+    }
+
+    ~MappedVector() {
+        if (mapping_) {
+            ::munmap(mapping_, mapped_bytes_);
+        }
+    }
+
+    /* Capacity */
+
+    bool Empty() const {
+        return this->Size() == 0;
+    }
+
+    /* A moved-from vector is empty */
+    size_t Size() const {
+        return header_ ? header_->size : 0;
+    }
+
+    size_t Capacity() const {
+        return mapping_ ? (mapped_bytes_ - kDataOffset) / sizeof(Type) : 0;
+    }
+
+    void Reserve(size_t new_capacity) {
+        this->CheckWritable();
+        if (new_capacity > this->Capacity()) {
+            this->ChangeCapacity(new_capacity);
+        }
+    }
+
+    void ShrinkToFit() {
+        this->CheckWritable();
+        if (this->Capacity() > this->Size()) {
+            this->ChangeCapacity(this->Size());
+        }
+    }
+
+    /* Element access */
+
+    const Type& At(size_t pos) const {
+        assert(pos < this->Size());
+        return data_[pos];
+    }
+
+    Type& At(size_t pos) {
+        this->CheckWritable();
+        assert(pos < this->Size());
+        return data_[pos];
+    }
+
+    const Type& operator[](size_t pos) const {
+        return data_[pos];
+    }
+
+    Type& operator[](size_t pos) {
+        return data_[pos];
+    }
+
+    const Type& Front() const {
+        return data_[0];
+    }
+
+    Type& Front() {
+        return data_[0];
+    }
+
+    const Type& Back() const {
+        return data_[this->Size() - 1];
+    }
+
+    Type& Back() {
+        return data_[this->Size() - 1];
+    }
+
+    const Type* Data() const {
+        return data_;
+    }
+
+    Type* Data() {
+        return data_;
+    }
+
+    Type* begin() {
+        return data_;
+    }
+
+    Type* end() {
+        return data_ + this->Size();
+    }
+
+    const Type* begin() const {
+        return data_;
+    }
+
+    const Type* end() const {
+        return data_ + this->Size();
+    }
+
+    /* Modifiers */
+
+    void Clear() {
+        this->CheckWritable();
+        header_->size = 0;
+    }
+
+    void PushBack(const Type& value) {
+        this->CheckWritable();
+        size_t size = this->Size();
+        if (size >= this->Capacity()) {
+            /* value may live in the mapping that is about to move */
+            Type copy = value;
+            this->Reserve(size ? size * 2 : kMinCapacity);
+            data_[size] = copy;
+        } else {
+            data_[size] = value;
+        }
+        header_->size = size + 1;
+    }
+
+    void PopBack() {
+        this->CheckWritable();
+        if (header_->size > 0) {
+            header_->size--;
+        }
+    }
+
+    void Resize(size_t new_size, const Type& value = Type()) {
+        this->CheckWritable();
+        size_t size = this->Size();
+        if (new_size > size) {
+            Type copy = value;
+            this->Reserve(new_size);
+            std::fill(data_ + size, data_ + new_size, copy);
+        }
+        header_->size = new_size;
+    }
+
+    /* Mapping control */
+
+    /* Writes dirty pages back to the file, waits for it unless async */
+    void Flush(bool async = false) {
+        if (::msync(mapping_, mapped_bytes_, async ? MS_ASYNC : MS_SYNC) != 0) {
+            ThrowErrno("msync");
+        }
+    }
+
+    void Advise(MapAdvice advice) {
+        this->Advise(advice, 0, this->Size());
+    }
+
+    /* Advice for the elements [start, end), widened to whole pages */
+    void Advise(MapAdvice advice, size_t start, size_t end) {
+        size_t page_size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        size_t first_byte = (kDataOffset + start * sizeof(Type)) / page_size * page_size;
+        size_t last_byte = std::min(mapped_bytes_, kDataOffset + end * sizeof(Type));
+        if (first_byte < last_byte &&
+            ::madvise(static_cast<char*>(mapping_) + first_byte, last_byte - first_byte, static_cast<int>(advice))) {
+            ThrowErrno("madvise");
+        }
+    }
+
+private:
+    struct Header {
+        uint64_t magic = kMagic;
+        uint32_t version = kVersion;
+        uint32_t element_size = sizeof(Type);
+        uint64_t size = 0;
+    };
+
+    static_assert(sizeof(Header) <= 64);
+
+    bool Writable() const {
+        return mode_ == MapMode::kReadWrite;
+    }
+
+    void CheckWritable() const {
+        if (!this->Writable()) {
+            throw std::logic_error("MappedVector: modifying a read-only mapping");
+        }
+    }
+
+    void ChangeCapacity(size_t new_capacity) {
+        size_t new_bytes = kDataOffset + new_capacity * sizeof(Type);
+        this->Truncate(new_bytes);
+
+        void* new_mapping = ::mremap(mapping_, mapped_bytes_, new_bytes, MREMAP_MAYMOVE);
+        if (new_mapping == MAP_FAILED) {
+            ThrowErrno("mremap");
+        }
+
+        this->SetMapping(new_mapping, new_bytes);
+    }
+
+    void Map(size_t bytes) {
+        int prot = this->Writable() ? PROT_READ | PROT_WRITE : PROT_READ;
+        void* mapping = ::mmap(nullptr, bytes, prot, MAP_SHARED, fd_.Get(), 0);
+        if (mapping == MAP_FAILED) {
+            ThrowErrno("mmap");
+        }
+
+        this->SetMapping(mapping, bytes);
+    }
+
+    void SetMapping(void* mapping, size_t bytes) {
+        mapping_ = mapping;
+        mapped_bytes_ = bytes;
+        header_ = static_cast<Header*>(mapping);
+        data_ = reinterpret_cast<Type*>(static_cast<char*>(mapping) + kDataOffset);
+    }
+
+    void Validate(size_t file_bytes) {
+        const char* error = nullptr;
+        if (file_bytes < kDataOffset || header_->magic != kMagic) {
+            error = "MappedVector: not a vector file";
+        } else if (header_->version != kVersion) {
+            error = "MappedVector: unsupported file version";
+        } else if (header_->element_size != sizeof(Type)) {
+            error = "MappedVector: element size mismatch";
+        } else if (header_->size > this->Capacity()) {
+            error = "MappedVector: file is truncated";
+        }
+
+        if (error) {
+            ::munmap(mapping_, mapped_bytes_);
+            mapping_ = nullptr;
+            header_ = nullptr;
+            data_ = nullptr;
+            throw std::runtime_error(error);
+        }
+    }
+
+    void Truncate(size_t bytes) {
+        if (::ftruncate(fd_.Get(), static_cast<off_t>(bytes)) != 0) {
+            ThrowErrno("ftruncate");
+        }
+    }
+
+    [[noreturn]] static void ThrowErrno(const char* what) {
+        throw std::system_error(errno, std::generic_category(), what);
+    }
+
+private:
+    static constexpr uint64_t kMagic = 0x524f544345564d53;  /* "SMVECTOR" */
+    static constexpr uint32_t kVersion = 1;
+    static constexpr size_t kDataOffset = 64;
+    static constexpr size_t kMinCapacity = 64;
+
+    MapMode mode_ = MapMode::kReadWrite;
+    detail::UniqueFd fd_ = {};
+    void* mapping_ = nullptr;
+    size_t mapped_bytes_ = 0;
+    Header* header_ = nullptr;
+    Type* data_ = nullptr;
+};
+
+}  // namespace stdlike
+
+#endif  // STDLIKE_MAPPED_VECTOR_HPP
@@ -0,0 +1,276 @@
+#ifndef STDLIKE_NUMA_HPP
+#define STDLIKE_NUMA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <algorithm>
+#include <limits>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include <linux/mempolicy.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <stdlike/vector.hpp>
+
+namespace stdlike {
+
+/*
+ * kInterleave spreads pages of a buffer round-robin over all nodes,
+ * kBlock splits it into one contiguous page-aligned block per node
+ */
+enum class NumaPolicy {
+    kInterleave,
+    kBlock,
+};
+
+/* Online nodes, parsed once from sysfs, {0} on machines without NUMA */
+inline const std::vector<size_t>& NumaNodes() {
+    static const std::vector<size_t> nodes = []() {
+        std::vector<size_t> online;
+        if (FILE* file = std::fopen("/sys/devices/system/node/online", "r")) {
+            size_t first = 0;
+            size_t last = 0;
+            while (std::fscanf(file, "%zu", &first) == 1) {
+                last = first;
+                if (std::fscanf(file, "-%zu", &last) != 1) {
+                    last = first;
+                }
+                for (size_t node = first; node <= last; node++) {
+                    online.push_back(node);
+                }
+                if (std::fgetc(file) != ',') {
+                    break;
+                }
+            }
+            std::fclose(file);
+        }
+
+        if (online.empty()) {
+            online.push_back(0);
+        }
+        return online;
+    }();
+
+    return nodes;
+}
+
+inline size_t NumaNodesCount() {
+    return NumaNodes().size();
+}
+
+/* Node the calling thread is running on right now */
+inline size_t CurrentNumaNode() {
+    unsigned cpu = 0;
+    unsigned node = 0;
+    if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0) {
+        return 0;
+    }
+    return node;
+}
+
+namespace detail {
+
+inline constexpr size_t kMaxNumaNodes = 1024;
+
+inline size_t PageSize() {
+    static const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return page_size;
+}
+
+/* Memory policy is only a placement hint, failures (e.g. no NUMA support) are ignored */
+inline void BindMemory(void* addr, size_t bytes, int mode, const std::vector<size_t>& nodes) {
+    unsigned long mask[kMaxNumaNodes / 64] = {};
+    for (size_t node : nodes) {
+        mask[node / 64] |= 1ul << (node % 64);
+    }
+
+    syscall(SYS_mbind, addr, bytes, mode, mask, kMaxNumaNodes + 1, 0);
+}
+
+/* First byte of the block owned by the partition-th node, page aligned */
+inline size_t BlockOffset(size_t bytes, size_t partition) {
+    size_t pages_n = (bytes + PageSize() - 1) / PageSize();
+    size_t partitions_n = NumaNodesCount();
+    return std::min(bytes, pages_n * partition / partitions_n * PageSize());
+}
+
+}  // namespace detail
+
+/*
+ * Allocates with mmap and places the pages with mbind according to Policy.
+ * Fresh pages come zeroed and are not backed until first touched.
+ */
+template <typename Type, NumaPolicy Policy = NumaPolicy::kInterleave>
+class NumaAllocator {
+public:
+    using value_type = Type;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+
+    using pointer = Type*;
+    using const_pointer = const Type*;
+    using reference = Type&;
+    using const_reference = const Type&;
+
+    template <typename Other>
+    struct rebind {
+        using other = NumaAllocator<Other, Policy>;
+    };
+
+    NumaAllocator() {
+    }
+
+    NumaAllocator([[maybe_unused]] const NumaAllocator& other) {
+    }
+
+    template <typename Other>
+    NumaAllocator([[maybe_unused]] const NumaAllocator<Other, Policy>& other) {
+    }
+
+    ~NumaAllocator() {
+    }
+
+    [[nodiscard]] pointer Allocate(size_type elems_n) {
+        if (elems_n == 0) {
+            return nullptr;
+        }
+
+        if (elems_n > MaxSize()) {
+            throw std::bad_alloc();
+        }
+
+        size_t bytes = elems_n * sizeof(value_type);
+        void* addr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (addr == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+
+        const std::vector<size_t>& nodes = NumaNodes();
+        if constexpr (Policy == NumaPolicy::kInterleave) {
+            detail::BindMemory(addr, bytes, MPOL_INTERLEAVE, nodes);
+        } else {
+            for (size_t partition = 0; partition < nodes.size(); partition++) {
+                size_t begin = detail::BlockOffset(bytes, partition);
+                size_t end = detail::BlockOffset(bytes, partition + 1);
+                if (begin < end) {
+                    detail::BindMemory(static_cast<char*>(addr) + begin, end - begin, MPOL_PREFERRED,
+                                       {nodes[partition]});
+                }
+            }
+        }
+
+        return static_cast<pointer>(addr);
+    }
+
+    /* Anonymous mappings are zeroed already */
+    [[nodiscard]] pointer AllocateZeroed(size_type elems_n) {
+        return Allocate(elems_n);
+    }
+
+    void Deallocate(pointer ptr, size_type elems_n) {
+        if (ptr) {
+            munmap(ptr, elems_n * sizeof(value_type));
+        }
+    }
+
+    size_type MaxSize() const {
+        return std::numeric_limits<size_type>::max() / sizeof(value_type);
+    }
+
+    template <class Other, class... Args>
+    void Construct(Other* ptr, Args&&... args) {
+        ::new (static_cast<void*>(ptr)) Other(std::forward<Args>(args)...);
+    }
+
+    template <class Other>
+    void Destroy(Other* ptr) {
+        ptr->~Other();
+    }
+
+    friend bool operator==(const NumaAllocator&, const NumaAllocator&) {
+        return true;
+    }
+
+    /* Compatability */
+
+    [[nodiscard]] pointer allocate(size_type elems_n) {
+        return Allocate(elems_n);
+    }
+
+    void deallocate(pointer ptr, size_type elems_n) {
+        Deallocate(ptr, elems_n);
+    }
+
+    size_type max_size() const {
+        return MaxSize();
+    }
+
+    template <class Other, class... Args>
+    void construct(Other* ptr, Args&&... args) {
+        Construct(ptr, std::forward<Args>(args)...);
+    }
+
+    template <class Other>
+    void destroy(Other* ptr) {
+        Destroy(ptr);
+    }
+};
+
+/* Index range [begin, end) of a PartitionedVector whose pages live on node */
+struct NumaPartition {
+    size_t node = 0;
+    size_t begin = 0;
+    size_t end = 0;
+};
+
+/*
+ * Vector whose buffer is split into one block per NUMA node. Parallel
+ * loops can ask which indices are local to a node and schedule them on
+ * threads running there, see CurrentNumaNode().
+ */
+template <typename Type>
+class PartitionedVector : public Vector<Type, NumaAllocator<Type, NumaPolicy::kBlock>> {
+public:
+    using Base = Vector<Type, NumaAllocator<Type, NumaPolicy::kBlock>>;
+    using Base::Base;
+
+    size_t PartitionsCount() const {
+        return NumaNodesCount();
+    }
+
+    /* Partitions follow the current buffer, they change when it is reallocated */
+    NumaPartition Partition(size_t partition) const {
+        size_t bytes = this->Capacity() * sizeof(Type);
+        size_t begin = (detail::BlockOffset(bytes, partition) + sizeof(Type) - 1) / sizeof(Type);
+        size_t end = (detail::BlockOffset(bytes, partition + 1) + sizeof(Type) - 1) / sizeof(Type);
+
+        return NumaPartition{NumaNodes()[partition], std::min(begin, this->Size()), std::min(end, this->Size())};
+    }
+
+    std::vector<NumaPartition> Partitions() const {
+        std::vector<NumaPartition> partitions;
+        for (size_t partition = 0; partition < PartitionsCount(); partition++) {
+            partitions.push_back(Partition(partition));
+        }
+        return partitions;
+    }
+
+    /* Range local to node, empty if the node holds no part of the buffer */
+    NumaPartition LocalRange(size_t node) const {
+        for (size_t partition = 0; partition < PartitionsCount(); partition++) {
+            if (NumaNodes()[partition] == node) {
+                return Partition(partition);
+            }
+        }
+        return NumaPartition{node, 0, 0};
+    }
+};
+
+}  // namespace stdlike
+
+#endif  // STDLIKE_NUMA_HPP
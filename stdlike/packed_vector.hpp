@@ -0,0 +1,460 @@
+#ifndef STDLIKE_PACKED_VECTOR_HPP
+#define STDLIKE_PACKED_VECTOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+#include <compare>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include <stdlike/allocator.hpp>
+#include <stdlike/vector.hpp>
+
+namespace stdlike {
+
+/*
+ * Vector of kBits-bit unsigned integers (1 <= kBits <= 64) stored back to
+ * back in 64-bit words, a value may span two words. Value pos occupies
+ * bits [pos * kBits, (pos + 1) * kBits) counted from the LSB of the first
+ * word. Bits past the last value are always zero, so equal vectors have
+ * equal words. Elements are accessed through Reference proxies, like
+ * Vector<bool> bits.
+ *
+ * Pack/Unpack convert whole blocks of 64 values, which fill exactly kBits
+ * words. The block loops are unrolled at compile time for the given width,
+ * so the shifts and masks are constants and the compiler vectorizes them.
+ */
+template <size_t kBits, class Alloc = Allocator<uint64_t>>
+class PackedVector {
+    static_assert(kBits >= 1 && kBits <= 64, "PackedVector stores 1 to 64 bit values");
+
+public:
+    static constexpr uint64_t kMask = kBits == 64 ? ~uint64_t(0) : (uint64_t(1) << kBits) - 1;
+
+    class Reference {
+    public:
+        Reference(PackedVector* source, size_t pos) : source_(source), pos_(pos) {
+        }
+
+        Reference(const Reference& other) = default;
+
+        Reference& operator=(uint64_t value) {
+            source_->Set(pos_, value);
+            return *this;
+        }
+
+        Reference& operator=(const Reference& other) {
+            return *this = uint64_t(other);
+        }
+
+        operator uint64_t() const {
+            return source_->Get(pos_);
+        }
+
+        friend void swap(Reference lhs, Reference rhs) {
+            uint64_t temp = lhs;
+            lhs = rhs;
+            rhs = temp;
+        }
+
+    private:
+        PackedVector* source_ = nullptr;
+        size_t pos_ = 0;
+    };
+
+    /* Iterator and ConstIterator: the vector and a position in it */
+
+    template <bool kConst>
+    class PackedIterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using difference_type = ptrdiff_t;
+        using value_type = uint64_t;
+        using pointer = void;
+        using reference = std::conditional_t<kConst, uint64_t, Reference>;
+
+        using Owner = std::conditional_t<kConst, const PackedVector, PackedVector>;
+
+        PackedIterator() = default;
+
+        PackedIterator(Owner* container, size_t pos) : container_(container), pos_(pos) {
+        }
+
+        /* Iterator -> ConstIterator */
+        template <bool kOtherConst>
+            requires(kConst && !kOtherConst)
+        PackedIterator(const PackedIterator<kOtherConst>& other) : container_(other.container_), pos_(other.pos_) {
+        }
+
+        reference operator*() const {
+            if constexpr (kConst) {
+                return container_->Get(pos_);
+            } else {
+                return reference(container_, pos_);
+            }
+        }
+
+        reference operator[](difference_type diff) const {
+            return *(*this + diff);
+        }
+
+        PackedIterator& operator++() {
+            pos_++;
+            return *this;
+        }
+
+        PackedIterator operator++(int) {
+            PackedIterator old = *this;
+            pos_++;
+            return old;
+        }
+
+        PackedIterator& operator--() {
+            pos_--;
+            return *this;
+        }
+
+        PackedIterator operator--(int) {
+            PackedIterator old = *this;
+            pos_--;
+            return old;
+        }
+
+        PackedIterator& operator+=(difference_type diff) {
+            pos_ = static_cast<size_t>(static_cast<difference_type>(pos_) + diff);
+            return *this;
+        }
+
+        PackedIterator& operator-=(difference_type diff) {
+            return *this += -diff;
+        }
+
+        friend PackedIterator operator+(PackedIterator iter, difference_type diff) {
+            return iter += diff;
+        }
+
+        friend PackedIterator operator+(difference_type diff, PackedIterator iter) {
+            return iter += diff;
+        }
+
+        friend PackedIterator operator-(PackedIterator iter, difference_type diff) {
+            return iter -= diff;
+        }
+
+        friend difference_type operator-(const PackedIterator& lhs, const PackedIterator& rhs) {
+            return static_cast<difference_type>(lhs.pos_) - static_cast<difference_type>(rhs.pos_);
+        }
+
+        friend bool operator==(const PackedIterator& lhs, const PackedIterator& rhs) {
+            return lhs.pos_ == rhs.pos_;
+        }
+
+        friend std::strong_ordering operator<=>(const PackedIterator& lhs, const PackedIterator& rhs) {
+            return lhs.pos_ <=> rhs.pos_;
+        }
+
+    private:
+        template <bool>
+        friend class PackedIterator;
+
+        Owner* container_ = nullptr;
+        size_t pos_ = 0;
+    };
+
+    using Iterator = PackedIterator<false>;
+    using ConstIterator = PackedIterator<true>;
+
+    /* PackedVector<kBits> */
+
+    PackedVector() = default;
+
+    explicit PackedVector(size_t init_size, uint64_t value = 0) {
+        this->Resize(init_size, value);
+    }
+
+    PackedVector(const PackedVector& other) = default;
+    PackedVector(PackedVector&& temp) noexcept : words_(std::move(temp.words_)), size_(std::exchange(temp.size_, 0)) {
+    }
+
+    PackedVector& operator=(const PackedVector& other) = default;
+    PackedVector& operator=(PackedVector&& temp) noexcept {
+        words_ = std::move(temp.words_);
+        size_ = std::exchange(temp.size_, 0);
+        return *this;
+    }
+
+    ~PackedVector() = default;
+
+    /* Iterators */
+
+    Iterator Begin() {
+        return Iterator(this, 0);
+    }
+
+    Iterator End() {
+        return Iterator(this, size_);
+    }
+
+    ConstIterator Begin() const {
+        return ConstIterator(this, 0);
+    }
+
+    ConstIterator End() const {
+        return ConstIterator(this, size_);
+    }
+
+    Iterator begin() {
+        return Begin();
+    }
+
+    Iterator end() {
+        return End();
+    }
+
+    ConstIterator begin() const {
+        return Begin();
+    }
+
+    ConstIterator end() const {
+        return End();
+    }
+
+    /* Capacity */
+
+    bool Empty() const {
+        return size_ == 0;
+    }
+
+    size_t Size() const {
+        return size_;
+    }
+
+    size_t Capacity() const {
+        return words_.Capacity() * 64 / kBits;
+    }
+
+    void Reserve(size_t new_capacity) {
+        words_.Reserve(WordsFor(new_capacity));
+    }
+
+    void ShrinkToFit() {
+        words_.ShrinkToFit();
+    }
+
+    /* Element access */
+
+    uint64_t Get(size_t pos) const {
+        assert(pos < size_);
+        size_t bit = pos * kBits;
+        size_t word = bit / 64;
+        size_t offset = bit % 64;
+
+        uint64_t value = words_[word] >> offset;
+        if (offset + kBits > 64) {
+            value |= words_[word + 1] << (64 - offset);
+        }
+        return value & kMask;
+    }
+
+    void Set(size_t pos, uint64_t value) {
+        assert(pos < size_);
+        assert(value <= kMask);
+        size_t bit = pos * kBits;
+        size_t word = bit / 64;
+        size_t offset = bit % 64;
+
+        value &= kMask;
+        words_[word] = (words_[word] & ~(kMask << offset)) | (value << offset);
+        if (offset + kBits > 64) {
+            words_[word + 1] = (words_[word + 1] & ~(kMask >> (64 - offset))) | (value >> (64 - offset));
+        }
+    }
+
+    uint64_t At(size_t pos) const {
+        return this->Get(pos);
+    }
+
+    uint64_t operator[](size_t pos) const {
+        return this->Get(pos);
+    }
+
+    Reference operator[](size_t pos) {
+        return Reference(this, pos);
+    }
+
+    uint64_t Front() const {
+        return this->Get(0);
+    }
+
+    uint64_t Back() const {
+        return this->Get(size_ - 1);
+    }
+
+    /* The packed words, WordsFor(Size()) of them */
+
+    const uint64_t* Data() const {
+        return words_.Data();
+    }
+
+    static constexpr size_t WordsFor(size_t size) {
+        return (size * kBits + 63) / 64;
+    }
+
+    /* Modifiers */
+
+    void Clear() {
+        words_.Clear();
+        size_ = 0;
+    }
+
+    /* Bits past the end are zero, so a value only needs to be or-ed in, and takes at most one new word */
+    void PushBack(uint64_t value) {
+        assert(value <= kMask);
+        if (WordsFor(size_ + 1) > words_.Size()) {
+            words_.PushBack(0);
+        }
+
+        size_t bit = size_ * kBits;
+        size_t word = bit / 64;
+        size_t offset = bit % 64;
+
+        value &= kMask;
+        words_[word] |= value << offset;
+        if (offset + kBits > 64) {
+            words_[word + 1] |= value >> (64 - offset);
+        }
+        size_++;
+    }
+
+    void PopBack() {
+        assert(size_ > 0);
+        this->Set(size_ - 1, 0);
+        size_--;
+        words_.Resize(WordsFor(size_));
+    }
+
+    void Resize(size_t new_size, uint64_t value = 0) {
+        assert(value <= kMask);
+        if (new_size <= size_) {
+            words_.Resize(WordsFor(new_size));
+            size_ = new_size;
+            this->ClearTail();
+            return;
+        }
+
+        words_.Resize(WordsFor(new_size), 0);
+        size_t old_size = std::exchange(size_, new_size);
+        if (value != 0) {
+            for (size_t pos = old_size; pos < new_size; pos++) {
+                this->Set(pos, value);
+            }
+        }
+    }
+
+    /* Bulk conversion, values must fit into kBits bits */
+
+    template <typename Word, class WordAlloc>
+    void Pack(const Vector<Word, WordAlloc>& values) {
+        static_assert(std::is_same_v<Word, uint32_t> || std::is_same_v<Word, uint64_t>, "Packs uint32_t or uint64_t");
+        static_assert(kBits <= 8 * sizeof(Word), "Values are wider than the source words");
+
+        size_t blocks_n = values.Size() / 64;
+        words_.ResizeForOverwrite(WordsFor(values.Size()));
+        size_ = values.Size();
+
+        const Word* src = values.Data();
+        uint64_t* dest = words_.Data();
+        for (size_t block = 0; block < blocks_n; block++) {
+            PackBlock(src + block * 64, dest + block * kBits, std::make_index_sequence<64>());
+        }
+
+        for (size_t word = blocks_n * kBits; word < words_.Size(); word++) {
+            dest[word] = 0;
+        }
+        for (size_t pos = blocks_n * 64; pos < size_; pos++) {
+            this->Set(pos, src[pos]);
+        }
+    }
+
+    template <typename Word, class WordAlloc>
+    void Unpack(Vector<Word, WordAlloc>& values) const {
+        static_assert(std::is_same_v<Word, uint32_t> || std::is_same_v<Word, uint64_t>,
+                      "Unpacks to uint32_t or uint64_t");
+        static_assert(kBits <= 8 * sizeof(Word), "Values are wider than the destination words");
+
+        size_t blocks_n = size_ / 64;
+        values.ResizeForOverwrite(size_);
+
+        const uint64_t* src = words_.Data();
+        Word* dest = values.Data();
+        for (size_t block = 0; block < blocks_n; block++) {
+            UnpackBlock(src + block * kBits, dest + block * 64, std::make_index_sequence<64>());
+        }
+
+        for (size_t pos = blocks_n * 64; pos < size_; pos++) {
+            dest[pos] = static_cast<Word>(this->Get(pos));
+        }
+    }
+
+    /* Comparison */
+
+    friend bool operator==(const PackedVector& lhs, const PackedVector& rhs) {
+        return lhs.size_ == rhs.size_ && lhs.words_ == rhs.words_;
+    }
+
+private:
+    /* After shrinking, the last word may still hold bits of removed values */
+    void ClearTail() {
+        size_t used = (size_ * kBits) % 64;
+        if (used != 0) {
+            words_.Back() &= (uint64_t(1) << used) - 1;
+        }
+    }
+
+    template <typename Word, size_t... kPos>
+    static void PackBlock(const Word* src, uint64_t* dest, std::index_sequence<kPos...>) {
+        for (size_t word = 0; word < kBits; word++) {
+            dest[word] = 0;
+        }
+        (PackValue<kPos>(src, dest), ...);
+    }
+
+    template <size_t kPos, typename Word>
+    static void PackValue(const Word* src, uint64_t* dest) {
+        constexpr size_t kWord = kPos * kBits / 64;
+        constexpr size_t kOffset = kPos * kBits % 64;
+
+        uint64_t value = static_cast<uint64_t>(src[kPos]) & kMask;
+        dest[kWord] |= value << kOffset;
+        if constexpr (kOffset + kBits > 64) {
+            dest[kWord + 1] |= value >> (64 - kOffset);
+        }
+    }
+
+    template <typename Word, size_t... kPos>
+    static void UnpackBlock(const uint64_t* src, Word* dest, std::index_sequence<kPos...>) {
+        ((dest[kPos] = static_cast<Word>(UnpackValue<kPos>(src))), ...);
+    }
+
+    template <size_t kPos>
+    static uint64_t UnpackValue(const uint64_t* src) {
+        constexpr size_t kWord = kPos * kBits / 64;
+        constexpr size_t kOffset = kPos * kBits % 64;
+
+        uint64_t value = src[kWord] >> kOffset;
+        if constexpr (kOffset + kBits > 64) {
+            value |= src[kWord + 1] << (64 - kOffset);
+        }
+        return value & kMask;
+    }
+
+private:
+    Vector<uint64_t, Alloc> words_ = {};
+    size_t size_ = 0;
+};
+
+}  // namespace stdlike
+
+#endif  // STDLIKE_PACKED_VECTOR_HPP
@@ -0,0 +1,350 @@
+#ifndef STDLIKE_SERIALIZE_HPP
+#define STDLIKE_SERIALIZE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cerrno>
+#include <cstring>
+#include <bit>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <stdlike/hash.hpp>
+#include <stdlike/vector.hpp>
+
+namespace stdlike {
+
+/*
+ * Binary vector format, version 1:
+ *
+ *   64-byte BinaryHeader, then the payload: raw elements for Vector<Type>,
+ *   ceil(size / 32) uint32_t words for Vector<bool> (bits past size are 0),
+ *   kLsbFirst is set for BitVector<BitOrder::kLsbFirst> words. kStream
+ *   marks the chunked streams of stream.hpp, Read and BinaryView reject it.
+ *
+ * Data is stored in the writer's byte order, readers reject foreign order.
+ * The checksum is Hash64 of the payload. For bit vectors it is chained over
+ * the full words and then the last word, Hash64(last, 4, Hash64(full, ...)),
+ * so the writer can mask the tail without copying the buffer.
+ */
+
+struct BinaryHeader {
+    static constexpr uint32_t kMagic = 0x43455653;  /* "SVEC" */
+    static constexpr uint16_t kVersion = 1;
+
+    static constexpr uint16_t kBigEndian = 1u << 0;
+    static constexpr uint16_t kBitVector = 1u << 1;
+    static constexpr uint16_t kLsbFirst = 1u << 2;
+    static constexpr uint16_t kStream = 1u << 3;
+
+    uint32_t magic = kMagic;
+    uint16_t version = kVersion;
+    uint16_t flags = 0;
+    uint32_t element_size = 0;
+    uint32_t reserved = 0;
+    uint64_t size = 0; /* elements, bits for bit vectors */
+    uint64_t payload_bytes = 0;
+    uint64_t checksum = 0;
+    uint8_t padding[24] = {};
+};
+
+static_assert(sizeof(BinaryHeader) == 64);
+
+namespace detail {
+
+inline constexpr uint16_t kNativeOrderFlag = (std::endian::native == std::endian::big) ? BinaryHeader::kBigEndian : 0;
+
+template <typename Type>
+concept BinarySerializable = std::is_trivially_copyable_v<Type> && !std::is_same_v<Type, bool>;
+
+inline void WriteAll(int fd, iovec* iov, int iov_n) {
+    while (iov_n > 0) {
+        ssize_t written = ::writev(fd, iov, iov_n);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::system_error(errno, std::generic_category(), "writev");
+        }
+
+        size_t left = static_cast<size_t>(written);
+        while (iov_n > 0 && left >= iov->iov_len) {
+            left -= iov->iov_len;
+            iov++;
+            iov_n--;
+        }
+
+        if (iov_n > 0) {
+            iov->iov_base = static_cast<char*>(iov->iov_base) + left;
+            iov->iov_len -= left;
+        }
+    }
+}
+
+/* Thrown by ReadAll when its stop_fd becomes readable */
+struct ReadStopped {};
+
+/*
+ * With stop_fd >= 0 the reads wait in poll() on both descriptors, so
+ * another thread can interrupt a read blocked on a pipe or a socket by
+ * making stop_fd readable
+ */
+inline void ReadAll(int fd, void* buffer, size_t bytes_n, int stop_fd = -1) {
+    char* dest = static_cast<char*>(buffer);
+    while (bytes_n > 0) {
+        if (stop_fd >= 0) {
+            pollfd fds[2] = {{fd, POLLIN, 0}, {stop_fd, POLLIN, 0}};
+            if (::poll(fds, 2, -1) < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw std::system_error(errno, std::generic_category(), "poll");
+            }
+
+            if (fds[1].revents != 0) {
+                throw ReadStopped();
+            }
+        }
+
+        ssize_t got = ::read(fd, dest, bytes_n);
+        if (got < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::system_error(errno, std::generic_category(), "read");
+        }
+
+        if (got == 0) {
+            throw std::runtime_error("stdlike::Read: unexpected end of stream");
+        }
+
+        dest += got;
+        bytes_n -= static_cast<size_t>(got);
+    }
+}
+
+/* kind holds the kBitVector, kLsbFirst and kStream flags the reader expects */
+inline void CheckHeader(const BinaryHeader& header, uint16_t kind, size_t element_size) {
+    bool bits = (kind & BinaryHeader::kBitVector) != 0;
+    const char* error = nullptr;
+    if (header.magic != BinaryHeader::kMagic) {
+        error = "stdlike::Read: not a binary vector";
+    } else if (header.version != BinaryHeader::kVersion) {
+        error = "stdlike::Read: unsupported format version";
+    } else if ((header.flags & BinaryHeader::kBigEndian) != kNativeOrderFlag) {
+        error = "stdlike::Read: foreign byte order";
+    } else if ((header.flags & BinaryHeader::kBitVector) != (kind & BinaryHeader::kBitVector) ||
+               header.element_size != element_size) {
+        error = "stdlike::Read: element type mismatch";
+    } else if ((header.flags & BinaryHeader::kLsbFirst) != (kind & BinaryHeader::kLsbFirst)) {
+        error = "stdlike::Read: foreign bit order";
+    } else if ((header.flags & BinaryHeader::kStream) != (kind & BinaryHeader::kStream)) {
+        error = (kind & BinaryHeader::kStream) ? "stdlike::Read: not a vector stream"
+                                               : "stdlike::Read: a vector stream, read it with VectorReader";
+    } else if (bits ? header.size > SIZE_MAX - 31 : header.size > SIZE_MAX / element_size) {
+        error = "stdlike::Read: corrupted header"; /* the payload size would overflow */
+    } else if (header.payload_bytes != (bits ? (header.size + 31) / 32 * 4 : header.size * element_size)) {
+        error = "stdlike::Read: corrupted header";
+    }
+
+    if (error) {
+        throw std::runtime_error(error);
+    }
+}
+
+template <BitOrder kOrder>
+inline constexpr uint16_t kBitVectorFlags =
+    static_cast<uint16_t>(BinaryHeader::kBitVector | (kOrder == BitOrder::kLsbFirst ? BinaryHeader::kLsbFirst : 0));
+
+inline uint64_t BitPayloadChecksum(const uint32_t* words, size_t words_n, uint32_t last_word) {
+    uint64_t full_hash = Hash64(words, (words_n - 1) * sizeof(uint32_t));
+    return Hash64(&last_word, sizeof(last_word), full_hash);
+}
+
+}  // namespace detail
+
+/* Vector<Type> */
+
+template <detail::BinarySerializable Type, class Alloc>
+void Write(int fd, const Vector<Type, Alloc>& vec) {
+    BinaryHeader header;
+    header.flags = detail::kNativeOrderFlag;
+    header.element_size = sizeof(Type);
+    header.size = vec.Size();
+    header.payload_bytes = vec.Size() * sizeof(Type);
+    header.checksum = Hash64(vec.Data(), header.payload_bytes);
+
+    iovec iov[2] = {{&header, sizeof(header)},
+                    {const_cast<Type*>(vec.Data()), header.payload_bytes}};
+    detail::WriteAll(fd, iov, vec.Empty() ? 1 : 2);
+}
+
+template <detail::BinarySerializable Type, class Alloc>
+void Read(int fd, Vector<Type, Alloc>& vec, bool verify = true) {
+    BinaryHeader header;
+    detail::ReadAll(fd, &header, sizeof(header));
+    detail::CheckHeader(header, 0, sizeof(Type));
+
+    vec.Clear();
+    vec.ResizeForOverwrite(header.size);
+    detail::ReadAll(fd, vec.Data(), header.payload_bytes);
+
+    if (verify && Hash64(vec.Data(), header.payload_bytes) != header.checksum) {
+        throw std::runtime_error("stdlike::Read: checksum mismatch");
+    }
+}
+
+/* Vector<bool>, the word buffer is written as is except for the masked tail */
+
+template <class Alloc>
+    requires detail::BitVectorAllocator<Alloc>
+void Write(int fd, const Vector<bool, Alloc>& vec) {
+    constexpr BitOrder kOrder = Vector<bool, Alloc>::kBitOrder;
+    size_t words_n = (vec.Size() + 31) / 32;
+    const uint32_t* words = vec.Data();
+
+    BinaryHeader header;
+    header.flags = detail::kNativeOrderFlag | detail::kBitVectorFlags<kOrder>;
+    header.element_size = sizeof(uint32_t);
+    header.size = vec.Size();
+    header.payload_bytes = words_n * sizeof(uint32_t);
+
+    if (words_n == 0) {
+        iovec iov[1] = {{&header, sizeof(header)}};
+        return detail::WriteAll(fd, iov, 1);
+    }
+
+    uint32_t tail_bits = static_cast<uint32_t>(vec.Size() - (words_n - 1) * 32);
+    uint32_t last_word = words[words_n - 1] & detail::BitRangeMask<kOrder>(0, tail_bits);
+    header.checksum = detail::BitPayloadChecksum(words, words_n, last_word);
+
+    iovec iov[3] = {{&header, sizeof(header)},
+                    {const_cast<uint32_t*>(words), (words_n - 1) * sizeof(uint32_t)},
+                    {&last_word, sizeof(last_word)}};
+    detail::WriteAll(fd, iov, 3);
+}
+
+template <class Alloc>
+    requires detail::BitVectorAllocator<Alloc>
+void Read(int fd, Vector<bool, Alloc>& vec, bool verify = true) {
+    BinaryHeader header;
+    detail::ReadAll(fd, &header, sizeof(header));
+    detail::CheckHeader(header, detail::kBitVectorFlags<Vector<bool, Alloc>::kBitOrder>, sizeof(uint32_t));
+
+    vec.Clear();
+    vec.ResizeForOverwrite(header.size);
+    detail::ReadAll(fd, vec.Data(), header.payload_bytes);
+
+    size_t words_n = header.payload_bytes / sizeof(uint32_t);
+    if (verify && words_n > 0 &&
+        detail::BitPayloadChecksum(vec.Data(), words_n, vec.Data()[words_n - 1]) != header.checksum) {
+        throw std::runtime_error("stdlike::Read: checksum mismatch");
+    }
+}
+
+/* File helpers */
+
+template <typename VectorType>
+void WriteFile(const char* path, const VectorType& vec) {
+    int fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        throw std::system_error(errno, std::generic_category(), "open");
+    }
+
+    try {
+        Write(fd, vec);
+    } catch (...) {
+        ::close(fd);
+        throw;
+    }
+    ::close(fd);
+}
+
+template <typename VectorType>
+void ReadFile(const char* path, VectorType& vec, bool verify = true) {
+    int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::system_error(errno, std::generic_category(), "open");
+    }
+
+    try {
+        Read(fd, vec, verify);
+    } catch (...) {
+        ::close(fd);
+        throw;
+    }
+    ::close(fd);
+}
+
+/*
+ * Read-only view of a serialized Vector<Type> inside a memory buffer,
+ * e.g. a mapped file. The payload is used in place, the buffer must
+ * outlive the view and be aligned for Type.
+ */
+template <detail::BinarySerializable Type>
+class BinaryView {
+public:
+    BinaryView(const void* buffer, size_t bytes_n, bool verify = true) {
+        if (bytes_n < sizeof(BinaryHeader)) {
+            throw std::runtime_error("stdlike::BinaryView: buffer is too short");
+        }
+
+        BinaryHeader header;
+        std::memcpy(&header, buffer, sizeof(header));
+        detail::CheckHeader(header, 0, sizeof(Type));
+
+        const char* payload = static_cast<const char*>(buffer) + sizeof(BinaryHeader);
+        if (header.payload_bytes > bytes_n - sizeof(BinaryHeader)) {
+            throw std::runtime_error("stdlike::BinaryView: payload is truncated");
+        }
+
+        if (reinterpret_cast<uintptr_t>(payload) % alignof(Type) != 0) {
+            throw std::runtime_error("stdlike::BinaryView: misaligned payload");
+        }
+
+        if (verify && Hash64(payload, header.payload_bytes) != header.checksum) {
+            throw std::runtime_error("stdlike::BinaryView: checksum mismatch");
+        }
+
+        data_ = reinterpret_cast<const Type*>(payload);
+        size_ = header.size;
+    }
+
+    bool Empty() const {
+        return size_ == 0;
+    }
+
+    size_t Size() const {
+        return size_;
+    }
+
+    const Type& operator[](size_t pos) const {
+        return data_[pos];
+    }
+
+    const Type* Data() const {
+        return data_;
+    }
+
+    const Type* begin() const {
+        return data_;
+    }
+
+    const Type* end() const {
+        return data_ + size_;
+    }
+
+private:
+    const Type* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+}  // namespace stdlike
+
+#endif  // STDLIKE_SERIALIZE_HPP
@@ -0,0 +1,656 @@
+#ifndef STDLIKE_SIMD_HPP
+#define STDLIKE_SIMD_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <bit>
+#include <functional>
+#include <limits>
+#include <type_traits>
+
+#include <stdlike/vector.hpp>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#include <immintrin.h>
+#define STDLIKE_SIMD_X86 1
+#else
+#define STDLIKE_SIMD_X86 0
+#endif
+
+/* GCC 12 warns about the _mm512_undefined_*() placeholders of inlined intrinsics */
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+namespace stdlike {
+
+/*
+ * Search and reduction kernels for Vector<int32_t/int64_t/float/double>.
+ * Every kernel has AVX-512, AVX2 and scalar versions. The widest one the
+ * CPU supports is picked at run time, STDLIKE_SIMD=scalar|avx2|avx512 in
+ * the environment caps the choice.
+ *
+ * Floating point: Find and Count compare with ==, so NaN is never found
+ * and -0.0 matches 0.0. MinMax and ArgMax skip NaNs. Sum adds floats in
+ * double precision, and the vector versions add in a different order than
+ * the scalar one.
+ */
+
+template <typename Type>
+concept SimdElement = std::is_same_v<Type, int32_t> || std::is_same_v<Type, int64_t> ||
+                      std::is_same_v<Type, float> || std::is_same_v<Type, double>;
+
+template <SimdElement Type>
+using SumType = std::conditional_t<std::is_integral_v<Type>, int64_t, double>;
+
+/* An empty range gives {max, lowest}, for floats {+inf, -inf} */
+template <SimdElement Type>
+struct MinMaxResult {
+    Type min;
+    Type max;
+};
+
+enum class SimdLevel {
+    kScalar,
+    kAvx2,
+    kAvx512,
+};
+
+namespace detail {
+
+/* Identity elements of min and max */
+template <typename Type>
+constexpr Type MinIdentity() {
+    if constexpr (std::is_floating_point_v<Type>) {
+        return std::numeric_limits<Type>::infinity();
+    } else {
+        return std::numeric_limits<Type>::max();
+    }
+}
+
+template <typename Type>
+constexpr Type MaxIdentity() {
+    if constexpr (std::is_floating_point_v<Type>) {
+        return -std::numeric_limits<Type>::infinity();
+    } else {
+        return std::numeric_limits<Type>::lowest();
+    }
+}
+
+/* Portable versions, also the tails of the vector ones */
+
+namespace scalar {
+
+template <typename Type>
+size_t Find(const Type* data, size_t size, std::type_identity_t<Type> value) {
+    for (size_t pos = 0; pos < size; pos++) {
+        if (std::equal_to<Type>()(data[pos], value)) {
+            return pos;
+        }
+    }
+    return size;
+}
+
+template <typename Type>
+size_t Count(const Type* data, size_t size, std::type_identity_t<Type> value) {
+    size_t count = 0;
+    for (size_t pos = 0; pos < size; pos++) {
+        count += std::equal_to<Type>()(data[pos], value);
+    }
+    return count;
+}
+
+/* Comparisons with NaN are false, so NaNs never replace a bound */
+template <typename Type>
+MinMaxResult<Type> MinMax(const Type* data, size_t size, MinMaxResult<Type> result) {
+    for (size_t pos = 0; pos < size; pos++) {
+        if (data[pos] < result.min) {
+            result.min = data[pos];
+        }
+        if (data[pos] > result.max) {
+            result.max = data[pos];
+        }
+    }
+    return result;
+}
+
+template <typename Type>
+SumType<Type> Sum(const Type* data, size_t size) {
+    SumType<Type> sum = 0;
+    for (size_t pos = 0; pos < size; pos++) {
+        sum += static_cast<SumType<Type>>(data[pos]);
+    }
+    return sum;
+}
+
+}  // namespace scalar
+
+#if STDLIKE_SIMD_X86
+
+/*
+ * AVX2: 256-bit registers. Min/Max pass the loaded value first, vminps and
+ * vmaxps return the second operand when either is NaN, so the accumulator
+ * keeps its value.
+ */
+
+namespace avx2 {
+
+/* Register types by specialization, vector types lose their attributes as template arguments */
+template <typename Type>
+struct Registers {
+    using Reg = __m256i;
+    using SumReg = __m256i;
+};
+
+template <>
+struct Registers<float> {
+    using Reg = __m256;
+    using SumReg = __m256d;
+};
+
+template <>
+struct Registers<double> {
+    using Reg = __m256d;
+    using SumReg = __m256d;
+};
+
+template <typename Type>
+using Reg = typename Registers<Type>::Reg;
+
+/* Sums are accumulated in four 64-bit lanes */
+template <typename Type>
+using SumReg = typename Registers<Type>::SumReg;
+
+template <typename Type>
+inline constexpr size_t kLanes = 32 / sizeof(Type);
+
+template <typename Type>
+[[gnu::target("avx2")]] inline Reg<Type> Load(const Type* ptr) {
+    if constexpr (std::is_same_v<Type, float>) {
+        return _mm256_loadu_ps(ptr);
+    } else if constexpr (std::is_same_v<Type, double>) {
+        return _mm256_loadu_pd(ptr);
+    } else {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+    }
+}
+
+template <typename Type>
+[[gnu::target("avx2")]] inline void Store(Type* ptr, Reg<Type> reg) {
+    if constexpr (std::is_same_v<Type, float>) {
+        _mm256_storeu_ps(ptr, reg);
+    } else if constexpr (std::is_same_v<Type, double>) {
+        _mm256_storeu_pd(ptr, reg);
+    } else {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(ptr), reg);
+    }
+}
+
+template <typename Type>
+[[gnu::target("avx2")]] inline Reg<Type> Broadcast(Type value) {
+    if constexpr (std::is_same_v<Type, float>) {
+        return _mm256_set1_ps(value);
+    } else if constexpr (std::is_same_v<Type, double>) {
+        return _mm256_set1_pd(value);
+    } else if constexpr (std::is_same_v<Type, int32_t>) {
+        return _mm256_set1_epi32(value);
+    } else {
+        return _mm256_set1_epi64x(value);
+    }
+}
+
+/* One bit per lane, set where the lanes are equal */
+template <typename Type>
+[[gnu::target("avx2")]] inline uint32_t EqualMask(Reg<Type> lhs, Reg<Type> rhs) {
+    int mask = 0;
+    if constexpr (std::is_same_v<Type, float>) {
+        mask = _mm256_movemask_ps(_mm256_cmp_ps(lhs, rhs, _CMP_EQ_OQ));
+    } else if constexpr (std::is_same_v<Type, double>) {
+        mask = _mm256_movemask_pd(_mm256_cmp_pd(lhs, rhs, _CMP_EQ_OQ));
+    } else if constexpr (std::is_same_v<Type, int32_t>) {
+        mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(lhs, rhs)));
+    } else {
+        mask = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(lhs, rhs)));
+    }
+    return static_cast<uint32_t>(mask);
+}
+
+template <typename Type>
+[[gnu::target("avx2")]] inline Reg<Type> Min(Reg<Type> value, Reg<Type> acc) {
+    if constexpr (std::is_same_v<Type, float>) {
+        return _mm256_min_ps(value, acc);
+    } else if constexpr (std::is_same_v<Type, double>) {
+        return _mm256_min_pd(value, acc);
+    } else if constexpr (std::is_same_v<Type, int32_t>) {
+        return _mm256_min_epi32(value, acc);
+    } else {
+        return _mm256_blendv_epi8(value, acc, _mm256_cmpgt_epi64(value, acc));
+    }
+}
+
+template <typename Type>
+[[gnu::target("avx2")]] inline Reg<Type> Max(Reg<Type> value, Reg<Type> acc) {
+    if constexpr (std::is_same_v<Type, float>) {
+        return _mm256_max_ps(value, acc);
+    } else if constexpr (std::is_same_v<Type, double>) {
+        return _mm256_max_pd(value, acc);
+    } else if constexpr (std::is_same_v<Type, int32_t>) {
+        return _mm256_max_epi32(value, acc);
+    } else {
+        return _mm256_blendv_epi8(value, acc, _mm256_cmpgt_epi64(acc, value));
+    }
+}
+
+/* Adds the next four elements, widened to 64 bits */
+template <typename Type>
+[[gnu::target("avx2")]] inline SumReg<Type> AddFour(SumReg<Type> acc, const Type* ptr) {
+    if constexpr (std::is_same_v<Type, float>) {
+        return _mm256_add_pd(acc, _mm256_cvtps_pd(_mm_loadu_ps(ptr)));
+    } else if constexpr (std::is_same_v<Type, double>) {
+        return _mm256_add_pd(acc, _mm256_loadu_pd(ptr));
+    } else if constexpr (std::is_same_v<Type, int32_t>) {
+        return _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr))));
+    } else {
+        return _mm256_add_epi64(acc, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr)));
+    }
+}
+
+template <typename Type>
+[[gnu::target("avx2")]] size_t Find(const Type* data, size_t size, std::type_identity_t<Type> value) {
+    Reg<Type> needle = Broadcast(value);
+    size_t pos = 0;
+    for (; pos + kLanes<Type> <= size; pos += kLanes<Type>) {
+        uint32_t mask = EqualMask<Type>(Load(data + pos), needle);
+        if (mask != 0) {
+            return pos + static_cast<size_t>(std::countr_zero(mask));
+        }
+    }
+
+    return pos + scalar::Find(data + pos, size - pos, value);
+}
+
+template <typename Type>
+[[gnu::target("avx2")]] size_t Count(const Type* data, size_t size, std::type_identity_t<Type> value) {
+    Reg<Type> needle = Broadcast(value);
+    size_t count = 0;
+    size_t pos = 0;
+    for (; pos + kLanes<Type> <= size; pos += kLanes<Type>) {
+        count += static_cast<size_t>(std::popcount(EqualMask<Type>(Load(data + pos), needle)));
+    }
+
+    return count + scalar::Count(data + pos, size - pos, value);
+}
+
+template <typename Type>
+[[gnu::target("avx2")]] MinMaxResult<Type> MinMax(const Type* data, size_t size) {
+    Reg<Type> min = Broadcast(MinIdentity<Type>());
+    Reg<Type> max = Broadcast(MaxIdentity<Type>());
+    size_t pos = 0;
+    for (; pos + kLanes<Type> <= size; pos += kLanes<Type>) {
+        Reg<Type> value = Load(data + pos);
+        min = Min<Type>(value, min);
+        max = Max<Type>(value, max);
+    }
+
+    Type min_lanes[kLanes<Type>];
+    Type max_lanes[kLanes<Type>];
+    Store(min_lanes, min);
+    Store(max_lanes, max);
+
+    MinMaxResult<Type> result = {min_lanes[0], max_lanes[0]};
+    for (size_t lane = 1; lane < kLanes<Type>; lane++) {
+        result.min = std::min(result.min, min_lanes[lane]);
+        result.max = std::max(result.max, max_lanes[lane]);
+    }
+    return scalar::MinMax(data + pos, size - pos, result);
+}
+
+template <typename Type>
+[[gnu::target("avx2")]] SumType<Type> Sum(const Type* data, size_t size) {
+    SumReg<Type> first = {};
+    SumReg<Type> second = {};
+    size_t pos = 0;
+    for (; pos + 8 <= size; pos += 8) {
+        first = AddFour(first, data + pos);
+        second = AddFour(second, data + pos + 4);
+    }
+
+    SumType<Type> lanes[4];
+    if constexpr (std::is_integral_v<Type>) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), _mm256_add_epi64(first, second));
+    } else {
+        _mm256_storeu_pd(lanes, _mm256_add_pd(first, second));
+    }
+
+    return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]) + scalar::Sum(data + pos, size - pos);
+}
+
+}  // namespace avx2
+
+/* AVX-512F: the same kernels on 512-bit registers, compares produce masks directly */
+
+namespace avx512 {
+
+/* Register types by specialization, vector types lose their attributes as template arguments */
+template <typename Type>
+struct Registers {
+    using Reg = __m512i;
+    using SumReg = __m512i;
+};
+
+template <>
+struct Registers<float> {
+    using Reg = __m512;
+    using SumReg = __m512d;
+};
+
+template <>
+struct Registers<double> {
+    using Reg = __m512d;
+    using SumReg = __m512d;
+};
+
+template <typename Type>
+using Reg = typename Registers<Type>::Reg;
+
+/* Sums are accumulated in eight 64-bit lanes */
+template <typename Type>
+using SumReg = typename Registers<Type>::SumReg;
+
+template <typename Type>
+inline constexpr size_t kLanes = 64 / sizeof(Type);
+
+template <typename Type>
+[[gnu::target("avx512f")]] inline Reg<Type> Load(const Type* ptr) {
+    if constexpr (std::is_same_v<Type, float>) {
+        return _mm512_loadu_ps(ptr);
+    } else if constexpr (std::is_same_v<Type, double>) {
+        return _mm512_loadu_pd(ptr);
+    } else {
+        return _mm512_loadu_si512(ptr);
+    }
+}
+
+template <typename Type>
+[[gnu::target("avx512f")]] inline void Store(Type* ptr, Reg<Type> reg) {
+    if constexpr (std::is_same_v<Type, float>) {
+        _mm512_storeu_ps(ptr, reg);
+    } else if constexpr (std::is_same_v<Type, double>) {
+        _mm512_storeu_pd(ptr, reg);
+    } else {
+        _mm512_storeu_si512(ptr, reg);
+    }
+}
+
+template <typename Type>
+[[gnu::target("avx512f")]] inline Reg<Type> Broadcast(Type value) {
+    if constexpr (std::is_same_v<Type, float>) {
+        return _mm512_set1_ps(value);
+    } else if constexpr (std::is_same_v<Type, double>) {
+        return _mm512_set1_pd(value);
+    } else if constexpr (std::is_same_v<Type, int32_t>) {
+        return _mm512_set1_epi32(value);
+    } else {
+        return _mm512_set1_epi64(value);
+    }
+}
+
+template <typename Type>
+[[gnu::target("avx512f")]] inline uint32_t EqualMask(Reg<Type> lhs, Reg<Type> rhs) {
+    if constexpr (std::is_same_v<Type, float>) {
+        return _mm512_cmp_ps_mask(lhs, rhs, _CMP_EQ_OQ);
+    } else if constexpr (std::is_same_v<Type, double>) {
+        return _mm512_cmp_pd_mask(lhs, rhs, _CMP_EQ_OQ);
+    } else if constexpr (std::is_same_v<Type, int32_t>) {
+        return _mm512_cmpeq_epi32_mask(lhs, rhs);
+    } else {
+        return _mm512_cmpeq_epi64_mask(lhs, rhs);
+    }
+}
+
+template <typename Type>
+[[gnu::target("avx512f")]] inline Reg<Type> Min(Reg<Type> value, Reg<Type> acc) {
+    if constexpr (std::is_same_v<Type, float>) {
+        return _mm512_min_ps(value, acc);
+    } else if constexpr (std::is_same_v<Type, double>) {
+        return _mm512_min_pd(value, acc);
+    } else if constexpr (std::is_same_v<Type, int32_t>) {
+        return _mm512_min_epi32(value, acc);
+    } else {
+        return _mm512_min_epi64(value, acc);
+    }
+}
+
+template <typename Type>
+[[gnu::target("avx512f")]] inline Reg<Type> Max(Reg<Type> value, Reg<Type> acc) {
+    if constexpr (std::is_same_v<Type, float>) {
+        return _mm512_max_ps(value, acc);
+    } else if constexpr (std::is_same_v<Type, double>) {
+        return _mm512_max_pd(value, acc);
+    } else if constexpr (std::is_same_v<Type, int32_t>) {
+        return _mm512_max_epi32(value, acc);
+    } else {
+        return _mm512_max_epi64(value, acc);
+    }
+}
+
+/* Adds the next eight elements, widened to 64 bits */
+template <typename Type>
+[[gnu::target("avx512f")]] inline SumReg<Type> AddEight(SumReg<Type> acc, const Type* ptr) {
+    if constexpr (std::is_same_v<Type, float>) {
+        return _mm512_add_pd(acc, _mm512_cvtps_pd(_mm256_loadu_ps(ptr)));
+    } else if constexpr (std::is_same_v<Type, double>) {
+        return _mm512_add_pd(acc, _mm512_loadu_pd(ptr));
+    } else if constexpr (std::is_same_v<Type, int32_t>) {
+        return _mm512_add_epi64(acc, _mm512_cvtepi32_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr))));
+    } else {
+        return _mm512_add_epi64(acc, _mm512_loadu_si512(ptr));
+    }
+}
+
+template <typename Type>
+[[gnu::target("avx512f")]] size_t Find(const Type* data, size_t size, std::type_identity_t<Type> value) {
+    Reg<Type> needle = Broadcast(value);
+    size_t pos = 0;
+    for (; pos + kLanes<Type> <= size; pos += kLanes<Type>) {
+        uint32_t mask = EqualMask<Type>(Load(data + pos), needle);
+        if (mask != 0) {
+            return pos + static_cast<size_t>(std::countr_zero(mask));
+        }
+    }
+
+    return pos + scalar::Find(data + pos, size - pos, value);
+}
+
+template <typename Type>
+[[gnu::target("avx512f")]] size_t Count(const Type* data, size_t size, std::type_identity_t<Type> value) {
+    Reg<Type> needle = Broadcast(value);
+    size_t count = 0;
+    size_t pos = 0;
+    for (; pos + kLanes<Type> <= size; pos += kLanes<Type>) {
+        count += static_cast<size_t>(std::popcount(EqualMask<Type>(Load(data + pos), needle)));
+    }
+
+    return count + scalar::Count(data + pos, size - pos, value);
+}
+
+template <typename Type>
+[[gnu::target("avx512f")]] MinMaxResult<Type> MinMax(const Type* data, size_t size) {
+    Reg<Type> min = Broadcast(MinIdentity<Type>());
+    Reg<Type> max = Broadcast(MaxIdentity<Type>());
+    size_t pos = 0;
+    for (; pos + kLanes<Type> <= size; pos += kLanes<Type>) {
+        Reg<Type> value = Load(data + pos);
+        min = Min<Type>(value, min);
+        max = Max<Type>(value, max);
+    }
+
+    Type min_lanes[kLanes<Type>];
+    Type max_lanes[kLanes<Type>];
+    Store(min_lanes, min);
+    Store(max_lanes, max);
+
+    MinMaxResult<Type> result = {min_lanes[0], max_lanes[0]};
+    for (size_t lane = 1; lane < kLanes<Type>; lane++) {
+        result.min = std::min(result.min, min_lanes[lane]);
+        result.max = std::max(result.max, max_lanes[lane]);
+    }
+    return scalar::MinMax(data + pos, size - pos, result);
+}
+
+template <typename Type>
+[[gnu::target("avx512f")]] SumType<Type> Sum(const Type* data, size_t size) {
+    SumReg<Type> first = {};
+    SumReg<Type> second = {};
+    size_t pos = 0;
+    for (; pos + 16 <= size; pos += 16) {
+        first = AddEight(first, data + pos);
+        second = AddEight(second, data + pos + 8);
+    }
+
+    SumType<Type> lanes[8];
+    if constexpr (std::is_integral_v<Type>) {
+        _mm512_storeu_si512(lanes, _mm512_add_epi64(first, second));
+    } else {
+        _mm512_storeu_pd(lanes, _mm512_add_pd(first, second));
+    }
+
+    SumType<Type> sum = 0;
+    for (SumType<Type> lane : lanes) {
+        sum += lane;
+    }
+    return sum + scalar::Sum(data + pos, size - pos);
+}
+
+}  // namespace avx512
+
+#endif  // STDLIKE_SIMD_X86
+
+}  // namespace detail
+
+/* Widest level supported by the CPU, capped by STDLIKE_SIMD, detected once */
+inline SimdLevel ActiveSimdLevel() {
+    static const SimdLevel level = []() {
+        SimdLevel supported = SimdLevel::kScalar;
+#if STDLIKE_SIMD_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) {
+            supported = SimdLevel::kAvx512;
+        } else if (__builtin_cpu_supports("avx2")) {
+            supported = SimdLevel::kAvx2;
+        }
+#endif
+        SimdLevel cap = SimdLevel::kAvx512;
+        if (const char* env = std::getenv("STDLIKE_SIMD")) {
+            if (std::strcmp(env, "scalar") == 0) {
+                cap = SimdLevel::kScalar;
+            } else if (std::strcmp(env, "avx2") == 0) {
+                cap = SimdLevel::kAvx2;
+            }
+        }
+        return std::min(supported, cap);
+    }();
+
+    return level;
+}
+
+/* Returns the result of the active level's kernel, falls through for the scalar one */
+
+#if STDLIKE_SIMD_X86
+#define STDLIKE_SIMD_DISPATCH(kernel, ...)                  \
+    switch (ActiveSimdLevel()) {                            \
+        case SimdLevel::kAvx512:                            \
+            return detail::avx512::kernel(__VA_ARGS__);     \
+        case SimdLevel::kAvx2:                              \
+            return detail::avx2::kernel(__VA_ARGS__);       \
+        case SimdLevel::kScalar:                            \
+        default:                                            \
+            break;                                          \
+    }
+#else
+#define STDLIKE_SIMD_DISPATCH(kernel, ...)
+#endif
+
+/* Pointer ranges */
+
+template <SimdElement Type>
+const Type* Find(const Type* first, const Type* last, std::type_identity_t<Type> value) {
+    auto find = [value](const Type* data, size_t size) -> size_t {
+        STDLIKE_SIMD_DISPATCH(Find, data, size, value)
+        return detail::scalar::Find(data, size, value);
+    };
+    return first + find(first, static_cast<size_t>(last - first));
+}
+
+template <SimdElement Type>
+size_t Count(const Type* first, const Type* last, std::type_identity_t<Type> value) {
+    size_t size = static_cast<size_t>(last - first);
+    STDLIKE_SIMD_DISPATCH(Count, first, size, value)
+    return detail::scalar::Count(first, size, value);
+}
+
+template <SimdElement Type>
+MinMaxResult<Type> MinMax(const Type* first, const Type* last) {
+    size_t size = static_cast<size_t>(last - first);
+    STDLIKE_SIMD_DISPATCH(MinMax, first, size)
+    return detail::scalar::MinMax(first, size, {detail::MinIdentity<Type>(), detail::MaxIdentity<Type>()});
+}
+
+template <SimdElement Type>
+SumType<Type> Sum(const Type* first, const Type* last) {
+    size_t size = static_cast<size_t>(last - first);
+    STDLIKE_SIMD_DISPATCH(Sum, first, size)
+    return detail::scalar::Sum(first, size);
+}
+
+/* First maximum, last if the range is empty or all NaN */
+template <SimdElement Type>
+const Type* ArgMax(const Type* first, const Type* last) {
+    return Find(first, last, MinMax(first, last).max);
+}
+
+#undef STDLIKE_SIMD_DISPATCH
+
+/* Vector overloads, positions are indices and Size() means not found */
+
+template <SimdElement Type, class Alloc>
+size_t Find(const Vector<Type, Alloc>& vec, std::type_identity_t<Type> value) {
+    return static_cast<size_t>(Find(vec.Data(), vec.Data() + vec.Size(), value) - vec.Data());
+}
+
+template <SimdElement Type, class Alloc>
+bool Contains(const Vector<Type, Alloc>& vec, std::type_identity_t<Type> value) {
+    return Find(vec, value) != vec.Size();
+}
+
+template <SimdElement Type, class Alloc>
+size_t Count(const Vector<Type, Alloc>& vec, std::type_identity_t<Type> value) {
+    return Count(vec.Data(), vec.Data() + vec.Size(), value);
+}
+
+template <SimdElement Type, class Alloc>
+MinMaxResult<Type> MinMax(const Vector<Type, Alloc>& vec) {
+    return MinMax(vec.Data(), vec.Data() + vec.Size());
+}
+
+template <SimdElement Type, class Alloc>
+SumType<Type> Sum(const Vector<Type, Alloc>& vec) {
+    return Sum(vec.Data(), vec.Data() + vec.Size());
+}
+
+template <SimdElement Type, class Alloc>
+size_t ArgMax(const Vector<Type, Alloc>& vec) {
+    return static_cast<size_t>(ArgMax(vec.Data(), vec.Data() + vec.Size()) - vec.Data());
+}
+
+}  // namespace stdlike
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+#endif  // STDLIKE_SIMD_HPP
@@ -0,0 +1,356 @@
+#ifndef STDLIKE_STREAM_HPP
+#define STDLIKE_STREAM_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cerrno>
+#include <cstring>
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+
+#include <sys/eventfd.h>
+#include <sys/uio.h>
+
+#include <stdlike/serialize.hpp>
+#include <stdlike/unique_fd.hpp>
+#include <stdlike/vector.hpp>
+
+namespace stdlike {
+
+/*
+ * Chunked vector stream over a file descriptor or a pipe:
+ *
+ *   BinaryHeader with the kStream flag, then frames of
+ *   [uint64_t elements_n][elements_n raw elements], a frame with
+ *   elements_n == 0 ends the stream.
+ *
+ * Both ends use two chunk buffers and a background I/O thread, so the
+ * caller fills (or consumes) one chunk while the other is written (or
+ * read ahead). Memory use is two chunks whatever the stream length.
+ *
+ * Destroying a VectorReader wakes its I/O thread through an eventfd, so
+ * it does not wait for a writer that has stalled or is gone.
+ */
+
+inline constexpr size_t kDefaultStreamChunk = 1 << 16;
+
+template <detail::BinarySerializable Type>
+class VectorWriter {
+public:
+    explicit VectorWriter(int fd, size_t chunk_size = kDefaultStreamChunk)
+        : fd_(fd), front_(chunk_size), back_(chunk_size), io_thread_() {
+
+        assert(chunk_size > 0);
+        BinaryHeader header;
+        header.flags = detail::kNativeOrderFlag | BinaryHeader::kStream;
+        header.element_size = sizeof(Type);
+
+        iovec iov[1] = {{&header, sizeof(header)}};
+        detail::WriteAll(fd_, iov, 1);
+
+        io_thread_ = std::thread([this]() {
+            this->IoLoop();
+        });
+    }
+
+    VectorWriter(const VectorWriter&) = delete;
+    VectorWriter& operator=(const VectorWriter&) = delete;
+
+    /* Errors can only be seen by calling Close() explicitly */
+    ~VectorWriter() {
+        try {
+            this->Close();
+        } catch (...) {
+        }
+    }
+
+    void Write(const Type* data, size_t elems_n) {
+        this->CheckOpen();
+        while (elems_n > 0) {
+            size_t taken = std::min(elems_n, front_.Size() - front_used_);
+            std::memcpy(front_.Data() + front_used_, data, taken * sizeof(Type));
+            front_used_ += taken;
+            data += taken;
+            elems_n -= taken;
+
+            if (front_used_ == front_.Size()) {
+                this->SubmitFront();
+            }
+        }
+    }
+
+    template <class Alloc>
+    void Write(const Vector<Type, Alloc>& vec) {
+        this->Write(vec.Data(), vec.Size());
+    }
+
+    void PushBack(const Type& value) {
+        this->Write(&value, 1);
+    }
+
+    /* Sends the partial chunk and waits until everything is written */
+    void Flush() {
+        this->CheckOpen();
+        if (front_used_ > 0) {
+            this->SubmitFront();
+        }
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        this->WaitIdle(lock);
+    }
+
+    /*
+     * Flushes, ends the stream and stops the I/O thread, the fd stays open.
+     * Write, PushBack and Flush throw std::logic_error afterwards.
+     */
+    void Close() {
+        if (!io_thread_.joinable()) {
+            return;
+        }
+
+        std::exception_ptr error = nullptr;
+        try {
+            this->Flush();
+            uint64_t terminator = 0;
+            iovec iov[1] = {{&terminator, sizeof(terminator)}};
+            detail::WriteAll(fd_, iov, 1);
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            stop_ = true;
+        }
+        cond_.notify_all();
+        io_thread_.join();
+
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+private:
+    void CheckOpen() const {
+        if (!io_thread_.joinable()) {
+            throw std::logic_error("stdlike::VectorWriter: the stream is closed");
+        }
+    }
+
+    void SubmitFront() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        this->WaitIdle(lock);
+
+        front_.Swap(back_);
+        back_used_ = front_used_;
+        front_used_ = 0;
+        busy_ = true;
+        cond_.notify_all();
+    }
+
+    void WaitIdle(std::unique_lock<std::mutex>& lock) {
+        cond_.wait(lock, [this]() {
+            return !busy_;
+        });
+
+        if (error_) {
+            std::exception_ptr error = error_;
+            error_ = nullptr;
+            std::rethrow_exception(error);
+        }
+    }
+
+    void IoLoop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            cond_.wait(lock, [this]() {
+                return busy_ || stop_;
+            });
+
+            if (!busy_) {
+                return;
+            }
+
+            /* back_ belongs to this thread until busy_ is reset */
+            lock.unlock();
+            try {
+                uint64_t elems_n = back_used_;
+                iovec iov[2] = {{&elems_n, sizeof(elems_n)}, {back_.Data(), back_used_ * sizeof(Type)}};
+                detail::WriteAll(fd_, iov, 2);
+            } catch (...) {
+                lock.lock();
+                error_ = std::current_exception();
+                lock.unlock();
+            }
+            lock.lock();
+
+            busy_ = false;
+            cond_.notify_all();
+        }
+    }
+
+private:
+    int fd_ = -1;
+
+    Vector<Type> front_;
+    size_t front_used_ = 0;
+    Vector<Type> back_;
+    size_t back_used_ = 0;
+
+    std::thread io_thread_;
+    std::mutex mutex_ = {};
+    std::condition_variable cond_ = {};
+    bool busy_ = false;
+    bool stop_ = false;
+    std::exception_ptr error_ = nullptr;
+};
+
+template <detail::BinarySerializable Type>
+class VectorReader {
+public:
+    /* Frames longer than max_chunk are rejected, this bounds the memory use */
+    explicit VectorReader(int fd, size_t max_chunk = kDefaultStreamChunk)
+        : fd_(fd), max_chunk_(max_chunk), back_(), io_thread_() {
+
+        BinaryHeader header;
+        detail::ReadAll(fd_, &header, sizeof(header));
+        detail::CheckHeader(header, BinaryHeader::kStream, sizeof(Type));
+
+        stop_fd_ = detail::UniqueFd(::eventfd(0, EFD_CLOEXEC));
+        if (stop_fd_.Get() < 0) {
+            throw std::system_error(errno, std::generic_category(), "eventfd");
+        }
+
+        /* Start reading ahead right away */
+        requested_ = true;
+        io_thread_ = std::thread([this]() {
+            this->IoLoop();
+        });
+    }
+
+    VectorReader(const VectorReader&) = delete;
+    VectorReader& operator=(const VectorReader&) = delete;
+
+    ~VectorReader() {
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            stop_ = true;
+        }
+        cond_.notify_all();
+
+        /* Interrupts a read that waits for data */
+        uint64_t one = 1;
+        [[maybe_unused]] ssize_t written = ::write(stop_fd_.Get(), &one, sizeof(one));
+        io_thread_.join();
+    }
+
+    /*
+     * Replaces chunk with the next frame, false at the end of the stream.
+     * The previous contents of chunk are reused as the read-ahead buffer.
+     */
+    template <class Alloc>
+    bool Next(Vector<Type, Alloc>& chunk) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cond_.wait(lock, [this]() {
+            return !requested_;
+        });
+
+        if (error_) {
+            std::rethrow_exception(error_);
+        }
+
+        if (ended_) {
+            return false;
+        }
+
+        if constexpr (std::is_same_v<Vector<Type, Alloc>, Vector<Type>>) {
+            chunk.Swap(back_);
+        } else {
+            chunk.ResizeForOverwrite(back_.Size());
+            std::memcpy(chunk.Data(), back_.Data(), back_.Size() * sizeof(Type));
+        }
+
+        requested_ = true;
+        cond_.notify_all();
+        return true;
+    }
+
+    /* Appends the rest of the stream to out */
+    template <class Alloc>
+    size_t ReadAll(Vector<Type, Alloc>& out) {
+        size_t read_n = 0;
+        Vector<Type> chunk;
+        while (this->Next(chunk)) {
+            std::memcpy(out.AppendUninitialized(chunk.Size()), chunk.Data(), chunk.Size() * sizeof(Type));
+            read_n += chunk.Size();
+        }
+
+        return read_n;
+    }
+
+private:
+    void IoLoop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            cond_.wait(lock, [this]() {
+                return requested_ || stop_;
+            });
+
+            if (stop_) {
+                return;
+            }
+
+            /* back_ belongs to this thread until requested_ is reset */
+            lock.unlock();
+            bool ended = false;
+            std::exception_ptr error = nullptr;
+            try {
+                uint64_t elems_n = 0;
+                detail::ReadAll(fd_, &elems_n, sizeof(elems_n), stop_fd_.Get());
+                if (elems_n > max_chunk_) {
+                    throw std::runtime_error("stdlike::VectorReader: frame exceeds max_chunk");
+                }
+
+                ended = (elems_n == 0);
+                back_.ResizeForOverwrite(elems_n);
+                detail::ReadAll(fd_, back_.Data(), elems_n * sizeof(Type), stop_fd_.Get());
+            } catch (...) {
+                error = std::current_exception();
+            }
+            lock.lock();
+
+            ended_ = ended;
+            error_ = error;
+            requested_ = false;
+            cond_.notify_all();
+
+            if (ended_ || error_) {
+                return;
+            }
+        }
+    }
+
+private:
+    int fd_ = -1;
+    detail::UniqueFd stop_fd_ = {};
+    size_t max_chunk_ = 0;
+
+    Vector<Type> back_;
+
+    std::thread io_thread_;
+    std::mutex mutex_ = {};
+    std::condition_variable cond_ = {};
+    bool requested_ = false;
+    bool ended_ = false;
+    bool stop_ = false;
+    std::exception_ptr error_ = nullptr;
+};
+
+}  // namespace stdlike
+
+#endif  // STDLIKE_STREAM_HPP
@@ -0,0 +1,502 @@
+#ifndef STDLIKE_THREAD_POOL_HPP
+#define STDLIKE_THREAD_POOL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <stdlike/move.hpp>
+
+namespace stdlike {
+
+/*
+ * Chase-Lev work-stealing deque (Le et al., "Correct and Efficient
+ * Work-Stealing for Weak Memory Models"). The owner pushes and pops at the
+ * bottom, thieves steal from the top. Grown buffers are retired, not freed,
+ * until the deque dies because a thief may still be reading them.
+ */
+template <typename Type>
+class WorkStealingDeque {
+public:
+    explicit WorkStealingDeque(size_t capacity = 256) : buffer_(new Buffer(capacity)) {
+        retired_.emplace_back(buffer_.load(std::memory_order_relaxed));
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    ~WorkStealingDeque() {
+    }
+
+    /* Owner only */
+    void Push(Type* item) {
+        int64_t bottom = bottom_.load(std::memory_order_relaxed);
+        int64_t top = top_.load(std::memory_order_acquire);
+        Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+
+        if (bottom - top > static_cast<int64_t>(buffer->capacity) - 1) {
+            buffer = this->Grow(buffer, top, bottom);
+        }
+
+        buffer->Put(bottom, item);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+    }
+
+    /* Owner only */
+    Type* Pop() {
+        int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+        Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+        bottom_.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t top = top_.load(std::memory_order_relaxed);
+
+        if (top > bottom) {
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        Type* item = buffer->Get(bottom);
+        if (top == bottom) {
+            /* Last item, race against thieves for it */
+            if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                item = nullptr;
+            }
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+        }
+
+        return item;
+    }
+
+    /* Any thread */
+    Type* Steal() {
+        int64_t top = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t bottom = bottom_.load(std::memory_order_acquire);
+
+        if (top >= bottom) {
+            return nullptr;
+        }
+
+        Buffer* buffer = buffer_.load(std::memory_order_acquire);
+        Type* item = buffer->Get(top);
+        if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return nullptr;
+        }
+
+        return item;
+    }
+
+    bool Empty() const {
+        return top_.load(std::memory_order_relaxed) >= bottom_.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Buffer {
+        explicit Buffer(size_t init_capacity)
+            : capacity(init_capacity), mask(init_capacity - 1), slots(new std::atomic<Type*>[init_capacity]) {
+        }
+
+        Type* Get(int64_t pos) const {
+            return slots[static_cast<size_t>(pos) & mask].load(std::memory_order_relaxed);
+        }
+
+        void Put(int64_t pos, Type* item) {
+            slots[static_cast<size_t>(pos) & mask].store(item, std::memory_order_relaxed);
+        }
+
+        size_t capacity = 0; /* always a power of two */
+        size_t mask = 0;
+        std::unique_ptr<std::atomic<Type*>[]> slots;
+    };
+
+    Buffer* Grow(Buffer* old_buffer, int64_t top, int64_t bottom) {
+        Buffer* new_buffer = new Buffer(old_buffer->capacity * 2);
+        for (int64_t pos = top; pos < bottom; pos++) {
+            new_buffer->Put(pos, old_buffer->Get(pos));
+        }
+
+        retired_.emplace_back(new_buffer);
+        buffer_.store(new_buffer, std::memory_order_release);
+        return new_buffer;
+    }
+
+private:
+    alignas(64) std::atomic<int64_t> top_ = 0;
+    alignas(64) std::atomic<int64_t> bottom_ = 0;
+    std::atomic<Buffer*> buffer_ = nullptr;
+    std::vector<std::unique_ptr<Buffer>> retired_ = {};
+};
+
+/*
+ * Fork-join pool with one work-stealing deque per worker. Tasks spawned
+ * by a worker go to its own deque, tasks from other threads go through a
+ * shared injection queue. Threads waiting in Join() run pending tasks
+ * instead of blocking, so a pool may have no workers at all. Tasks still
+ * queued when the pool is destroyed are run before the destructor returns.
+ */
+class ThreadPool {
+private:
+    class Task;
+
+public:
+    /* Counts unfinished tasks, keeps the first exception thrown by them */
+    class TaskGroup {
+    public:
+        TaskGroup() {
+        }
+
+        TaskGroup(const TaskGroup&) = delete;
+        TaskGroup& operator=(const TaskGroup&) = delete;
+
+        ~TaskGroup() {
+        }
+
+        bool Done() const {
+            return pending_.load(std::memory_order_acquire) == 0;
+        }
+
+    private:
+        friend class ThreadPool;
+
+        void Fail(std::exception_ptr error) {
+            if (!failed_.exchange(true, std::memory_order_acq_rel)) {
+                error_ = error;
+            }
+        }
+
+    private:
+        std::atomic<size_t> pending_ = 0;
+        std::atomic<bool> failed_ = false;
+        std::exception_ptr error_ = nullptr;
+    };
+
+public:
+    explicit ThreadPool(size_t threads_n = std::thread::hardware_concurrency(), bool pin_threads = false)
+        : deques_(), workers_() {
+
+        for (size_t index = 0; index < threads_n; index++) {
+            deques_.emplace_back(new WorkStealingDeque<Task>());
+        }
+
+        std::vector<size_t> cpus = pin_threads ? AllowedCpus() : std::vector<size_t>();
+        for (size_t index = 0; index < threads_n; index++) {
+            workers_.emplace_back([this, index]() {
+                this->WorkerLoop(index);
+            });
+
+            if (!cpus.empty()) {
+                PinThread(workers_.back(), cpus[index % cpus.size()]);
+            }
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /* Workers leave once the queues are empty, whatever they left behind runs here */
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> guard(sleep_mutex_);
+            stop_ = true;
+        }
+        sleep_cond_.notify_all();
+
+        for (std::thread& worker : workers_) {
+            worker.join();
+        }
+
+        while (Task* task = this->FindTask(this->ThreadsCount())) {
+            this->Run(task);
+        }
+    }
+
+    /*
+     * Default pool shared by the parallel algorithms. STDLIKE_NUM_THREADS
+     * (default: the number of hardware threads) counts the thread calling
+     * into the pool too, it takes part in every Join(), so the pool starts
+     * one worker less. Pinning is taken from STDLIKE_PIN_THREADS.
+     */
+    static ThreadPool& Default() {
+        static ThreadPool pool(DefaultWorkersCount(), std::getenv("STDLIKE_PIN_THREADS") != nullptr);
+        return pool;
+    }
+
+    size_t ThreadsCount() const {
+        return workers_.size();
+    }
+
+    /* Index of the calling worker of this pool or ThreadsCount() for outside threads */
+    size_t CurrentWorker() const {
+        return current_pool_ == this ? current_index_ : ThreadsCount();
+    }
+
+    template <typename Func>
+    void Spawn(TaskGroup& group, Func func) {
+        group.pending_.fetch_add(1, std::memory_order_relaxed);
+        Task* task = new FuncTask<Func>(&group, stdlike::move(func));
+
+        if (current_pool_ == this) {
+            deques_[current_index_]->Push(task);
+        } else {
+            std::lock_guard<std::mutex> guard(injection_mutex_);
+            injection_.push_back(task);
+            injected_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        this->Wake();
+    }
+
+    /* Runs tasks until the whole group is done, rethrows its first exception */
+    void Join(TaskGroup& group) {
+        size_t self = this->CurrentWorker();
+        while (!group.Done()) {
+            if (Task* task = this->FindTask(self)) {
+                this->Run(task);
+            } else {
+                std::this_thread::yield();
+            }
+        }
+
+        if (group.failed_.load(std::memory_order_acquire)) {
+            std::exception_ptr error = group.error_;
+            group.error_ = nullptr;
+            group.failed_.store(false, std::memory_order_relaxed);
+            std::rethrow_exception(error);
+        }
+    }
+
+    /*
+     * Calls func(chunk_begin, chunk_end) over [begin, end), splitting the
+     * range in halves until chunks are at most grain long. Halves are
+     * spawned so idle workers can steal big pieces first.
+     */
+    template <typename Func>
+    void ParallelFor(size_t begin, size_t end, size_t grain, Func func) {
+        if (begin >= end) {
+            return;
+        }
+
+        grain = grain ? grain : 1;
+        if (end - begin <= grain) {
+            func(begin, end);
+            return;
+        }
+
+        TaskGroup group;
+        try {
+            this->SplitRange(group, begin, end, grain, func);
+        } catch (...) {
+            group.Fail(std::current_exception());
+        }
+
+        this->Join(group);
+    }
+
+private:
+    class Task {
+    public:
+        explicit Task(TaskGroup* group) : group_(group) {
+        }
+
+        Task(const Task&) = delete;
+        Task& operator=(const Task&) = delete;
+
+        virtual ~Task() {
+        }
+
+        virtual void Execute() = 0;
+
+        TaskGroup* Group() const {
+            return group_;
+        }
+
+    private:
+        TaskGroup* group_ = nullptr;
+    };
+
+    template <typename Func>
+    class FuncTask final : public Task {
+    public:
+        FuncTask(TaskGroup* group, Func&& func) : Task(group), func_(stdlike::move(func)) {
+        }
+
+        void Execute() override {
+            func_();
+        }
+
+    private:
+        Func func_;
+    };
+
+    template <typename Func>
+    void SplitRange(TaskGroup& group, size_t begin, size_t end, size_t grain, Func& func) {
+        while (end - begin > grain) {
+            size_t middle = begin + (end - begin) / 2;
+            this->Spawn(group, [this, &group, &func, middle, end, grain]() {
+                this->SplitRange(group, middle, end, grain, func);
+            });
+            end = middle;
+        }
+
+        func(begin, end);
+    }
+
+    void Run(Task* task) {
+        TaskGroup* group = task->Group();
+        try {
+            task->Execute();
+        } catch (...) {
+            group->Fail(std::current_exception());
+        }
+
+        delete task;
+        group->pending_.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    Task* FindTask(size_t self) {
+        Task* task = nullptr;
+        if (self < deques_.size()) {
+            task = deques_[self]->Pop();
+        }
+
+        if (!task && injected_.load(std::memory_order_relaxed) > 0) {
+            std::lock_guard<std::mutex> guard(injection_mutex_);
+            if (!injection_.empty()) {
+                task = injection_.front();
+                injection_.pop_front();
+                injected_.fetch_sub(1, std::memory_order_relaxed);
+            }
+        }
+
+        /* Victims are visited starting from a random one */
+        size_t victims_n = deques_.size();
+        size_t start = victims_n ? NextRandom() % victims_n : 0;
+        for (size_t step = 0; !task && step < victims_n; step++) {
+            size_t victim = (start + step) % victims_n;
+            if (victim != self) {
+                task = deques_[victim]->Steal();
+            }
+        }
+
+        if (task) {
+            queued_.fetch_sub(1, std::memory_order_seq_cst);
+        }
+
+        return task;
+    }
+
+    void WorkerLoop(size_t index) {
+        current_pool_ = this;
+        current_index_ = index;
+
+        while (true) {
+            Task* task = this->FindTask(index);
+            for (size_t spin = 0; !task && spin < kSpinsBeforeSleep; spin++) {
+                std::this_thread::yield();
+                task = this->FindTask(index);
+            }
+
+            if (task) {
+                this->Run(task);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(sleep_mutex_);
+            sleepers_.fetch_add(1, std::memory_order_seq_cst);
+            while (!stop_ && queued_.load(std::memory_order_seq_cst) <= 0) {
+                sleep_cond_.wait(lock);
+            }
+            sleepers_.fetch_sub(1, std::memory_order_seq_cst);
+
+            /* A stopping pool still drains its queues */
+            if (stop_ && queued_.load(std::memory_order_seq_cst) <= 0) {
+                return;
+            }
+        }
+    }
+
+    /*
+     * Pairs with the sleep check in WorkerLoop: either the sleeper sees
+     * the new task or we see the sleeper and notify it under the lock
+     */
+    void Wake() {
+        queued_.fetch_add(1, std::memory_order_seq_cst);
+        if (sleepers_.load(std::memory_order_seq_cst) > 0) {
+            std::lock_guard<std::mutex> guard(sleep_mutex_);
+            sleep_cond_.notify_one();
+        }
+    }
+
+    static size_t NextRandom() {
+        static thread_local size_t state = std::hash<std::thread::id>()(std::this_thread::get_id()) | 1;
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+
+    static size_t DefaultWorkersCount() {
+        const char* env = std::getenv("STDLIKE_NUM_THREADS");
+        size_t threads_n = env ? std::strtoul(env, nullptr, 10) : 0;
+        threads_n = threads_n ? threads_n : std::thread::hardware_concurrency();
+        return threads_n > 1 ? threads_n - 1 : 0;
+    }
+
+    static std::vector<size_t> AllowedCpus() {
+        std::vector<size_t> cpus;
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+            for (size_t cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+                if (CPU_ISSET(cpu, &set)) {
+                    cpus.push_back(cpu);
+                }
+            }
+        }
+
+        return cpus;
+    }
+
+    static void PinThread(std::thread& thread, size_t cpu) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set);
+    }
+
+private:
+    static constexpr size_t kSpinsBeforeSleep = 64;
+
+    inline static thread_local ThreadPool* current_pool_ = nullptr;
+    inline static thread_local size_t current_index_ = 0;
+
+    std::vector<std::unique_ptr<WorkStealingDeque<Task>>> deques_;
+    std::vector<std::thread> workers_;
+
+    std::mutex injection_mutex_ = {};
+    std::deque<Task*> injection_ = {};
+    std::atomic<size_t> injected_ = 0;
+
+    std::mutex sleep_mutex_ = {};
+    std::condition_variable sleep_cond_ = {};
+    std::atomic<int64_t> queued_ = 0;
+    std::atomic<size_t> sleepers_ = 0;
+    bool stop_ = false;
+};
+
+}  // namespace stdlike
+
+#endif  // STDLIKE_THREAD_POOL_HPP
@@ -0,0 +1,289 @@
+#ifndef STDLIKE_TRACE_HPP
+#define STDLIKE_TRACE_HPP
+
+/*
+ * Tracing of long vector operations, compiled in with -DSTDLIKE_TRACE=1.
+ *
+ * Reallocations, Insert/Erase shifts and bulk copies that touch at least
+ * MinBytes() bytes are recorded as complete events into a per-thread SPSC
+ * ring (the owning thread writes, a flush drains under the registry lock).
+ * A full ring drops events rather than blocking. WriteChromeTrace() drains
+ * all rings into a JSON file for chrome://tracing or Perfetto. When
+ * <sys/sdt.h> is available every event also fires a USDT probe
+ * (stdlike:realloc, stdlike:shift, stdlike:copy) with the byte count and
+ * duration, usable from perf and bpftrace.
+ *
+ * Environment: STDLIKE_TRACE_MIN_BYTES overrides the threshold (default
+ * 64 KiB), STDLIKE_TRACE_FILE writes the trace at exit.
+ *
+ * Without STDLIKE_TRACE the hooks expand to nothing.
+ */
+
+#ifndef STDLIKE_TRACE
+#define STDLIKE_TRACE 0
+#endif
+
+#if STDLIKE_TRACE
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define STDLIKE_TRACE_USDT 1
+#else
+#define STDLIKE_TRACE_USDT 0
+#endif
+
+#define STDLIKE_TRACE_SCOPE(kind, bytes) \
+    ::stdlike::trace::Scope trace_scope_(::stdlike::trace::EventKind::kind, bytes)
+
+namespace stdlike::trace {
+
+enum class EventKind : uint32_t {
+    kReallocation,
+    kShift,
+    kCopy,
+};
+
+struct Event {
+    EventKind kind = EventKind::kReallocation;
+    uint32_t thread = 0;
+    uint64_t start_ns = 0;
+    uint64_t duration_ns = 0;
+    uint64_t bytes = 0;
+};
+
+inline const char* KindName(EventKind kind) {
+    switch (kind) {
+        case EventKind::kReallocation:
+            return "Vector::Reallocate";
+        case EventKind::kShift:
+            return "Vector::Shift";
+        case EventKind::kCopy:
+            return "Vector::Copy";
+        default:
+            return "Vector";
+    }
+}
+
+namespace detail {
+
+inline constexpr size_t kDefaultMinBytes = 64 * 1024;
+inline constexpr size_t kRingCapacity = 1 << 12;
+
+inline uint64_t NowNs() {
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+}
+
+/* Single producer (the owning thread), single consumer (a flush under the registry lock) */
+class Ring {
+public:
+    explicit Ring(uint32_t thread) : thread_(thread), events_(new Event[kRingCapacity]) {
+    }
+
+    void Push(const Event& event) {
+        uint64_t head = head_.load(std::memory_order_relaxed);
+        if (head - tail_.load(std::memory_order_acquire) == kRingCapacity) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        events_[head & (kRingCapacity - 1)] = event;
+        head_.store(head + 1, std::memory_order_release);
+    }
+
+    template <typename Func>
+    void Drain(Func func) {
+        uint64_t tail = tail_.load(std::memory_order_relaxed);
+        uint64_t head = head_.load(std::memory_order_acquire);
+        for (; tail != head; tail++) {
+            func(events_[tail & (kRingCapacity - 1)]);
+        }
+        tail_.store(tail, std::memory_order_release);
+    }
+
+    uint32_t Thread() const {
+        return thread_;
+    }
+
+    uint64_t Dropped() const {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+private:
+    uint32_t thread_ = 0;
+    std::unique_ptr<Event[]> events_;
+
+    alignas(64) std::atomic<uint64_t> head_ = 0;
+    alignas(64) std::atomic<uint64_t> tail_ = 0;
+    std::atomic<uint64_t> dropped_ = 0;
+};
+
+struct Registry {
+    std::mutex mutex = {};
+    std::vector<std::shared_ptr<Ring>> rings = {};
+    uint32_t next_thread = 0;
+    std::atomic<size_t> min_bytes = kDefaultMinBytes;
+
+    Registry() {
+        if (const char* env = std::getenv("STDLIKE_TRACE_MIN_BYTES")) {
+            min_bytes.store(std::strtoull(env, nullptr, 10), std::memory_order_relaxed);
+        }
+    }
+
+    Registry(const Registry&) = delete;
+    Registry& operator=(const Registry&) = delete;
+
+    ~Registry();
+};
+
+inline Registry& GlobalRegistry() {
+    static Registry registry;
+    return registry;
+}
+
+/* Rings outlive their threads, so events of finished threads are still flushed */
+inline Ring& LocalRing() {
+    static thread_local std::shared_ptr<Ring> ring = []() {
+        Registry& registry = GlobalRegistry();
+        std::lock_guard<std::mutex> guard(registry.mutex);
+        registry.rings.push_back(std::make_shared<Ring>(registry.next_thread++));
+        return registry.rings.back();
+    }();
+    return *ring;
+}
+
+}  // namespace detail
+
+inline size_t MinBytes() {
+    return detail::GlobalRegistry().min_bytes.load(std::memory_order_relaxed);
+}
+
+inline void SetMinBytes(size_t bytes) {
+    detail::GlobalRegistry().min_bytes.store(bytes, std::memory_order_relaxed);
+}
+
+namespace detail {
+
+inline uint64_t DrainRings(Registry& registry, std::vector<Event>& events) {
+    uint64_t dropped = 0;
+    for (const std::shared_ptr<Ring>& ring : registry.rings) {
+        ring->Drain([&events, &ring](const Event& event) {
+            events.push_back(event);
+            events.back().thread = ring->Thread();
+        });
+        dropped += ring->Dropped();
+    }
+
+    return dropped;
+}
+
+/* Chrome trace event format, complete ("X") events with microsecond timestamps */
+inline bool WriteEvents(const char* path, const std::vector<Event>& events, uint64_t dropped) {
+    FILE* file = std::fopen(path, "w");
+    if (!file) {
+        return false;
+    }
+
+    std::fprintf(file, "{\"displayTimeUnit\": \"ns\", \"otherData\": {\"dropped\": %lu}, \"traceEvents\": [\n",
+                 dropped);
+    for (size_t pos = 0; pos < events.size(); pos++) {
+        const Event& event = events[pos];
+        std::fprintf(file,
+                     "{\"name\": \"%s\", \"cat\": \"stdlike\", \"ph\": \"X\", \"pid\": 1, \"tid\": %u, "
+                     "\"ts\": %.3f, \"dur\": %.3f, \"args\": {\"bytes\": %lu}}%s\n",
+                     KindName(event.kind), event.thread, static_cast<double>(event.start_ns) / 1e3,
+                     static_cast<double>(event.duration_ns) / 1e3, event.bytes,
+                     (pos + 1 < events.size()) ? "," : "");
+    }
+    std::fprintf(file, "]}\n");
+
+    return std::fclose(file) == 0;
+}
+
+/* Other threads are gone by now, so the rings are drained without the lock */
+inline Registry::~Registry() {
+    if (const char* path = std::getenv("STDLIKE_TRACE_FILE")) {
+        std::vector<Event> events;
+        uint64_t dropped = DrainRings(*this, events);
+        WriteEvents(path, events, dropped);
+    }
+}
+
+}  // namespace detail
+
+/* Takes all buffered events out of the rings, returns the number of dropped events so far */
+inline uint64_t Drain(std::vector<Event>& events) {
+    detail::Registry& registry = detail::GlobalRegistry();
+    std::lock_guard<std::mutex> guard(registry.mutex);
+    return detail::DrainRings(registry, events);
+}
+
+/* Drains all rings into a trace file, events already drained are not repeated */
+inline bool WriteChromeTrace(const char* path) {
+    std::vector<Event> events;
+    uint64_t dropped = Drain(events);
+    return detail::WriteEvents(path, events, dropped);
+}
+
+/* Times the enclosing block if it touches at least MinBytes() bytes */
+class Scope {
+public:
+    Scope(EventKind kind, size_t bytes) : kind_(kind), bytes_(bytes) {
+        if (bytes_ >= MinBytes()) {
+            start_ns_ = detail::NowNs();
+        }
+    }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+    ~Scope() {
+        if (start_ns_ == 0) {
+            return;
+        }
+
+        uint64_t duration_ns = detail::NowNs() - start_ns_;
+        detail::LocalRing().Push({kind_, 0, start_ns_, duration_ns, bytes_});
+
+#if STDLIKE_TRACE_USDT
+        switch (kind_) {
+            case EventKind::kReallocation:
+                DTRACE_PROBE2(stdlike, realloc, bytes_, duration_ns);
+                break;
+            case EventKind::kShift:
+                DTRACE_PROBE2(stdlike, shift, bytes_, duration_ns);
+                break;
+            case EventKind::kCopy:
+                DTRACE_PROBE2(stdlike, copy, bytes_, duration_ns);
+                break;
+            default:
+                break;
+        }
+#endif
+    }
+
+private:
+    EventKind kind_ = EventKind::kReallocation;
+    uint64_t bytes_ = 0;
+    uint64_t start_ns_ = 0;
+};
+
+}  // namespace stdlike::trace
+
+#else
+
+#define STDLIKE_TRACE_SCOPE(kind, bytes) ((void)0)
+
+#endif  // STDLIKE_TRACE
+
+#endif  // STDLIKE_TRACE_HPP
@@ -0,0 +1,56 @@
+#ifndef STDLIKE_UNIQUE_FD_HPP
+#define STDLIKE_UNIQUE_FD_HPP
+
+#include <utility>
+
+#include <unistd.h>
+
+namespace stdlike {
+
+namespace detail {
+
+/* Owns a file descriptor, closes it when destroyed */
+class UniqueFd {
+public:
+    UniqueFd() {
+    }
+
+    explicit UniqueFd(int fd) : fd_(fd) {
+    }
+
+    UniqueFd(const UniqueFd&) = delete;
+    UniqueFd& operator=(const UniqueFd&) = delete;
+
+    UniqueFd(UniqueFd&& temp) {
+        std::swap(temp.fd_, fd_);
+    }
+
+    UniqueFd& operator=(UniqueFd&& temp) {
+        std::swap(temp.fd_, fd_);
+        return *this;
+    }
+
+    ~UniqueFd() {
+        this->Reset();
+    }
+
+    int Get() const {
+        return fd_;
+    }
+
+    void Reset() {
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+
+private:
+    int fd_ = -1;
+};
+
+}  // namespace detail
+
+}  // namespace stdlike
+
+#endif  // STDLIKE_UNIQUE_FD_HPP
@@ -3,7 +3,12 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <cassert>
+#include <algorithm>
+#include <bit>
+#include <compare>
 #include <functional>
 #include <iostream>
 #include <iterator>
@@ -14,138 +19,233 @@
 #include <stdlike/move.hpp>
 #include <stdlike/forward.hpp>
 #include <stdlike/allocator.hpp>
+#include <stdlike/bit_span.hpp>
+#include <stdlike/execution.hpp>
+#include <stdlike/hash.hpp>
+#include <stdlike/iterator_debug.hpp>
+#include <stdlike/instrument.hpp>
+#include <stdlike/trace.hpp>
 
 namespace stdlike {
 
+/*
+ * Tag of the constructors that default-initialize their elements, trivial
+ * types are left uninitialized for a buffer that is about to be overwritten
+ */
+struct DefaultInit {};
+
+inline constexpr DefaultInit default_init{};
+
+/*
+ * Order of the bits of Vector<bool> within its uint32_t words. LSB-first
+ * words on a little-endian machine are also LSB-first bytes, the layout of
+ * Arrow validity bitmaps, see Vector<bool>::Span().
+ */
+enum class BitOrder {
+    kMsbFirst,
+    kLsbFirst,
+};
+
+/*
+ * Vector<bool> allocates its words itself, its allocator argument selects
+ * the bit order: Allocator<bool> keeps the original MSB-first layout,
+ * BitVector<BitOrder::kLsbFirst> is Vector<bool, BitAllocator<kLsbFirst>>
+ */
+template <BitOrder kOrder>
+class BitAllocator : public Allocator<bool> {
+public:
+    static constexpr BitOrder kBitOrder = kOrder;
+};
+
+namespace detail {
+
+template <class Alloc>
+inline constexpr BitOrder kBitOrderOf = BitOrder::kMsbFirst;
+
+template <BitOrder kOrder>
+inline constexpr BitOrder kBitOrderOf<BitAllocator<kOrder>> = kOrder;
+
+template <class Alloc>
+concept BitVectorAllocator = std::is_same_v<Alloc, Allocator<bool>> ||
+                             std::is_same_v<Alloc, BitAllocator<BitOrder::kMsbFirst>> ||
+                             std::is_same_v<Alloc, BitAllocator<BitOrder::kLsbFirst>>;
+
+/* Mask of bit offset of a word, 0 <= offset < 32 */
+template <BitOrder kOrder>
+constexpr uint32_t BitMask(uint32_t offset) {
+    return kOrder == BitOrder::kMsbFirst ? 1u << (31u - offset) : 1u << offset;
+}
+
+/* Mask of the bits [first_bit, last_bit) of a word, 0 <= first_bit < last_bit <= 32 */
+template <BitOrder kOrder>
+constexpr uint32_t BitRangeMask(uint32_t first_bit, uint32_t last_bit) {
+    if constexpr (kOrder == BitOrder::kMsbFirst) {
+        uint32_t head = ~0u >> first_bit;
+        uint32_t tail = (last_bit == 32) ? ~0u : ~(~0u >> last_bit);
+        return head & tail;
+    } else {
+        uint32_t head = ~0u << first_bit;
+        uint32_t tail = (last_bit == 32) ? ~0u : (1u << last_bit) - 1;
+        return head & tail;
+    }
+}
+
+/*
+ * Equal values have equal bytes and the other way round, so memcmp and byte
+ * hashes apply. Scalars only, a class may define its own operator==.
+ */
+template <typename Type>
+concept BytewiseComparable = (std::is_integral_v<Type> || std::is_enum_v<Type> || std::is_pointer_v<Type>) &&
+                             std::has_unique_object_representations_v<Type>;
+
+/* Index of the first difference, glibc memcmp finds the block it is in with SIMD */
+template <BytewiseComparable Type>
+size_t MismatchIndex(const Type* lhs, const Type* rhs, size_t size) {
+    constexpr size_t kBlockSize = std::max<size_t>(1, 256 / sizeof(Type));
+
+    size_t pos = 0;
+    while (pos + kBlockSize <= size && std::memcmp(lhs + pos, rhs + pos, kBlockSize * sizeof(Type)) == 0) {
+        pos += kBlockSize;
+    }
+    while (pos < size && lhs[pos] == rhs[pos]) {
+        pos++;
+    }
+
+    return pos;
+}
+
+}  // namespace detail
+
 template <typename Type, class Alloc = stdlike::Allocator<Type>>
 class Vector {
 public:
-    /* Iterator */
+#if STDLIKE_ITERATOR_DEBUG
+    /* Iterator and ConstIterator, checked against the owning vector */
 
-    class Iterator : public std::iterator<std::contiguous_iterator_tag, Type> {
+    template <typename Value>
+    class CheckedIterator {
     public:
-        Iterator() : ptr_(nullptr), container_(nullptr) {
-        }
+        using iterator_concept = std::contiguous_iterator_tag;
+        using iterator_category = std::random_access_iterator_tag;
+        using difference_type = ptrdiff_t;
+        using value_type = std::remove_const_t<Value>;
+        using element_type = Value;
+        using pointer = Value*;
+        using reference = Value&;
 
-        Iterator(Type* ptr, Vector* container = nullptr) : ptr_(ptr), container_(container) {
-        }
+        using Owner = std::conditional_t<std::is_const_v<Value>, const Vector, Vector>;
 
-        Iterator(const Iterator& other) : ptr_(other.ptr_), container_(other.container_) {
-        }
+        CheckedIterator() = default;
 
-        ~Iterator() {
-            ptr_ = nullptr;
-            container_ = nullptr;
+        CheckedIterator(Value* ptr, Owner* container)
+            : ptr_(ptr), container_(container), generation_(container->generation_) {
         }
 
-        Iterator& operator=(const Iterator& other) {
-            ptr_ = other.ptr_;
-            container_ = other.container_;
-            return *this;
+        /* Iterator -> ConstIterator */
+        template <typename Other>
+            requires(std::is_const_v<Value> && std::is_same_v<Other, value_type>)
+        CheckedIterator(const CheckedIterator<Other>& other)
+            : ptr_(other.ptr_), container_(other.container_), generation_(other.generation_) {
         }
 
-        Type& operator*() const {
-            assert(ptr_ && container_ && ptr_ < container_->End().ptr_);
+        reference operator*() const {
+            this->CheckDereferenceable(ptr_);
             return *ptr_;
         }
 
-        Type* operator->() const {
-            assert(ptr_ && container_ && ptr_ < container_->End().ptr_);
+        /* std::to_address goes through here, so End() passes */
+        pointer operator->() const {
+            this->CheckCurrent();
             return ptr_;
         }
 
-        Iterator& operator++() {
+        reference operator[](difference_type diff) const {
+            this->CheckDereferenceable(ptr_ + diff);
+            return ptr_[diff];
+        }
+
+        CheckedIterator& operator++() {
             ++ptr_;
             return *this;
         }
 
-        Iterator operator++(int) {
-            Iterator temp = *this;
+        CheckedIterator operator++(int) {
+            CheckedIterator temp = *this;
             ++ptr_;
             return temp;
         }
 
-        Iterator& operator--() {
+        CheckedIterator& operator--() {
             --ptr_;
             return *this;
         }
 
-        Iterator operator--(int) {
-            Iterator temp = *this;
+        CheckedIterator operator--(int) {
+            CheckedIterator temp = *this;
             --ptr_;
             return temp;
         }
 
-        Iterator& operator+=(ptrdiff_t diff) {
-            if (diff >= 0) {
-                while (diff--) {
-                    ++(*this);
-                }
-            } else {
-                while (diff++) {
-                    --(*this);
-                }
-            }
+        CheckedIterator& operator+=(difference_type diff) {
+            ptr_ += diff;
             return *this;
         }
 
-        Iterator& operator-=(ptrdiff_t diff) {
-            return *this += -diff;
-        }
-
-        Type& operator[](ptrdiff_t diff) const {
-            return ptr_[diff];
+        CheckedIterator& operator-=(difference_type diff) {
+            ptr_ -= diff;
+            return *this;
         }
 
-        friend Iterator operator+(const Iterator& iter, ptrdiff_t diff) {
-            Iterator temp = iter;
-            return temp += diff;
+        friend CheckedIterator operator+(CheckedIterator iter, difference_type diff) {
+            return iter += diff;
         }
 
-        friend Iterator operator+(ptrdiff_t diff, const Iterator& iter) {
-            return iter + diff;
+        friend CheckedIterator operator+(difference_type diff, CheckedIterator iter) {
+            return iter += diff;
         }
 
-        friend Iterator operator-(const Iterator& iter, ptrdiff_t diff) {
-            Iterator temp = iter;
-            return temp -= diff;
+        friend CheckedIterator operator-(CheckedIterator iter, difference_type diff) {
+            return iter -= diff;
         }
 
-        friend ptrdiff_t operator-(const Iterator& lhs, const Iterator& rhs) {
+        friend difference_type operator-(const CheckedIterator& lhs, const CheckedIterator& rhs) {
+            STDLIKE_ITERATOR_CHECK(lhs.container_ == rhs.container_, "subtracting iterators of different vectors");
             return lhs.ptr_ - rhs.ptr_;
         }
 
-        friend bool operator==(const Iterator& lhs, const Iterator& rhs) {
+        friend bool operator==(const CheckedIterator& lhs, const CheckedIterator& rhs) {
             return lhs.ptr_ == rhs.ptr_;
         }
 
-        friend bool operator!=(const Iterator& lhs, const Iterator& rhs) {
-            return !(lhs == rhs);
-        }
-
-        friend bool operator<(const Iterator& lhs, const Iterator& rhs) {
-            return lhs.ptr_ < rhs.ptr_;
+        friend std::strong_ordering operator<=>(const CheckedIterator& lhs, const CheckedIterator& rhs) {
+            return lhs.ptr_ <=> rhs.ptr_;
         }
 
-        friend bool operator>(const Iterator& lhs, const Iterator& rhs) {
-            return rhs < lhs;
-        }
+    private:
+        template <typename>
+        friend class CheckedIterator;
+        friend class Vector;
 
-        friend bool operator<=(const Iterator& lhs, const Iterator& rhs) {
-            return !(lhs > rhs);
+        void CheckCurrent() const {
+            STDLIKE_ITERATOR_CHECK(container_, "iterator does not belong to a vector");
+            STDLIKE_ITERATOR_CHECK(generation_ == container_->generation_,
+                                   "iterator used after the vector reallocated");
         }
 
-        friend bool operator>=(const Iterator& lhs, const Iterator& rhs) {
-            return !(lhs < rhs);
+        void CheckDereferenceable(const Value* ptr) const {
+            this->CheckCurrent();
+            STDLIKE_ITERATOR_CHECK(ptr >= container_->data_ && ptr < container_->data_ + container_->size_,
+                                   "dereferenced iterator is out of range");
         }
 
-        friend auto operator<=>(const Iterator& lhs, const Iterator& rhs) = default; // !
-
-    private:
-        Type* ptr_ = nullptr;
-        Vector* container_ = nullptr;
+        Value* ptr_ = nullptr;
+        Owner* container_ = nullptr;
+        uint64_t generation_ = 0;
     };
 
+    using Iterator = CheckedIterator<Type>;
+    using ConstIterator = CheckedIterator<const Type>;
+
     Iterator Begin() {
         return Iterator(data_, this);
     }
@@ -154,144 +254,42 @@ public:
         return Iterator(data_ + size_, this);
     }
 
-    Iterator begin() {
-        return Begin();
+    ConstIterator Begin() const {
+        return ConstIterator(data_, this);
     }
 
-    Iterator end() {
-        return End();
+    ConstIterator End() const {
+        return ConstIterator(data_ + size_, this);
     }
+#else
+    /* Iterator and ConstIterator */
 
-    /* ConstIterator */
-
-    class ConstIterator : public std::iterator<std::contiguous_iterator_tag, Type> { // ! template
-    public:
-        ConstIterator() : ptr_(nullptr), container_(nullptr) {
-        }
+    using Iterator = Type*;
+    using ConstIterator = const Type*;
 
-        ConstIterator(Type* ptr, const Vector* container) : ptr_(ptr), container_(container) {
-        }
-
-        ConstIterator(const ConstIterator& other) : ptr_(other.ptr_), container_(other.container) {
-        }
-
-        ~ConstIterator() {
-            ptr_ = nullptr;
-            container_ = nullptr;
-        }
-
-        ConstIterator& operator=(const ConstIterator& other) {
-            ptr_ = other.ptr_;
-            container_ = other.container_;
-        }
-
-        const Type& operator*() const {
-            assert(ptr_ && container_ && ptr_ < End().ptr_);
-            return *ptr_;
-        }
-
-        const Type* operator->() const {
-            assert(ptr_ && container_ && ptr_ < End().ptr_);
-            return ptr_;
-        }
-
-        ConstIterator& operator++() {
-            ++ptr_;
-            return *this;
-        }
-
-        ConstIterator operator++(int) {
-            ConstIterator temp = *this;
-            ++ptr_;
-            return temp;
-        }
-
-        ConstIterator& operator--() {
-            --ptr_;
-            return *this;
-        }
-
-        ConstIterator operator--(int) {
-            ConstIterator temp = *this;
-            --ptr_;
-            return temp;
-        }
-
-        ConstIterator& operator+=(ptrdiff_t diff) {
-            if (diff >= 0) {
-                while (diff--) {
-                    ++(*this);
-                }
-            } else {
-                while (diff++) {
-                    --(*this);
-                }
-            }
-        }
-
-        ConstIterator& operator-=(ptrdiff_t diff) {
-            return *this += -diff;
-        }
-
-        const Type& operator[](ptrdiff_t diff) const {
-            return ptr_[diff];
-        }
-
-        friend ConstIterator operator+(const ConstIterator& iter, ptrdiff_t diff) {
-            ConstIterator temp = iter;
-            return temp += diff;
-        }
-
-        friend ConstIterator operator+(ptrdiff_t diff, const ConstIterator& iter) {
-            return iter + diff;
-        }
-
-        friend ConstIterator operator-(const ConstIterator& iter, ptrdiff_t diff) {
-            ConstIterator temp = iter;
-            return temp -= diff;
-        }
-
-        friend ptrdiff_t operator-(const ConstIterator& lhs, const ConstIterator& rhs) {
-            return lhs.ptr_ - rhs.ptr_;
-        }
-
-        friend bool operator==(const ConstIterator& lhs, const ConstIterator& rhs) {
-            return lhs.ptr_ == rhs.ptr_;
-        }
-
-        friend bool operator!=(const ConstIterator& lhs, const ConstIterator& rhs) {
-            return !(lhs == rhs);
-        }
-
-        friend bool operator<(const ConstIterator& lhs, const ConstIterator& rhs) {
-            return lhs.ptr_ < rhs.ptr_;
-        }
-
-        friend bool operator>(const ConstIterator& lhs, const ConstIterator& rhs) {
-            return rhs < lhs;
-        }
-
-        friend bool operator<=(const ConstIterator& lhs, const ConstIterator& rhs) {
-            return !(lhs > rhs);
-        }
-
-        friend bool operator>=(const ConstIterator& lhs, const ConstIterator& rhs) {
-            return !(lhs < rhs);
-        }
-
-        friend auto operator<=>(const ConstIterator& lhs, const ConstIterator& rhs) = default;
+    Iterator Begin() {
+        return data_;
+    }
 
-    private:
-        const Type* ptr_ = nullptr;
-        const Vector* container_ = nullptr;
-    };
+    Iterator End() {
+        return data_ + size_;
+    }
 
     ConstIterator Begin() const {
-        return ConstIterator(data_, this);
+        return data_;
     }
 
     ConstIterator End() const {
-        return ConstIterator(data_ + size_, this);
+        return data_ + size_;
+    }
+#endif
+
+    Iterator begin() {
+        return Begin();
+    }
+
+    Iterator end() {
+        return End();
     }
 
     ConstIterator begin() const {
@@ -313,40 +311,91 @@ public:
     Vector() : size_(0), capacity_(0), data_(nullptr) {
     }
 
-    explicit Vector(size_t init_size, const Type& value = Type())
-        : allocator_(Alloc()), size_(init_size), capacity_(init_size), data_(allocator_.allocate(capacity_)) {
+    /* A zero value comes with the zeroed buffer, see Allocator::AllocateZeroed */
+    explicit Vector(size_t init_size, const Type& value = Type() STDLIKE_SITE_PARAM)
+        : allocator_(Alloc())
+        , size_(init_size)
+        , capacity_(init_size)
+        , data_(this->Allocate(capacity_, IsZeroValue(value) STDLIKE_SITE_ARG)) {
+
+        if (!IsZeroValue(value)) {
+            this->Initialize(data_, 0, size_, value);
+        }
+    }
+
+    Vector(DefaultInit, size_t init_size STDLIKE_SITE_PARAM)
+        : allocator_(Alloc())
+        , size_(init_size)
+        , capacity_(init_size)
+        , data_(this->Allocate(capacity_, false STDLIKE_SITE_ARG)) {
 
-        this->Initialize(data_, 0, size_, value);
+        this->DefaultInitialize(data_, 0, size_);
     }
 
-    Vector(const Vector& other)
+    Vector(const Vector& other STDLIKE_SITE_PARAM)
         : allocator_(Alloc())
         , size_(other.Size())
         , capacity_(other.Capacity())
-        , data_(allocator_.allocate(other.Capacity())) {
+        , data_(this->Allocate(other.Capacity(), false STDLIKE_SITE_ARG)) {
 
         this->Copy(data_, 0, other.Size(), other.Data());
     }
 
+    /* Parallel versions split element construction across threads */
+
+    Vector(ParallelPolicy, size_t init_size, const Type& value = Type() STDLIKE_SITE_PARAM)
+        : allocator_(Alloc())
+        , size_(init_size)
+        , capacity_(init_size)
+        , data_(this->Allocate(capacity_, IsZeroValue(value) STDLIKE_SITE_ARG)) {
+
+        if (!IsZeroValue(value)) {
+            this->ParallelInitialize(data_, 0, size_, value);
+        }
+    }
+
+    Vector(ParallelPolicy, const Vector& other STDLIKE_SITE_PARAM)
+        : allocator_(Alloc())
+        , size_(other.Size())
+        , capacity_(other.Capacity())
+        , data_(this->Allocate(other.Capacity(), false STDLIKE_SITE_ARG)) {
+
+        this->ParallelCopy(data_, 0, other.Size(), other.Data());
+    }
+
     Vector(Vector&& temp) {
         *this = std::move(temp);
     }
 
+    /* Lazy views and expressions (see views.hpp) are evaluated right into the vector */
+
+    template <typename Expr>
+        requires requires(const Expr& expr, Vector& vec) { expr.EvaluateInto(vec); }
+    Vector(const Expr& expr) : Vector() {
+        expr.EvaluateInto(*this);
+    }
+
     ~Vector() {
         this->Release(data_, 0, size_);
-        allocator_.deallocate(data_, capacity_);
+        this->Deallocate(data_, capacity_);
         size_ = 0;
         capacity_ = 0;
         data_ = nullptr;
     }
 
     Vector& operator=(const Vector& other) {
-        this->~Vector();
+        if (this == &other) {
+            return *this;
+        }
+
+        Type* new_data = this->Allocate(other.Capacity(), false);
+        this->Copy(new_data, 0, other.Size(), other.Data());
+        this->Release(data_, 0, size_);
+        this->Deallocate(data_, capacity_);
         size_ = other.Size();
         capacity_ = other.Capacity();
-        data_ = allocator_.allocate(other.Capacity());
-
-        this->Copy(data_, 0, other.Size(), other.Data());
+        data_ = new_data;
+        this->Invalidate();
 
         return *this;
     }
@@ -355,11 +404,70 @@ public:
         std::swap(temp.size_, size_);
         std::swap(temp.capacity_, capacity_);
         std::swap(temp.data_, data_);
+        temp.Invalidate();
+        this->Invalidate();
 
         return *this;
     }
 
-    bool operator==(const Vector&) const = delete;
+    /* The expression may read this vector, so it is evaluated aside first */
+    template <typename Expr>
+        requires requires(const Expr& expr, Vector& vec) { expr.EvaluateInto(vec); }
+    Vector& operator=(const Expr& expr) {
+        Vector temp(expr);
+        return *this = stdlike::move(temp);
+    }
+
+    /* The copy is made before the old elements go, so other may be this vector */
+    Vector& Assign(ParallelPolicy, const Vector& other STDLIKE_SITE_PARAM) {
+        if (this == &other) {
+            return *this;
+        }
+
+        Type* new_data = this->Allocate(other.Capacity(), false STDLIKE_SITE_ARG);
+        this->ParallelCopy(new_data, 0, other.Size(), other.Data());
+        this->ParallelRelease(data_, 0, size_);
+        this->Deallocate(data_, capacity_);
+        size_ = other.Size();
+        capacity_ = other.Capacity();
+        data_ = new_data;
+        this->Invalidate();
+
+        return *this;
+    }
+
+    /* Comparison */
+
+    friend bool operator==(const Vector& lhs, const Vector& rhs)
+        requires std::equality_comparable<Type>
+    {
+        if (lhs.size_ != rhs.size_) {
+            return false;
+        }
+
+        if constexpr (detail::BytewiseComparable<Type>) {
+            return lhs.size_ == 0 || std::memcmp(lhs.data_, rhs.data_, lhs.size_ * sizeof(Type)) == 0;
+        } else {
+            return std::equal(lhs.data_, lhs.data_ + lhs.size_, rhs.data_);
+        }
+    }
+
+    /* Lexicographic, a prefix orders first */
+    friend auto operator<=>(const Vector& lhs, const Vector& rhs)
+        requires std::three_way_comparable<Type>
+    {
+        size_t common = std::min(lhs.size_, rhs.size_);
+        if constexpr (detail::BytewiseComparable<Type>) {
+            size_t pos = (common == 0) ? 0 : detail::MismatchIndex(lhs.data_, rhs.data_, common);
+            if (pos < common) {
+                return std::compare_three_way_result_t<Type>(lhs.data_[pos] <=> rhs.data_[pos]);
+            }
+            return std::compare_three_way_result_t<Type>(lhs.size_ <=> rhs.size_);
+        } else {
+            return std::lexicographical_compare_three_way(lhs.data_, lhs.data_ + lhs.size_, rhs.data_,
+                                                          rhs.data_ + rhs.size_);
+        }
+    }
 
     /* Capacity */
 
@@ -375,15 +483,20 @@ public:
         return capacity_;
     }
 
-    void Reserve(size_t new_capacity) {
+    void Reserve(size_t new_capacity STDLIKE_SITE_PARAM) {
+        STDLIKE_INSTRUMENT_HOOK(CapacityChange(site, instrument::Event::kReserve,
+                                               std::max(new_capacity, capacity_) * sizeof(Type), size_ * sizeof(Type),
+                                               0));
         if (new_capacity > capacity_) {
-            this->ChangeCapacity(new_capacity);
+            this->ChangeCapacity(new_capacity STDLIKE_SITE_ARG);
         }
     }
 
-    void ShrinkToFit() {
+    void ShrinkToFit(STDLIKE_SITE_PARAM_FIRST) {
+        STDLIKE_INSTRUMENT_HOOK(CapacityChange(site, instrument::Event::kShrinkToFit, size_ * sizeof(Type),
+                                               size_ * sizeof(Type), 0));
         if (capacity_ > size_) {
-            this->ChangeCapacity(size_);
+            this->ChangeCapacity(size_ STDLIKE_SITE_ARG);
         }
     }
 
@@ -435,6 +548,10 @@ public:
         return data_;
     }
 
+    Alloc GetAllocator() const {
+        return allocator_;
+    }
+
     /* Modifiers */
 
     void Clear() {
@@ -442,28 +559,37 @@ public:
         size_ = 0;
     }
 
-    Iterator Insert(Iterator pos, const Type& value) {
+    void Clear(ParallelPolicy) {
+        this->ParallelRelease(data_, 0, size_);
+        size_ = 0;
+    }
+
+    Iterator Insert(Iterator pos, const Type& value STDLIKE_SITE_PARAM) {
+        STDLIKE_ITERATOR_CHECK(this->Owns(pos), "Insert position is not a current iterator of this vector");
         ptrdiff_t offset = pos - Begin();
+        Type copy(value); /* value may live in this vector, growing frees it and shifting moves it */
         /* Invalidates Iterators */
         if (size_ >= capacity_) {
-            this->Reserve(size_ ? size_ * 2 : 1);
+            this->ChangeCapacity(size_ ? size_ * 2 : 1 STDLIKE_SITE_ARG);
         }
 
         pos = Begin() + offset;
-        allocator_.construct(data_ + size_++, value);
+        STDLIKE_TRACE_SCOPE(kShift, (size_ - static_cast<size_t>(offset)) * sizeof(Type));
+        allocator_.construct(data_ + size_++, std::move(copy));
         for (Iterator it = End() - 1; it > pos; it--) {
             std::swap(*it, *(it - 1));
         }
 
-        *pos = value;
         return pos;
     }
 
     Iterator Erase(Iterator pos) {
+        STDLIKE_ITERATOR_CHECK(this->Owns(pos), "Erase position is not a current iterator of this vector");
         if (pos >= End()) {
             return End();
         }
 
+        STDLIKE_TRACE_SCOPE(kShift, static_cast<size_t>(End() - pos) * sizeof(Type));
         for (Iterator it = pos; it < End() - 1; it++) {
             std::swap(*it, *(it + 1));
         }
@@ -472,8 +598,8 @@ public:
         return pos;
     }
 
-    void PushBack(const Type& value) {
-        this->Insert(End(), value);
+    void PushBack(const Type& value STDLIKE_SITE_PARAM) {
+        this->Insert(End(), value STDLIKE_SITE_ARG);
     }
 
     void PopBack() {
@@ -482,16 +608,65 @@ public:
         }
     }
 
-    void Resize(size_t new_size, const Type& value = Type()) {
+    void Resize(size_t new_size, const Type& value = Type() STDLIKE_SITE_PARAM) {
         if (size_ >= new_size) {
             this->Release(data_, new_size, size_);
+            size_ = new_size;
+        } else if (new_size > capacity_ && IsZeroValue(value)) {
+            /* The tail of a zeroed buffer already holds the value */
+            this->ChangeCapacity(new_size, true STDLIKE_SITE_ARG);
+            size_ = new_size;
+        } else if (new_size > capacity_) {
+            Type copy(value); /* value may live in this vector */
+            this->ChangeCapacity(new_size STDLIKE_SITE_ARG);
+            this->Initialize(data_, size_, new_size, copy);
+            size_ = new_size;
         } else {
-            this->Reserve(new_size);
             this->Initialize(data_, size_, new_size, value);
             size_ = new_size;
         }
     }
 
+    /* Resize for a buffer that is about to be overwritten, new elements are default-initialized */
+    void ResizeForOverwrite(size_t new_size STDLIKE_SITE_PARAM) {
+        if (size_ >= new_size) {
+            this->Release(data_, new_size, size_);
+        } else {
+            if (new_size > capacity_) {
+                this->ChangeCapacity(new_size STDLIKE_SITE_ARG);
+            }
+            this->DefaultInitialize(data_, size_, new_size);
+        }
+        size_ = new_size;
+    }
+
+    /*
+     * Grows by elems_n default-initialized elements and returns the first of
+     * them. Capacity at least doubles, so appending in pieces stays linear.
+     */
+    Type* AppendUninitialized(size_t elems_n STDLIKE_SITE_PARAM) {
+        size_t old_size = size_;
+        if (size_ + elems_n > capacity_) {
+            this->ChangeCapacity(std::max(size_ + elems_n, capacity_ * 2) STDLIKE_SITE_ARG);
+        }
+
+        this->DefaultInitialize(data_, size_, size_ + elems_n);
+        size_ += elems_n;
+        return data_ + old_size;
+    }
+
+    void Resize(ParallelPolicy, size_t new_size, const Type& value = Type() STDLIKE_SITE_PARAM) {
+        if (size_ >= new_size) {
+            this->ParallelRelease(data_, new_size, size_);
+            size_ = new_size;
+        } else {
+            Type copy(value); /* value may live in this vector */
+            this->Reserve(new_size STDLIKE_SITE_ARG);
+            this->ParallelInitialize(data_, size_, new_size, copy);
+            size_ = new_size;
+        }
+    }
+
     void Swap(Vector& other) {
         Vector temp = stdlike::move(other);
         other = stdlike::move(*this);
@@ -501,14 +676,78 @@ public:
 private:
     /* Helper functions */
 
-    void ChangeCapacity(size_t new_capacity) {
-        Type* new_data = allocator_.allocate(new_capacity);
+    void ChangeCapacity(size_t new_capacity STDLIKE_SITE_PARAM) {
+        this->ChangeCapacity(new_capacity, false STDLIKE_SITE_ARG);
+    }
+
+    /* zeroed: the part of the new buffer past the elements is zero-filled */
+    void ChangeCapacity(size_t new_capacity, bool zeroed STDLIKE_SITE_PARAM) {
+        STDLIKE_INSTRUMENT_SCOPE(site);
+        STDLIKE_INSTRUMENT_HOOK(CapacityChange(site,
+                                               data_ ? instrument::Event::kReallocation : instrument::Event::kConstruct,
+                                               new_capacity * sizeof(Type), size_ * sizeof(Type),
+                                               std::min(size_, new_capacity) * sizeof(Type)));
+
+        STDLIKE_TRACE_SCOPE(kReallocation, new_capacity * sizeof(Type));
+        Type* new_data = this->NewBuffer(new_capacity, zeroed);
         size_t new_size = this->Copy(new_data, 0, std::min(size_, new_capacity), data_);
-        this->~Vector();
+        this->Release(data_, 0, size_);
+        this->Deallocate(data_, capacity_);
 
         size_ = new_size;
         capacity_ = new_capacity;
         data_ = new_data;
+        this->Invalidate();
+    }
+
+#if STDLIKE_ITERATOR_DEBUG
+    /* Every iterator taken before this call is stale */
+    void Invalidate() {
+        generation_++;
+    }
+
+    /* Insert/Erase position: a current iterator of this vector in [Begin(), End()] */
+    bool Owns(const ConstIterator& pos) const {
+        return pos.container_ == this && pos.generation_ == generation_ && pos.ptr_ >= data_ &&
+               pos.ptr_ <= data_ + size_;
+    }
+#else
+    void Invalidate() {
+    }
+#endif
+
+    /* Buffer for a constructor, allocator calls are charged to the vector's call site */
+    Type* Allocate(size_t elems_n, bool zeroed STDLIKE_SITE_PARAM) {
+        STDLIKE_INSTRUMENT_SCOPE(site);
+        STDLIKE_INSTRUMENT_HOOK(CapacityChange(site, instrument::Event::kConstruct, elems_n * sizeof(Type),
+                                               size_ * sizeof(Type), 0));
+        return this->NewBuffer(elems_n, zeroed);
+    }
+
+    void Deallocate(Type* data, size_t elems_n) {
+        allocator_.deallocate(data, elems_n);
+    }
+
+    Type* NewBuffer(size_t elems_n, bool zeroed) {
+        if constexpr (detail::ZeroAllocator<Alloc>) {
+            if (zeroed) {
+                return allocator_.AllocateZeroed(elems_n);
+            }
+        }
+
+        return allocator_.allocate(elems_n);
+    }
+
+    /* Elements equal to value can be left to a zeroed buffer: trivially copyable and all bytes zero */
+    static bool IsZeroValue(const Type& value) {
+        if constexpr (std::is_trivially_copyable_v<Type> && detail::ZeroAllocator<Alloc>) {
+            const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&value);
+            return std::all_of(bytes, bytes + sizeof(Type), [](unsigned char byte) {
+                return byte == 0;
+            });
+        } else {
+            return false;
+        }
     }
 
     inline size_t Release(Type* data, size_t start, size_t end) {
@@ -524,6 +763,17 @@ private:
         return end - start;
     }
 
+    /* No-op for trivial types, their memory keeps its old contents */
+    inline size_t DefaultInitialize(Type* data, size_t start, size_t end) {
+        if constexpr (!std::is_trivially_default_constructible_v<Type>) {
+            for (size_t cur_offset = start; cur_offset < end; cur_offset++) {
+                ::new (static_cast<void*>(data + cur_offset)) Type;
+            }
+        }
+
+        return end - start;
+    }
+
     inline size_t Initialize(Type* data, size_t start, size_t end, const Type& value) {
         if (start == end) {
             return 0;
@@ -537,29 +787,67 @@ private:
         return end - start;
     }
 
-    inline size_t Copy(Type* dest, size_t start, size_t end, const Type* src) {
-        if (start == end) {
-            return 0;
-        }
-
-        assert(dest && src);
-        for (size_t cur_offset = start; cur_offset < end; cur_offset++) {
-            allocator_.construct(dest + cur_offset, src[cur_offset]);
-        }
+    inline size_t Copy(Type* dest, size_t start, size_t end, const Type* src) {
+        if (start == end) {
+            return 0;
+        }
+
+        assert(dest && src);
+        STDLIKE_TRACE_SCOPE(kCopy, (end - start) * sizeof(Type));
+        for (size_t cur_offset = start; cur_offset < end; cur_offset++) {
+            allocator_.construct(dest + cur_offset, src[cur_offset]);
+        }
+
+        return end - start;
+    }
+
+    /*
+     * Chunks of the range are handled by different threads, so the pages
+     * of a fresh buffer are first touched by the thread that fills them
+     */
+
+    size_t ParallelRelease(Type* data, size_t start, size_t end) {
+        if constexpr (!std::is_trivially_destructible_v<Type>) {
+            ParallelFor(start, end, kParallelThreshold, [this, data](size_t chunk_start, size_t chunk_end) {
+                this->Release(data, chunk_start, chunk_end);
+            });
+        }
+
+        return end - start;
+    }
+
+    size_t ParallelInitialize(Type* data, size_t start, size_t end, const Type& value) {
+        ParallelFor(start, end, kParallelThreshold, [this, data, &value](size_t chunk_start, size_t chunk_end) {
+            this->Initialize(data, chunk_start, chunk_end, value);
+        });
+
+        return end - start;
+    }
+
+    size_t ParallelCopy(Type* dest, size_t start, size_t end, const Type* src) {
+        ParallelFor(start, end, kParallelThreshold, [this, dest, src](size_t chunk_start, size_t chunk_end) {
+            this->Copy(dest, chunk_start, chunk_end, src);
+        });
 
         return end - start;
     }
 
 private:
-    Alloc allocator_ = {};
+    [[no_unique_address]] Alloc allocator_ = {};
     size_t size_ = 0;
     size_t capacity_ = 0;
     Type* data_ = nullptr;
+#if STDLIKE_ITERATOR_DEBUG
+    uint64_t generation_ = 0;
+#endif
 };
 
-template <>
-class Vector<bool, Allocator<bool>> {
+template <class Alloc>
+    requires detail::BitVectorAllocator<Alloc>
+class Vector<bool, Alloc> {
 public:
+    static constexpr BitOrder kBitOrder = detail::kBitOrderOf<Alloc>;
+
     /* BitReference */
 
     class BitReference {
@@ -635,311 +923,174 @@ public:
     };
 
 public:
-    /* Iterator */
+    /* Iterator and ConstIterator: a word and the offset of the bit in it, counted in kBitOrder */
 
-    class Iterator {
+    template <bool kConst>
+    class BitIterator {
     public:
         using iterator_category = std::random_access_iterator_tag;
         using difference_type = ptrdiff_t;
-        using iterator = Iterator;
-
         using value_type = bool;
-        using pointer = BitReference*;
-        using reference = BitReference;
-
-        Iterator() : data_(nullptr), shift_(0), container_(nullptr) {
-        }
+        using pointer = void;
+        using reference = std::conditional_t<kConst, bool, BitReference>;
 
-        Iterator(uint32_t* data, uint32_t shift, Vector* container = nullptr)
-            : data_(data), shift_(shift), container_(container) {
-        }
+        using Word = std::conditional_t<kConst, const uint32_t, uint32_t>;
+        using Owner = std::conditional_t<kConst, const Vector, Vector>;
 
-        Iterator(const Iterator& other) : data_(other.data_), shift_(other.shift_), container_(other.container_) {
-        }
+        BitIterator() = default;
 
-        ~Iterator() {
-            data_ = nullptr;
-            shift_ = 0;
-            container_ = nullptr;
+        BitIterator(Word* word, uint32_t offset, [[maybe_unused]] Owner* container) : word_(word), offset_(offset) {
+#if STDLIKE_ITERATOR_DEBUG
+            container_ = container;
+            generation_ = container->generation_;
+#endif
         }
 
-        Iterator& operator=(const Iterator& other) {
-            data_ = other.data_;
-            shift_ = other.shift_;
+        /* Iterator -> ConstIterator */
+        template <bool kOtherConst>
+            requires(kConst && !kOtherConst)
+        BitIterator(const BitIterator<kOtherConst>& other) : word_(other.word_), offset_(other.offset_) {
+#if STDLIKE_ITERATOR_DEBUG
             container_ = other.container_;
-            return *this;
+            generation_ = other.generation_;
+#endif
         }
 
         reference operator*() const {
-            assert(data_ && container_);
-            assert((data_ < container_->End().data_) ||
-                   (data_ == container_->End().data_ && shift_ > container_->End().shift_));
-            return reference(data_, 1u << shift_);
+            this->CheckDereferenceable(0);
+            if constexpr (kConst) {
+                return (*word_ & this->Mask()) != 0;
+            } else {
+                return reference(word_, this->Mask());
+            }
+        }
+
+        reference operator[](difference_type diff) const {
+            return *(*this + diff);
         }
 
-        Iterator& operator++() {
-            if (shift_-- == 0) {
-                shift_ = 31;
-                data_++;
+        BitIterator& operator++() {
+            if (++offset_ == 32) {
+                offset_ = 0;
+                word_++;
             }
             return *this;
         }
 
-        Iterator operator++(int) {
-            Iterator old = *this;
+        BitIterator operator++(int) {
+            BitIterator old = *this;
             ++(*this);
             return old;
         }
 
-        Iterator& operator--() {
-            if (shift_++ == 31) {
-                shift_ = 0;
-                data_--;
+        BitIterator& operator--() {
+            if (offset_-- == 0) {
+                offset_ = 31;
+                word_--;
             }
             return *this;
         }
 
-        Iterator operator--(int) {
-            Iterator old = *this;
+        BitIterator operator--(int) {
+            BitIterator old = *this;
             --(*this);
             return old;
         }
 
-        Iterator& operator+=(difference_type diff) {
-            if (diff > 0) {
-                while (diff--) {
-                    ++(*this);
-                }
-            } else {
-                while (diff++) {
-                    --(*this);
-                }
-            }
+        /* Arithmetic shift floors, so negative steps borrow whole words */
+        BitIterator& operator+=(difference_type diff) {
+            difference_type bit = static_cast<difference_type>(offset_) + diff;
+            word_ += bit >> 5;
+            offset_ = static_cast<uint32_t>(bit & 31);
             return *this;
         }
 
-        Iterator& operator-=(difference_type diff) {
+        BitIterator& operator-=(difference_type diff) {
             return *this += -diff;
         }
 
-        reference operator[](difference_type diff) const {
-            return *(*this + diff);
-        }
-
-        friend difference_type operator-(const Iterator& lhs, const Iterator& rhs) {
-            return (32 * (lhs.data_ - rhs.data_) + rhs.shift_ - lhs.shift_);
-        }
-
-        friend Iterator operator+(const Iterator& iter, difference_type diff) {
-            Iterator temp = iter;
-            return temp += diff;
-        }
-
-        friend Iterator operator+(difference_type diff, const Iterator& iter) {
-            return iter + diff;
+        friend BitIterator operator+(BitIterator iter, difference_type diff) {
+            return iter += diff;
         }
 
-        friend Iterator operator-(const Iterator& iter, difference_type diff) {
-            Iterator temp = iter;
-            return temp -= diff;
+        friend BitIterator operator+(difference_type diff, BitIterator iter) {
+            return iter += diff;
         }
 
-        friend bool operator==(const Iterator& lhs, const Iterator& rhs) {
-            return (lhs.data_ == rhs.data_ && lhs.shift_ == rhs.shift_);
+        friend BitIterator operator-(BitIterator iter, difference_type diff) {
+            return iter -= diff;
         }
 
-        friend bool operator!=(const Iterator& lhs, const Iterator& rhs) {
-            return !(lhs == rhs);
-        }
-
-        friend bool operator<(const Iterator& lhs, const Iterator& rhs) {
-            return (lhs.data_ < rhs.data_) || (lhs.data_ == rhs.data_ && lhs.shift_ > rhs.shift_);
-        }
-
-        friend bool operator>(const Iterator& lhs, const Iterator& rhs) {
-            return (rhs < lhs);
+        friend difference_type operator-(const BitIterator& lhs, const BitIterator& rhs) {
+            return 32 * (lhs.word_ - rhs.word_) + static_cast<difference_type>(lhs.offset_) -
+                   static_cast<difference_type>(rhs.offset_);
         }
 
-        friend bool operator<=(const Iterator& lhs, const Iterator& rhs) {
-            return !(lhs > rhs);
+        friend bool operator==(const BitIterator& lhs, const BitIterator& rhs) {
+            return lhs.word_ == rhs.word_ && lhs.offset_ == rhs.offset_;
         }
 
-        friend bool operator>=(const Iterator& lhs, const Iterator& rhs) {
-            return !(lhs < rhs);
+        friend std::strong_ordering operator<=>(const BitIterator& lhs, const BitIterator& rhs) {
+            if (lhs.word_ != rhs.word_) {
+                return lhs.word_ <=> rhs.word_;
+            }
+            return lhs.offset_ <=> rhs.offset_;
         }
 
-        friend auto operator<=>(const Iterator& lhs, const Iterator& rhs) = default;
-
     private:
-        uint32_t* data_ = nullptr;
-        uint32_t shift_ = 0;
-        Vector* container_ = nullptr;
+        template <bool>
+        friend class BitIterator;
+        friend class Vector;
+
+        uint32_t Mask() const {
+            return BitMask(offset_);
+        }
+
+        /* Position of the bit diff steps away, relative to the start of the vector */
+        void CheckDereferenceable([[maybe_unused]] difference_type diff) const {
+#if STDLIKE_ITERATOR_DEBUG
+            STDLIKE_ITERATOR_CHECK(container_, "iterator does not belong to a vector");
+            STDLIKE_ITERATOR_CHECK(generation_ == container_->generation_,
+                                   "iterator used after the vector reallocated");
+            difference_type pos = 32 * (word_ - container_->data_) + static_cast<difference_type>(offset_) + diff;
+            STDLIKE_ITERATOR_CHECK(pos >= 0 && static_cast<size_t>(pos) < container_->size_,
+                                   "dereferenced iterator is out of range");
+#endif
+        }
+
+        Word* word_ = nullptr;
+        uint32_t offset_ = 0;
+#if STDLIKE_ITERATOR_DEBUG
+        Owner* container_ = nullptr;
+        uint64_t generation_ = 0;
+#endif
     };
 
+    using Iterator = BitIterator<false>;
+    using ConstIterator = BitIterator<true>;
+
     Iterator Begin() {
-        return Iterator(data_, 31, this); // ! magic const
+        return Iterator(data_, 0, this);
     }
 
     Iterator End() {
-        return Iterator(data_ + DivideByThirtyTwo(size_), 31 - ThirtyTwoModulo(size_), this);
+        return Iterator(data_ + DivideByThirtyTwo(size_), ThirtyTwoModulo(size_), this);
     }
 
-    Iterator begin() {
-        return Begin();
+    ConstIterator Begin() const {
+        return ConstIterator(data_, 0, this);
     }
 
-    Iterator end() {
-        return End();
+    ConstIterator End() const {
+        return ConstIterator(data_ + DivideByThirtyTwo(size_), ThirtyTwoModulo(size_), this);
     }
 
-    /* ConstIterator */
-
-    class ConstIterator {
-    public:
-        using iterator_category = std::random_access_iterator_tag;
-        using difference_type = ptrdiff_t;
-        using const_iterator = ConstIterator;
-
-        using value_type = bool;
-        using pointer = BitReference*;
-        using reference = BitReference;
-
-        ConstIterator() : data_(nullptr), shift_(0), container_(nullptr) {
-        }
-
-        ConstIterator(uint32_t* data, uint32_t shift, const Vector* container = nullptr)
-            : data_(data), shift_(shift), container_(container) {
-        }
-
-        ConstIterator(const ConstIterator& other)
-            : data_(other.data_), shift_(other.shift_), container_(other.container_) {
-        }
-
-        ~ConstIterator() {
-            data_ = nullptr;
-            shift_ = 0;
-            container_ = nullptr;
-        }
-
-        ConstIterator& operator=(const ConstIterator& other) {
-            data_ = other.data_;
-            shift_ = other.shift_;
-            container_ = other.container_;
-            return *this;
-        }
-
-        const reference operator*() const {
-            assert(data_ && container_);
-            assert((data_ < container_->End().data_) ||
-                   (data_ == container_->End().data_ && shift_ > container_->End().shift_));
-            return reference(data_, 1u << shift_);
-        }
-
-        ConstIterator& operator++() {
-            if (shift_-- == 0) {
-                shift_ = 31;
-                data_++;
-            }
-            return *this;
-        }
-
-        ConstIterator operator++(int) {
-            ConstIterator old = *this;
-            ++(*this);
-            return old;
-        }
-
-        ConstIterator& operator--() {
-            if (shift_++ == 31) {
-                shift_ = 0;
-                data_--;
-            }
-            return *this;
-        }
-
-        ConstIterator operator--(int) {
-            ConstIterator old = *this;
-            --(*this);
-            return old;
-        }
-
-        ConstIterator& operator+=(difference_type diff) {
-            if (diff > 0) {
-                while (diff--) {
-                    ++(*this);
-                }
-            } else {
-                while (diff++) {
-                    --(*this);
-                }
-            }
-            return *this;
-        }
-
-        ConstIterator& operator-=(difference_type diff) {
-            return *this += -diff;
-        }
-
-        const reference operator[](difference_type diff) const {
-            return *(*this + diff);
-        }
-
-        friend difference_type operator-(const ConstIterator& lhs, const ConstIterator& rhs) {
-            return (32 * (lhs.data_ - rhs.data_) + rhs.shift_ - lhs.shift_);
-        }
-
-        friend ConstIterator operator+(const ConstIterator& iter, difference_type diff) {
-            ConstIterator temp = iter;
-            return temp += diff;
-        }
-
-        friend ConstIterator operator+(difference_type diff, const ConstIterator& iter) {
-            return iter + diff;
-        }
-
-        friend ConstIterator operator-(const ConstIterator& iter, difference_type diff) {
-            ConstIterator temp = iter;
-            return temp -= diff;
-        }
-
-        friend bool operator==(const ConstIterator& lhs, const ConstIterator& rhs) {
-            return (lhs.data_ == rhs.data_ && lhs.shift_ == rhs.shift_);
-        }
-
-        friend bool operator!=(const ConstIterator& lhs, const ConstIterator& rhs) {
-            return !(lhs == rhs);
-        }
-
-        friend bool operator<(const ConstIterator& lhs, const ConstIterator& rhs) {
-            return (lhs.data_ < rhs.data_) || (lhs.data_ == rhs.data_ && lhs.shift_ > rhs.shift_);
-        }
-
-        friend bool operator>(const ConstIterator& lhs, const ConstIterator& rhs) {
-            return (rhs < lhs);
-        }
-
-        friend bool operator<=(const ConstIterator& lhs, const ConstIterator& rhs) {
-            return !(lhs > rhs);
-        }
-
-        friend bool operator>=(const ConstIterator& lhs, const ConstIterator& rhs) {
-            return !(lhs < rhs);
-        }
-
-        friend auto operator<=>(const ConstIterator& lhs, const ConstIterator& rhs) = default;
-
-    private:
-        uint32_t* data_ = nullptr;
-        uint32_t shift_ = 0;
-        const Vector* container_ = nullptr;
-    };
-
-    ConstIterator Begin() const {
-        return ConstIterator(data_, 31, this);
+    Iterator begin() {
+        return Begin();
     }
 
-    ConstIterator End() const {
-        return ConstIterator(data_ + DivideByThirtyTwo(size_), 31 - ThirtyTwoModulo(size_), this);
+    Iterator end() {
+        return End();
     }
 
     ConstIterator begin() const {
@@ -961,17 +1112,56 @@ public:
     Vector() : size_(0), capacity_(0), data_(nullptr) {
     }
 
-    explicit Vector(size_t init_size, bool value = false)
+    /* false bits come with the zeroed buffer */
+    explicit Vector(size_t init_size, bool value = false STDLIKE_SITE_PARAM)
+        : size_(init_size)
+        , capacity_(RoundUpToThirtyTwoMultiple(init_size))
+        , data_(AllocateWords(capacity_, !value)) {
+
+        STDLIKE_INSTRUMENT_HOOK(Allocation(site, BitsToWords(capacity_) * sizeof(uint32_t)));
+        STDLIKE_INSTRUMENT_HOOK(CapacityChange(site, instrument::Event::kConstruct, capacity_ / 8, size_ / 8, 0));
+        if (value) {
+            this->Initialize(data_, 0, size_, value);
+        }
+    }
+
+    /* The bits are left unspecified */
+    Vector(DefaultInit, size_t init_size STDLIKE_SITE_PARAM)
         : size_(init_size)
         , capacity_(RoundUpToThirtyTwoMultiple(init_size))
-        , data_(new uint32_t[BitsToBytes(capacity_)]()) {
+        , data_(AllocateWords(capacity_, false)) {
+
+        STDLIKE_INSTRUMENT_HOOK(Allocation(site, BitsToWords(capacity_) * sizeof(uint32_t)));
+        STDLIKE_INSTRUMENT_HOOK(CapacityChange(site, instrument::Event::kConstruct, capacity_ / 8, size_ / 8, 0));
+    }
+
+    /* Copies an external bitmap, byte-aligned spans are copied with memcpy */
+    explicit Vector(ConstBitSpan span STDLIKE_SITE_PARAM)
+        requires(kBitOrder == BitOrder::kLsbFirst && std::endian::native == std::endian::little)
+        : size_(span.Size())
+        , capacity_(RoundUpToThirtyTwoMultiple(span.Size()))
+        , data_(AllocateWords(capacity_, true)) {
+
+        STDLIKE_INSTRUMENT_HOOK(Allocation(site, BitsToWords(capacity_) * sizeof(uint32_t)));
+        STDLIKE_INSTRUMENT_HOOK(CapacityChange(site, instrument::Event::kConstruct, capacity_ / 8, size_ / 8, 0));
+        if (span.Offset() == 0) {
+            if (size_ > 0) {
+                std::memcpy(data_, span.Data(), span.SizeInBytes());
+            }
+            return;
+        }
 
-        this->Initialize(data_, 0, size_, value);
+        BitSpan bits = this->Span();
+        for (size_t pos = 0; pos < size_; pos++) {
+            bits.Set(pos, span[pos]);
+        }
     }
 
-    Vector(const Vector& other)
-        : size_(other.Size()), capacity_(other.Capacity()), data_(new uint32_t[BitsToBytes(other.Capacity())]()) {
+    Vector(const Vector& other STDLIKE_SITE_PARAM)
+        : size_(other.Size()), capacity_(other.Capacity()), data_(AllocateWords(other.Capacity(), false)) {
 
+        STDLIKE_INSTRUMENT_HOOK(Allocation(site, BitsToWords(capacity_) * sizeof(uint32_t)));
+        STDLIKE_INSTRUMENT_HOOK(CapacityChange(site, instrument::Event::kConstruct, capacity_ / 8, size_ / 8, 0));
         this->Copy(data_, 0, other.Size(), other.Data());
     }
 
@@ -979,20 +1169,32 @@ public:
         *this = std::move(temp);
     }
 
+    /* Lazy views and expressions (see views.hpp) with elements convertible to bool */
+    template <typename Expr>
+        requires requires(const Expr& expr, Vector& vec) { expr.EvaluateInto(vec); }
+    Vector(const Expr& expr) : Vector() {
+        expr.EvaluateInto(*this);
+    }
+
     ~Vector() {
-        delete[] data_;
+        std::free(data_);
         size_ = 0;
         capacity_ = 0;
         data_ = nullptr;
     }
 
     Vector& operator=(const Vector& other) {
-        this->~Vector();
+        if (this == &other) {
+            return *this;
+        }
+
+        uint32_t* new_data = AllocateWords(other.Capacity(), false);
+        this->Copy(new_data, 0, other.Size(), other.Data());
+        std::free(data_);
         size_ = other.Size();
         capacity_ = other.Capacity();
-        data_ = new uint32_t[BitsToBytes(other.Capacity())]();
-
-        this->Copy(data_, 0, other.Size(), other.Data());
+        data_ = new_data;
+        this->Invalidate();
 
         return *this;
     }
@@ -1001,11 +1203,55 @@ public:
         std::swap(temp.size_, size_);
         std::swap(temp.capacity_, capacity_);
         std::swap(temp.data_, data_);
+        temp.Invalidate();
+        this->Invalidate();
 
         return *this;
     }
 
-    bool operator==(const Vector&) const = delete;
+    /* The expression may read this vector, so it is evaluated aside first */
+    template <typename Expr>
+        requires requires(const Expr& expr, Vector& vec) { expr.EvaluateInto(vec); }
+    Vector& operator=(const Expr& expr) {
+        Vector temp(expr);
+        return *this = std::move(temp);
+    }
+
+    /* Comparison, whole words at a time with the bits past the size masked out */
+
+    friend bool operator==(const Vector& lhs, const Vector& rhs) {
+        if (lhs.size_ != rhs.size_) {
+            return false;
+        }
+
+        size_t full_words = DivideByThirtyTwo(lhs.size_);
+        if (full_words > 0 && std::memcmp(lhs.data_, rhs.data_, full_words * sizeof(uint32_t)) != 0) {
+            return false;
+        }
+
+        uint32_t tail_bits = ThirtyTwoModulo(lhs.size_);
+        return tail_bits == 0 || ((lhs.data_[full_words] ^ rhs.data_[full_words]) & RangeMask(0, tail_bits)) == 0;
+    }
+
+    /* Lexicographic with false < true. MSB-first words compare as unsigned numbers. */
+    friend std::strong_ordering operator<=>(const Vector& lhs, const Vector& rhs) {
+        size_t common = std::min(lhs.size_, rhs.size_);
+        size_t full_words = DivideByThirtyTwo(common);
+        size_t word = (full_words == 0) ? 0 : detail::MismatchIndex(lhs.data_, rhs.data_, full_words);
+        if (word < full_words) {
+            return CompareWords(lhs.data_[word], rhs.data_[word]);
+        }
+
+        uint32_t tail_bits = ThirtyTwoModulo(common);
+        if (tail_bits != 0) {
+            uint32_t mask = RangeMask(0, tail_bits);
+            if (std::strong_ordering order = CompareWords(lhs.data_[word] & mask, rhs.data_[word] & mask); order != 0) {
+                return order;
+            }
+        }
+
+        return lhs.size_ <=> rhs.size_;
+    }
 
     /* Capacity */
 
@@ -1021,15 +1267,18 @@ public:
         return capacity_;
     }
 
-    void Reserve(size_t new_capacity) {
+    void Reserve(size_t new_capacity STDLIKE_SITE_PARAM) {
+        STDLIKE_INSTRUMENT_HOOK(CapacityChange(site, instrument::Event::kReserve, std::max(new_capacity, capacity_) / 8,
+                                               size_ / 8, 0));
         if (new_capacity > capacity_) {
-            this->ChangeCapacity(RoundUpToThirtyTwoMultiple(new_capacity));
+            this->ChangeCapacity(RoundUpToThirtyTwoMultiple(new_capacity) STDLIKE_SITE_ARG);
         }
     }
 
-    void ShrinkToFit() {
+    void ShrinkToFit(STDLIKE_SITE_PARAM_FIRST) {
+        STDLIKE_INSTRUMENT_HOOK(CapacityChange(site, instrument::Event::kShrinkToFit, size_ / 8, size_ / 8, 0));
         if (capacity_ > size_) {
-            this->ChangeCapacity(RoundUpToThirtyTwoMultiple(size_));
+            this->ChangeCapacity(RoundUpToThirtyTwoMultiple(size_) STDLIKE_SITE_ARG);
         }
     }
 
@@ -1042,7 +1291,7 @@ public:
 
     BitReference At(size_t pos) {
         assert(pos < size_);
-        return BitReference(data_ + DivideByThirtyTwo(pos), 1u << (31u - ThirtyTwoModulo(pos)));
+        return BitReference(data_ + DivideByThirtyTwo(pos), BitMask(ThirtyTwoModulo(pos)));
     }
 
     const BitReference operator[](size_t pos) const {
@@ -1051,7 +1300,7 @@ public:
     }
 
     BitReference operator[](size_t pos) {
-        return BitReference(data_ + DivideByThirtyTwo(pos), 1u << (31u - ThirtyTwoModulo(pos)));
+        return BitReference(data_ + DivideByThirtyTwo(pos), BitMask(ThirtyTwoModulo(pos)));
     }
 
     const BitReference Front() const {
@@ -1081,19 +1330,42 @@ public:
         return data_;
     }
 
+    /* Bytes holding the bits, the last one may be partly used */
+    size_t SizeInBytes() const {
+        return (size_ + 7) / 8;
+    }
+
+    /*
+     * Zero-copy view of the bits as an Arrow-style bitmap, valid until the
+     * next reallocation. Needs LSB-first words on a little-endian machine.
+     */
+    BitSpan Span()
+        requires(kBitOrder == BitOrder::kLsbFirst && std::endian::native == std::endian::little)
+    {
+        return BitSpan(reinterpret_cast<uint8_t*>(data_), size_);
+    }
+
+    ConstBitSpan Span() const
+        requires(kBitOrder == BitOrder::kLsbFirst && std::endian::native == std::endian::little)
+    {
+        return ConstBitSpan(reinterpret_cast<const uint8_t*>(data_), size_);
+    }
+
     /* Modifiers */
 
     void Clear() {
         size_ = 0;
     }
 
-    Iterator Insert(Iterator pos, bool value) {
+    Iterator Insert(Iterator pos, bool value STDLIKE_SITE_PARAM) {
+        STDLIKE_ITERATOR_CHECK(this->Owns(pos), "Insert position is not a current iterator of this vector");
         ptrdiff_t offset = pos - Begin();
         if (size_ >= capacity_) { /* Invalidates Iterators */
-            this->Reserve(size_ ? size_ * 2 : 1);
+            this->ChangeCapacity(size_ ? size_ * 2 : 1 STDLIKE_SITE_ARG);
         }
 
         pos = Begin() + offset;
+        STDLIKE_TRACE_SCOPE(kShift, (size_ - static_cast<size_t>(offset)) / 8);
         size_++;
         for (Iterator it = End() - 1; it > pos; it--) {
             *it = stdlike::move(*(it - 1));
@@ -1104,10 +1376,12 @@ public:
     }
 
     Iterator Erase(Iterator pos) {
+        STDLIKE_ITERATOR_CHECK(this->Owns(pos), "Erase position is not a current iterator of this vector");
         if (pos >= End()) {
             return End();
         }
 
+        STDLIKE_TRACE_SCOPE(kShift, static_cast<size_t>(End() - pos) / 8);
         for (Iterator it = pos; it < End() - 1; it++) {
             *it = stdlike::move(*(it + 1));
         }
@@ -1116,8 +1390,8 @@ public:
         return pos;
     }
 
-    void PushBack(bool value) {
-        this->Insert(End(), value);
+    void PushBack(bool value STDLIKE_SITE_PARAM) {
+        this->Insert(End(), value STDLIKE_SITE_ARG);
     }
 
     void PopBack() {
@@ -1126,12 +1400,39 @@ public:
         }
     }
 
-    void Resize(size_t new_size, bool value = false) {
-        if (size_ < new_size) {
-            this->Reserve(RoundUpToThirtyTwoMultiple(new_size));
+    void Resize(size_t new_size, bool value = false STDLIKE_SITE_PARAM) {
+        if (size_ < new_size && new_size > capacity_ && !value) {
+            /* The tail of a zeroed buffer already holds the value */
+            this->ChangeCapacity(new_size, true STDLIKE_SITE_ARG);
+        } else if (size_ < new_size) {
+            if (new_size > capacity_) {
+                this->ChangeCapacity(new_size STDLIKE_SITE_ARG);
+            }
             this->Initialize(data_, size_, new_size, value);
-            size_ = new_size;
         }
+        size_ = new_size;
+    }
+
+    /* Resize for a buffer that is about to be overwritten, new bits are left unspecified */
+    void ResizeForOverwrite(size_t new_size STDLIKE_SITE_PARAM) {
+        if (new_size > capacity_) {
+            this->ChangeCapacity(new_size STDLIKE_SITE_ARG);
+        }
+        size_ = new_size;
+    }
+
+    /*
+     * Grows by bits_n unspecified bits and returns an iterator to the first
+     * of them. Capacity at least doubles, so appending in pieces stays linear.
+     */
+    Iterator AppendUninitialized(size_t bits_n STDLIKE_SITE_PARAM) {
+        size_t old_size = size_;
+        if (size_ + bits_n > capacity_) {
+            this->ChangeCapacity(std::max(size_ + bits_n, capacity_ * 2) STDLIKE_SITE_ARG);
+        }
+
+        size_ += bits_n;
+        return Begin() + static_cast<ptrdiff_t>(old_size);
     }
 
     void Swap(Vector& other) {
@@ -1140,31 +1441,112 @@ public:
         *this = stdlike::move(temp);
     }
 
+    /* Bulk bit operations, work on whole words where possible */
+
+    void Fill(size_t start, size_t end, bool value) {
+        assert(start <= end && end <= size_);
+        this->Initialize(data_, start, end, value);
+    }
+
+    size_t Count() const {
+        return this->Count(0, size_);
+    }
+
+    size_t Count(size_t start, size_t end) const {
+        assert(start <= end && end <= size_);
+        if (start == end) {
+            return 0;
+        }
+
+        size_t first_word = DivideByThirtyTwo(start);
+        size_t last_word = DivideByThirtyTwo(end - 1);
+        uint32_t head_bit = ThirtyTwoModulo(start);
+        uint32_t tail_bit = ThirtyTwoModulo(end - 1) + 1;
+
+        if (first_word == last_word) {
+            return static_cast<size_t>(std::popcount(data_[first_word] & RangeMask(head_bit, tail_bit)));
+        }
+
+        size_t count = static_cast<size_t>(std::popcount(data_[first_word] & RangeMask(head_bit, 32)));
+        for (size_t word = first_word + 1; word < last_word; word++) {
+            count += static_cast<size_t>(std::popcount(data_[word]));
+        }
+
+        return count + static_cast<size_t>(std::popcount(data_[last_word] & RangeMask(0, tail_bit)));
+    }
+
 private:
     /* Helper functions */
 
-    void ChangeCapacity(size_t new_capacity) {
+    void ChangeCapacity(size_t new_capacity STDLIKE_SITE_PARAM) {
+        this->ChangeCapacity(new_capacity, false STDLIKE_SITE_ARG);
+    }
+
+    /* zeroed: the bits of the new buffer past the copied ones are zero */
+    void ChangeCapacity(size_t new_capacity, bool zeroed STDLIKE_SITE_PARAM) {
         new_capacity = RoundUpToThirtyTwoMultiple(new_capacity);
-        uint32_t* new_data = new uint32_t[BitsToBytes(new_capacity)];
+        STDLIKE_INSTRUMENT_HOOK(Allocation(site, BitsToWords(new_capacity) * sizeof(uint32_t)));
+        STDLIKE_INSTRUMENT_HOOK(CapacityChange(site,
+                                               data_ ? instrument::Event::kReallocation : instrument::Event::kConstruct,
+                                               new_capacity / 8, size_ / 8, std::min(size_, new_capacity) / 8));
+
+        STDLIKE_TRACE_SCOPE(kReallocation, new_capacity / 8);
+        uint32_t* new_data = AllocateWords(new_capacity, zeroed);
         size_t new_size = this->Copy(new_data, 0, std::min(size_, new_capacity), data_);
-        this->~Vector();
+        std::free(data_);
 
         size_ = new_size;
         capacity_ = new_capacity;
         data_ = new_data;
+        this->Invalidate();
+    }
+
+#if STDLIKE_ITERATOR_DEBUG
+    /* Every iterator taken before this call is stale */
+    void Invalidate() {
+        generation_++;
+    }
+
+    /* Insert/Erase position: a current iterator of this vector in [Begin(), End()] */
+    bool Owns(const ConstIterator& pos) const {
+        return pos.container_ == this && pos.generation_ == generation_ && pos.word_ >= data_ &&
+               32 * static_cast<size_t>(pos.word_ - data_) + pos.offset_ <= size_;
+    }
+#else
+    void Invalidate() {
     }
+#endif
 
     inline size_t Initialize(uint32_t* data, size_t start, size_t end, bool value) {
+        if (start == end) {
+            return 0;
+        }
+
         assert(data);
-        for (size_t cur_pos = start; cur_pos < end; cur_pos++) {
-            SetValue(data, cur_pos, value);
+        size_t first_word = DivideByThirtyTwo(start);
+        size_t last_word = DivideByThirtyTwo(end - 1);
+        uint32_t head_mask = RangeMask(ThirtyTwoModulo(start), 32);
+        uint32_t tail_mask = RangeMask(0, ThirtyTwoModulo(end - 1) + 1);
+
+        if (first_word == last_word) {
+            SetMasked(data + first_word, head_mask & tail_mask, value);
+            return end - start;
         }
 
+        SetMasked(data + first_word, head_mask, value);
+        std::fill(data + first_word + 1, data + last_word, value ? ~0u : 0u);
+        SetMasked(data + last_word, tail_mask, value);
+
         return end - start;
     }
 
     inline size_t Copy(uint32_t* dest, size_t start, size_t end, const uint32_t* src) {
+        if (start == end) {
+            return 0;
+        }
+
         assert(dest && src);
+        STDLIKE_TRACE_SCOPE(kCopy, (end - start) / 8);
         for (size_t cur_pos = start; cur_pos < end; cur_pos++) {
             SetValue(dest, cur_pos, GetValue(src, cur_pos));
         }
@@ -1173,27 +1555,73 @@ private:
     }
 
     static inline bool GetValue(const uint32_t* data, size_t pos) {
-        BitReference bit_ref(const_cast<uint32_t*>(data) + DivideByThirtyTwo(pos), 1u << (31u - ThirtyTwoModulo(pos)));
+        BitReference bit_ref(const_cast<uint32_t*>(data) + DivideByThirtyTwo(pos), BitMask(ThirtyTwoModulo(pos)));
         return bool(bit_ref);
     }
 
     static inline void SetValue(uint32_t* data, size_t pos, bool value) {
-        BitReference bit_ref(data + DivideByThirtyTwo(pos), 1u << (31u - ThirtyTwoModulo(pos)));
+        BitReference bit_ref(data + DivideByThirtyTwo(pos), BitMask(ThirtyTwoModulo(pos)));
         bit_ref = value;
     }
 
+    static inline void SetMasked(uint32_t* word, uint32_t mask, bool value) {
+        if (value) {
+            *word |= mask;
+        } else {
+            *word &= ~mask;
+        }
+    }
+
+    static inline uint32_t BitMask(uint32_t offset) {
+        return detail::BitMask<kBitOrder>(offset);
+    }
+
+    static inline uint32_t RangeMask(uint32_t first_bit, uint32_t last_bit) {
+        return detail::BitRangeMask<kBitOrder>(first_bit, last_bit);
+    }
+
+    /* Lexicographic order of two words, the first differing bit decides */
+    static inline std::strong_ordering CompareWords(uint32_t lhs, uint32_t rhs) {
+        if constexpr (kBitOrder == BitOrder::kMsbFirst) {
+            return lhs <=> rhs;
+        } else {
+            uint32_t diff = lhs ^ rhs;
+            if (diff == 0) {
+                return std::strong_ordering::equal;
+            }
+            return (lhs & diff & (~diff + 1)) != 0 ? std::strong_ordering::greater : std::strong_ordering::less;
+        }
+    }
+
     /* Utility functions */
 
-    static inline uint64_t BitsToBytes(uint64_t bits) {
-        return bits >> 3;
+    /*
+     * Words come from malloc/calloc, large calloc blocks are fresh pages the
+     * kernel zeroes on first touch
+     */
+    static uint32_t* AllocateWords(size_t bits, bool zeroed) {
+        size_t words_n = BitsToWords(bits);
+        if (words_n == 0) {
+            return nullptr;
+        }
+
+        void* words = zeroed ? std::calloc(words_n, sizeof(uint32_t)) : std::malloc(words_n * sizeof(uint32_t));
+        if (!words) {
+            throw std::bad_alloc();
+        }
+        return static_cast<uint32_t*>(words);
+    }
+
+    static inline uint64_t BitsToWords(uint64_t bits) {
+        return (bits + 31) >> 5;
     }
 
-    static inline uint32_t RoundUpToThirtyTwoMultiple(uint64_t num) {
-        return (num + 31) & ~31u;
+    static inline uint64_t RoundUpToThirtyTwoMultiple(uint64_t num) {
+        return (num + 31) & ~uint64_t(31);
     }
 
-    static inline uint32_t DivideByThirtyTwo(uint64_t num) {
-        return static_cast<uint32_t>(num >> 5);
+    static inline size_t DivideByThirtyTwo(size_t num) {
+        return num >> 5;
     }
 
     static inline uint32_t ThirtyTwoModulo(uint64_t num) {
@@ -1202,22 +1630,62 @@ private:
 
 private:
     size_t size_ = 0;     /* in bits */
-    size_t capacity_ = 0; /* in bits, always == 0 (mod 8), at least 8 */
+    size_t capacity_ = 0; /* in bits, always == 0 (mod 32) */
     uint32_t* data_ = nullptr;
+#if STDLIKE_ITERATOR_DEBUG
+    uint64_t generation_ = 0;
+#endif
 };
 
-template <class Type>
-std::ostream& operator<<(std::ostream& stream, const Vector<Type>& vec) {
-    for (size_t i = 0; i < vec.Size(); i++) {
-        stream << vec.At(i);
-        if (i != vec.Size() - 1) {
-            stream << " ";
+template <BitOrder kOrder>
+using BitVector = Vector<bool, BitAllocator<kOrder>>;
+
+/* Hashes, consistent with operator== */
+
+template <typename Type, class Alloc>
+    requires(detail::BytewiseComparable<Type> || requires(const Type& value) { std::hash<Type>()(value); })
+struct Hash<Vector<Type, Alloc>> {
+    uint64_t operator()(const Vector<Type, Alloc>& vec) const {
+        if constexpr (detail::BytewiseComparable<Type>) {
+            return Hash64(vec.Data(), vec.Size() * sizeof(Type));
+        } else {
+            uint64_t hash = Hash64(nullptr, 0, vec.Size());
+            for (size_t pos = 0; pos < vec.Size(); pos++) {
+                hash = detail::HashMergeRound(hash, std::hash<Type>()(vec[pos]));
+            }
+            return hash;
         }
     }
+};
 
-    return stream;
-}
+template <class Alloc>
+    requires detail::BitVectorAllocator<Alloc>
+struct Hash<Vector<bool, Alloc>> {
+    uint64_t operator()(const Vector<bool, Alloc>& vec) const {
+        size_t full_words = vec.Size() / 32;
+        uint64_t hash = Hash64(vec.Data(), full_words * sizeof(uint32_t), vec.Size());
+
+        uint32_t tail_bits = vec.Size() % 32;
+        if (tail_bits == 0) {
+            return hash;
+        }
+
+        uint32_t tail = vec.Data()[full_words] & detail::BitRangeMask<Vector<bool, Alloc>::kBitOrder>(0, tail_bits);
+        return Hash64(&tail, sizeof(tail), hash);
+    }
+};
 
 }  // namespace stdlike
 
+template <typename Type, class Alloc>
+    requires requires(const stdlike::Vector<Type, Alloc>& vec) { stdlike::Hash<stdlike::Vector<Type, Alloc>>()(vec); }
+struct std::hash<stdlike::Vector<Type, Alloc>> {
+    size_t operator()(const stdlike::Vector<Type, Alloc>& vec) const {
+        return static_cast<size_t>(stdlike::Hash<stdlike::Vector<Type, Alloc>>()(vec));
+    }
+};
+
+/* Text output (operator<<, Format, Parse) */
+#include <stdlike/format.hpp>
+
 #endif  // STDLIKE_VECTOR_HPP
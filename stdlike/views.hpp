@@ -0,0 +1,362 @@
+#ifndef STDLIKE_VIEWS_HPP
+#define STDLIKE_VIEWS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include <stdlike/vector.hpp>
+
+namespace stdlike {
+
+/*
+ * Lazy, non-owning views over Vector. Nothing is computed until a view is
+ * assigned into a Vector, then the whole chain runs as one loop. Views
+ * keep pointers into their source vectors, which must outlive them.
+ *
+ * Indexed views (Map, Zip, Slice, Stride, arithmetic) know their size and
+ * are evaluated by index, Filter only supports pushing elements forward.
+ */
+
+template <typename Derived>
+class ViewBase;
+
+template <typename View>
+concept IsView = std::is_base_of_v<ViewBase<View>, View>;
+
+template <typename View>
+concept IndexedView = IsView<View> && requires(const View& view, size_t pos) {
+    { view.Size() } -> std::convertible_to<size_t>;
+    view[pos];
+};
+
+template <typename Derived>
+class ViewBase {
+public:
+    template <typename Type, class Alloc>
+    void EvaluateInto(Vector<Type, Alloc>& out) const {
+        const Derived& self = static_cast<const Derived&>(*this);
+        if constexpr (IndexedView<Derived> && std::is_same_v<Type, bool>) {
+            /* Bits are not addressable, they are appended one by one */
+            size_t size = self.Size();
+            out.Reserve(out.Size() + size);
+            for (size_t pos = 0; pos < size; pos++) {
+                out.PushBack(static_cast<bool>(self[pos]));
+            }
+        } else if constexpr (IndexedView<Derived>) {
+            size_t size = self.Size();
+            out.ResizeForOverwrite(size);
+
+            Type* data = out.Data();
+            for (size_t pos = 0; pos < size; pos++) {
+                data[pos] = self[pos];
+            }
+        } else {
+            self.ForEach([&out](const auto& value) {
+                out.PushBack(value);
+            });
+        }
+    }
+};
+
+/* Leaf view over the elements of a Vector */
+
+template <typename Type>
+class VectorView : public ViewBase<VectorView<Type>> {
+public:
+    VectorView(const Type* data, size_t size) : data_(data), size_(size) {
+    }
+
+    size_t Size() const {
+        return size_;
+    }
+
+    const Type& operator[](size_t pos) const {
+        return data_[pos];
+    }
+
+    template <typename Func>
+    void ForEach(Func&& func) const {
+        for (size_t pos = 0; pos < size_; pos++) {
+            func(data_[pos]);
+        }
+    }
+
+private:
+    const Type* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+/* Scalar operand of arithmetic expressions, has every size */
+
+template <typename Type>
+class ScalarView : public ViewBase<ScalarView<Type>> {
+public:
+    explicit ScalarView(Type value) : value_(value) {
+    }
+
+    size_t Size() const {
+        return std::numeric_limits<size_t>::max();
+    }
+
+    Type operator[](size_t) const {
+        return value_;
+    }
+
+private:
+    Type value_;
+};
+
+template <typename Type, class Alloc>
+    requires(!std::is_same_v<Type, bool>)
+VectorView<Type> AsView(const Vector<Type, Alloc>& vec) {
+    return VectorView<Type>(vec.Data(), vec.Size());
+}
+
+template <IsView View>
+View AsView(const View& view) {
+    return view;
+}
+
+template <typename Source>
+using ViewOf = decltype(AsView(std::declval<const Source&>()));
+
+/* Map */
+
+template <typename Source, typename Func>
+class MapView : public ViewBase<MapView<Source, Func>> {
+public:
+    MapView(Source source, Func func) : source_(source), func_(func) {
+    }
+
+    size_t Size() const
+        requires IndexedView<Source>
+    {
+        return source_.Size();
+    }
+
+    decltype(auto) operator[](size_t pos) const
+        requires IndexedView<Source>
+    {
+        return func_(source_[pos]);
+    }
+
+    template <typename Consumer>
+    void ForEach(Consumer&& consumer) const {
+        source_.ForEach([this, &consumer](const auto& value) {
+            consumer(func_(value));
+        });
+    }
+
+private:
+    Source source_;
+    Func func_;
+};
+
+template <typename Source, typename Func>
+MapView<ViewOf<Source>, Func> Map(const Source& source, Func func) {
+    return MapView<ViewOf<Source>, Func>(AsView(source), func);
+}
+
+/* Filter */
+
+template <typename Source, typename Predicate>
+class FilterView : public ViewBase<FilterView<Source, Predicate>> {
+public:
+    FilterView(Source source, Predicate pred) : source_(source), pred_(pred) {
+    }
+
+    template <typename Consumer>
+    void ForEach(Consumer&& consumer) const {
+        source_.ForEach([this, &consumer](const auto& value) {
+            if (pred_(value)) {
+                consumer(value);
+            }
+        });
+    }
+
+private:
+    Source source_;
+    Predicate pred_;
+};
+
+template <typename Source, typename Predicate>
+FilterView<ViewOf<Source>, Predicate> Filter(const Source& source, Predicate pred) {
+    return FilterView<ViewOf<Source>, Predicate>(AsView(source), pred);
+}
+
+/* Zip, elements are pairs, size is the shorter of the two */
+
+template <IndexedView First, IndexedView Second>
+class ZipView : public ViewBase<ZipView<First, Second>> {
+public:
+    ZipView(First first, Second second) : first_(first), second_(second) {
+    }
+
+    size_t Size() const {
+        return std::min<size_t>(first_.Size(), second_.Size());
+    }
+
+    auto operator[](size_t pos) const {
+        return std::make_pair(first_[pos], second_[pos]);
+    }
+
+    template <typename Consumer>
+    void ForEach(Consumer&& consumer) const {
+        for (size_t pos = 0; pos < Size(); pos++) {
+            consumer((*this)[pos]);
+        }
+    }
+
+private:
+    First first_;
+    Second second_;
+};
+
+template <typename First, typename Second>
+ZipView<ViewOf<First>, ViewOf<Second>> Zip(const First& first, const Second& second) {
+    return ZipView<ViewOf<First>, ViewOf<Second>>(AsView(first), AsView(second));
+}
+
+/* Slice [begin, end) and every step-th element */
+
+template <IndexedView Source>
+class SliceView : public ViewBase<SliceView<Source>> {
+public:
+    SliceView(Source source, size_t begin, size_t end, size_t step)
+        : source_(source), begin_(begin), size_(0), step_(step) {
+
+        assert(step_ > 0);
+        end = std::min<size_t>(end, source_.Size());
+        size_ = begin_ < end ? (end - begin_ + step_ - 1) / step_ : 0;
+    }
+
+    size_t Size() const {
+        return size_;
+    }
+
+    decltype(auto) operator[](size_t pos) const {
+        return source_[begin_ + pos * step_];
+    }
+
+    template <typename Consumer>
+    void ForEach(Consumer&& consumer) const {
+        for (size_t pos = 0; pos < size_; pos++) {
+            consumer((*this)[pos]);
+        }
+    }
+
+private:
+    Source source_;
+    size_t begin_ = 0;
+    size_t size_ = 0;
+    size_t step_ = 1;
+};
+
+template <typename Source>
+SliceView<ViewOf<Source>> Slice(const Source& source, size_t begin, size_t end) {
+    return SliceView<ViewOf<Source>>(AsView(source), begin, end, 1);
+}
+
+template <typename Source>
+SliceView<ViewOf<Source>> Stride(const Source& source, size_t step) {
+    return SliceView<ViewOf<Source>>(AsView(source), 0, std::numeric_limits<size_t>::max(), step);
+}
+
+/* Arithmetic expression templates, a * b + c is evaluated in one pass */
+
+template <IndexedView Lhs, IndexedView Rhs, typename Op>
+class BinaryExprView : public ViewBase<BinaryExprView<Lhs, Rhs, Op>> {
+public:
+    BinaryExprView(Lhs lhs, Rhs rhs) : lhs_(lhs), rhs_(rhs) {
+    }
+
+    size_t Size() const {
+        return std::min<size_t>(lhs_.Size(), rhs_.Size());
+    }
+
+    auto operator[](size_t pos) const {
+        return Op()(lhs_[pos], rhs_[pos]);
+    }
+
+    template <typename Consumer>
+    void ForEach(Consumer&& consumer) const {
+        for (size_t pos = 0; pos < Size(); pos++) {
+            consumer((*this)[pos]);
+        }
+    }
+
+private:
+    Lhs lhs_;
+    Rhs rhs_;
+};
+
+namespace detail {
+
+template <typename Operand>
+concept ArithmeticVector = requires(const Operand& operand) {
+    requires std::is_arithmetic_v<std::remove_cvref_t<decltype(*operand.Data())>>;
+    requires !std::is_same_v<std::remove_cvref_t<decltype(*operand.Data())>, bool>;
+    { AsView(operand) } -> IndexedView;
+};
+
+template <typename Operand>
+concept ArrayOperand = IndexedView<Operand> || ArithmeticVector<Operand>;
+
+template <typename Operand>
+concept ExpressionOperand = ArrayOperand<Operand> || std::is_arithmetic_v<Operand>;
+
+template <typename Operand>
+auto AsOperand(const Operand& operand) {
+    if constexpr (std::is_arithmetic_v<Operand>) {
+        return ScalarView<Operand>(operand);
+    } else {
+        return AsView(operand);
+    }
+}
+
+template <typename Op, typename Lhs, typename Rhs>
+auto MakeBinary(const Lhs& lhs, const Rhs& rhs) {
+    using LhsView = decltype(AsOperand(lhs));
+    using RhsView = decltype(AsOperand(rhs));
+    return BinaryExprView<LhsView, RhsView, Op>(AsOperand(lhs), AsOperand(rhs));
+}
+
+}  // namespace detail
+
+template <detail::ExpressionOperand Lhs, detail::ExpressionOperand Rhs>
+    requires(detail::ArrayOperand<Lhs> || detail::ArrayOperand<Rhs>)
+auto operator+(const Lhs& lhs, const Rhs& rhs) {
+    return detail::MakeBinary<std::plus<>>(lhs, rhs);
+}
+
+template <detail::ExpressionOperand Lhs, detail::ExpressionOperand Rhs>
+    requires(detail::ArrayOperand<Lhs> || detail::ArrayOperand<Rhs>)
+auto operator-(const Lhs& lhs, const Rhs& rhs) {
+    return detail::MakeBinary<std::minus<>>(lhs, rhs);
+}
+
+template <detail::ExpressionOperand Lhs, detail::ExpressionOperand Rhs>
+    requires(detail::ArrayOperand<Lhs> || detail::ArrayOperand<Rhs>)
+auto operator*(const Lhs& lhs, const Rhs& rhs) {
+    return detail::MakeBinary<std::multiplies<>>(lhs, rhs);
+}
+
+template <detail::ExpressionOperand Lhs, detail::ExpressionOperand Rhs>
+    requires(detail::ArrayOperand<Lhs> || detail::ArrayOperand<Rhs>)
+auto operator/(const Lhs& lhs, const Rhs& rhs) {
+    return detail::MakeBinary<std::divides<>>(lhs, rhs);
+}
+
+template <detail::ArrayOperand Operand>
+auto operator-(const Operand& operand) {
+    return Map(operand, std::negate<>());
+}
+
+}  // namespace stdlike
+
+#endif  // STDLIKE_VIEWS_HPP
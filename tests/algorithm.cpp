@@ -0,0 +1,165 @@
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <stdlike/algorithm.hpp>
+#include <stdlike/vector.hpp>
+
+#include "test.hpp"
+
+namespace {
+
+using stdlike::par;
+using stdlike::Vector;
+
+constexpr size_t kLarge = stdlike::kParallelThreshold * 4 + 123;
+
+Vector<int> RandomInts(size_t size, int max_value = 1000) {
+    std::mt19937 rng(42);
+    Vector<int> vec(size);
+    for (size_t pos = 0; pos < size; pos++) {
+        vec[pos] = static_cast<int>(rng() % static_cast<uint32_t>(max_value));
+    }
+    return vec;
+}
+
+template <typename Type>
+std::vector<Type> ToStd(const Vector<Type>& vec) {
+    return std::vector<Type>(vec.Data(), vec.Data() + vec.Size());
+}
+
+TEST(SortMatchesStd) {
+    for (size_t size : {size_t(0), size_t(1), size_t(2), size_t(100), kLarge}) {
+        Vector<int> serial = RandomInts(size);
+        Vector<int> parallel = serial;
+        std::vector<int> expected = ToStd(serial);
+        std::sort(expected.begin(), expected.end());
+
+        stdlike::Sort(serial);
+        stdlike::Sort(par, parallel);
+        CHECK(ToStd(serial) == expected);
+        CHECK(ToStd(parallel) == expected);
+    }
+}
+
+TEST(SortWithComparator) {
+    Vector<int> vec = RandomInts(kLarge);
+    stdlike::Sort(par, vec, std::greater<>());
+    CHECK(std::is_sorted(vec.begin(), vec.end(), std::greater<>()));
+}
+
+TEST(StableSortKeepsOrderOfEqualKeys) {
+    /* Key in the high half, original position in the low half */
+    Vector<uint64_t> vec(kLarge);
+    std::mt19937 rng(7);
+    for (size_t pos = 0; pos < kLarge; pos++) {
+        uint64_t key = rng() % 16;
+        vec[pos] = (key << 32) | pos;
+    }
+    auto by_key = [](uint64_t lhs, uint64_t rhs) {
+        return (lhs >> 32) < (rhs >> 32);
+    };
+
+    Vector<uint64_t> serial = vec;
+    stdlike::StableSort(serial, by_key);
+    stdlike::StableSort(par, vec, by_key);
+    CHECK(ToStd(vec) == ToStd(serial));
+    CHECK(std::is_sorted(vec.begin(), vec.end()));
+}
+
+TEST(ReduceAndTransformReduce) {
+    Vector<int> vec = RandomInts(kLarge);
+    int64_t expected = std::accumulate(vec.begin(), vec.end(), int64_t(0));
+    CHECK(stdlike::Reduce(vec, int64_t(0)) == expected);
+    CHECK(stdlike::Reduce(par, vec, int64_t(0)) == expected);
+
+    auto square = [](int value) {
+        return int64_t(value) * value;
+    };
+    int64_t squares = 0;
+    for (int value : vec) {
+        squares += square(value);
+    }
+    CHECK(stdlike::TransformReduce(vec, int64_t(0), std::plus<>(), square) == squares);
+    CHECK(stdlike::TransformReduce(par, vec, int64_t(0), std::plus<>(), square) == squares);
+
+    Vector<int> empty;
+    CHECK(stdlike::Reduce(par, empty, 5) == 5);
+}
+
+TEST(InclusiveScan) {
+    Vector<int64_t> serial(kLarge, 1);
+    Vector<int64_t> parallel = serial;
+    stdlike::InclusiveScan(serial);
+    stdlike::InclusiveScan(par, parallel);
+    CHECK(ToStd(serial) == ToStd(parallel));
+    for (size_t pos = 0; pos < kLarge; pos++) {
+        CHECK(serial[pos] == int64_t(pos + 1));
+    }
+}
+
+TEST(ForEach) {
+    Vector<int> vec(kLarge, 1);
+    stdlike::ForEach(par, vec, [](int& value) {
+        value *= 3;
+    });
+    CHECK(std::all_of(vec.begin(), vec.end(), [](int value) {
+        return value == 3;
+    }));
+}
+
+TEST(Partition) {
+    for (size_t size : {size_t(0), size_t(10), kLarge}) {
+        Vector<int> serial = RandomInts(size);
+        Vector<int> parallel = serial;
+        auto even = [](int value) {
+            return value % 2 == 0;
+        };
+        size_t expected = static_cast<size_t>(std::count_if(serial.begin(), serial.end(), even));
+
+        CHECK(stdlike::Partition(serial, even) == expected);
+        CHECK(stdlike::Partition(par, parallel, even) == expected);
+        CHECK(std::is_partitioned(serial.begin(), serial.end(), even));
+        CHECK(std::is_partitioned(parallel.begin(), parallel.end(), even));
+    }
+}
+
+TEST(NonTrivialElements) {
+    Vector<std::string> vec;
+    for (int value : RandomInts(1000)) {
+        vec.PushBack(std::to_string(value));
+    }
+    stdlike::Sort(par, vec);
+    CHECK(std::is_sorted(vec.begin(), vec.end()));
+}
+
+TEST(BitVectorReduceAndSort) {
+    for (size_t size : {size_t(0), size_t(31), size_t(33), kLarge}) {
+        Vector<bool> bits(size);
+        size_t ones = 0;
+        for (size_t pos = 0; pos < size; pos++) {
+            bool bit = (pos * 7) % 3 == 0;
+            bits[pos] = bit;
+            ones += bit ? 1 : 0;
+        }
+        CHECK(stdlike::Reduce(bits) == ones);
+        CHECK(stdlike::Reduce(par, bits) == ones);
+
+        Vector<bool> sorted = bits;
+        stdlike::Sort(par, sorted);
+        CHECK(sorted.Size() == size);
+        CHECK(stdlike::Reduce(sorted) == ones);
+        for (size_t pos = 0; pos < size; pos++) {
+            CHECK(sorted[pos] == (pos >= size - ones));
+        }
+    }
+}
+
+}  // namespace
+
+TEST_MAIN()
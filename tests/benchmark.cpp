@@ -0,0 +1,113 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include <bench/benchmark.hpp>
+
+#include "test.hpp"
+
+namespace {
+
+void Noop(bench::State& state) {
+    while (state.KeepRunning()) {
+        bench::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.Iterations() * state.Size());
+}
+
+TEST(SizesFollowTheRange) {
+    bench::Benchmark benchmark("Noop", Noop);
+    CHECK(benchmark.Range(16, 1024).Sizes(SIZE_MAX) == std::vector<size_t>({16, 64, 256, 1024}));
+    CHECK(benchmark.Range(16, 1000).Sizes(SIZE_MAX) == std::vector<size_t>({16, 64, 256}));
+    CHECK(benchmark.Range(16, 1024).Sizes(100) == std::vector<size_t>({16, 64}));
+    CHECK(benchmark.Range(16, 1024).Multiplier(8).Sizes(SIZE_MAX) == std::vector<size_t>({16, 128, 1024}));
+    CHECK(benchmark.Range(100, 10).Sizes(SIZE_MAX).empty());
+}
+
+TEST(SizesWithoutEndlessLoops) {
+    bench::Benchmark benchmark("Noop", Noop);
+    CHECK(benchmark.Range(0, 16).Multiplier(4).Sizes(SIZE_MAX) == std::vector<size_t>({0, 1, 4, 16}));
+    CHECK(benchmark.Range(3, 6).Multiplier(1).Sizes(SIZE_MAX) == std::vector<size_t>({3, 4, 5, 6}));
+
+    std::vector<size_t> huge = benchmark.Range(SIZE_MAX / 2, SIZE_MAX).Multiplier(4).Sizes(SIZE_MAX);
+    CHECK(huge == std::vector<size_t>({SIZE_MAX / 2}));
+}
+
+TEST(StateCountsIterations) {
+    bench::State state(10, 5);
+    size_t runs = 0;
+    while (state.KeepRunning()) {
+        runs++;
+    }
+    CHECK(runs == 5);
+    CHECK(!state.KeepRunning());
+    CHECK(state.Seconds() >= 0);
+}
+
+TEST(PausedTimeIsExcluded) {
+    bench::State state(1, 2);
+    while (state.KeepRunning()) {
+        state.PauseTiming();
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        state.ResumeTiming();
+    }
+    CHECK(state.Seconds() < 0.02);
+}
+
+TEST(RunOneReachesMinTime) {
+    bench::Benchmark benchmark("Noop", Noop);
+    bench::Result result = bench::detail::RunOne(benchmark, 8, 0.01);
+    CHECK(result.name == "Noop/8");
+    CHECK(result.iterations > 1);
+    CHECK(result.ns_per_iteration * static_cast<double>(result.iterations) >= 0.009 * 1e9);
+    CHECK(result.items_per_second > 0);
+    CHECK(!(result.bytes_per_second > 0));
+}
+
+TEST(JsonOutput) {
+    std::filesystem::path path = std::filesystem::temp_directory_path() / (std::to_string(::getpid()) + "_bench.json");
+    bench::Options options;
+    options.json_path = path.string();
+
+    std::vector<bench::Result> results(2);
+    results[0].name = "First/16";
+    results[1].name = "Second/64";
+    bench::detail::WriteJson(options, results);
+
+    std::ifstream file(path);
+    std::stringstream text;
+    text << file.rdbuf();
+    std::filesystem::remove(path);
+
+    std::string json = text.str();
+    CHECK(json.find("\"name\": \"First/16\"") != std::string::npos);
+    CHECK(json.find("\"name\": \"Second/64\"") != std::string::npos);
+    CHECK(json.find("},\n    {") != std::string::npos);
+    CHECK(json.find("}\n  ]\n}\n") != std::string::npos);
+    CHECK(json.find("inf") == std::string::npos && json.find("nan") == std::string::npos);
+}
+
+TEST(ParseOptions) {
+    char name[] = "bench";
+    char filter[] = "--filter=Sort";
+    char max_size[] = "--max_size=1e9";
+    char min_time[] = "--min_time=0.5";
+    char* argv[] = {name, filter, max_size, min_time};
+    bench::Options options = bench::detail::ParseOptions(4, argv);
+    CHECK(options.filter == "Sort");
+    CHECK(options.max_size == 1000000000);
+    CHECK(options.min_time > 0.49 && options.min_time < 0.51);
+    CHECK(options.json_path.empty());
+}
+
+}  // namespace
+
+TEST_MAIN()
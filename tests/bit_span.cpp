@@ -0,0 +1,171 @@
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include <stdlike/bit_span.hpp>
+#include <stdlike/vector.hpp>
+
+#include "test.hpp"
+
+namespace {
+
+using stdlike::BitSpan;
+using stdlike::ConstBitSpan;
+using LsbBits = stdlike::BitVector<stdlike::BitOrder::kLsbFirst>;
+
+std::vector<uint8_t> RandomBytes(size_t size, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<uint8_t> bytes(size);
+    for (uint8_t& byte : bytes) {
+        byte = static_cast<uint8_t>(rng());
+    }
+    return bytes;
+}
+
+bool ReferenceBit(const std::vector<uint8_t>& bytes, size_t bit) {
+    return ((bytes[bit / 8] >> (bit % 8)) & 1u) != 0;
+}
+
+static_assert(std::random_access_iterator<ConstBitSpan::ConstIterator>);
+static_assert(std::is_convertible_v<BitSpan, ConstBitSpan>);
+static_assert(!std::is_convertible_v<ConstBitSpan, BitSpan>);
+
+TEST(WrapsExternalBuffers) {
+    std::vector<uint8_t> bytes = RandomBytes(40, 1);
+    for (size_t offset : {size_t(0), size_t(1), size_t(7), size_t(8), size_t(13)}) {
+        for (size_t size : {size_t(0), size_t(1), size_t(9), size_t(64), size_t(200)}) {
+            ConstBitSpan span(bytes.data(), size, offset);
+            CHECK(span.Size() == size && span.Empty() == (size == 0));
+            CHECK(span.Offset() == offset % 8);
+            CHECK(span.Data() == bytes.data() + offset / 8);
+            CHECK(span.SizeInBytes() == (offset % 8 + size + 7) / 8);
+
+            size_t expected_count = 0;
+            bool all_match = true;
+            for (size_t pos = 0; pos < size; pos++) {
+                bool bit = ReferenceBit(bytes, offset + pos);
+                expected_count += bit;
+                all_match = all_match && span[pos] == bit && span.Begin()[static_cast<ptrdiff_t>(pos)] == bit;
+            }
+            CHECK(all_match);
+            CHECK(span.Count() == expected_count);
+            CHECK(static_cast<size_t>(std::count(span.begin(), span.end(), true)) == expected_count);
+            CHECK(span.End() - span.Begin() == static_cast<ptrdiff_t>(size));
+        }
+    }
+
+    ConstBitSpan empty;
+    CHECK(empty.Empty() && empty.Count() == 0 && empty.SizeInBytes() == 0);
+    CHECK(empty.Begin() == empty.End());
+}
+
+TEST(SetOnlyTouchesItsBits) {
+    std::vector<uint8_t> bytes(8, 0xa5);
+    BitSpan span(bytes.data(), 20, 11);
+    for (size_t pos = 0; pos < span.Size(); pos++) {
+        span.Set(pos, pos % 3 == 0);
+    }
+
+    for (size_t bit = 0; bit < 64; bit++) {
+        bool expected = (bit >= 11 && bit < 31) ? (bit - 11) % 3 == 0 : ((0xa5 >> (bit % 8)) & 1u) != 0;
+        CHECK(ReferenceBit(bytes, bit) == expected);
+    }
+
+    /* Copies share the bits */
+    BitSpan copy = span;
+    copy.Set(0, false);
+    CHECK(!span[0]);
+    ConstBitSpan view = span;
+    CHECK(!view.Test(0) && view.Test(3));
+}
+
+TEST(Subspans) {
+    std::vector<uint8_t> bytes = RandomBytes(16, 2);
+    ConstBitSpan span(bytes.data(), 120, 3);
+    ConstBitSpan sub = span.Subspan(10, 50);
+    CHECK(sub.Size() == 50);
+    CHECK(sub.Offset() == (3 + 10) % 8);
+    for (size_t pos = 0; pos < sub.Size(); pos++) {
+        CHECK(sub[pos] == span[10 + pos]);
+    }
+    CHECK(span.Subspan(120, 0).Empty());
+    CHECK(span.Subspan(0, 120).Count() == span.Count());
+}
+
+TEST(LsbVectorIsAnArrowBitmap) {
+    LsbBits bits;
+    for (size_t pos = 0; pos < 100; pos++) {
+        bits.PushBack(pos % 7 == 0);
+    }
+    CHECK(bits.SizeInBytes() == 13);
+
+    /* Zero-copy: the span points into the words and writes through */
+    BitSpan span = bits.Span();
+    CHECK(static_cast<const void*>(span.Data()) == static_cast<const void*>(bits.Data()));
+    CHECK(span.Size() == 100);
+    CHECK(span.Count() == 15);
+    span.Set(1, true);
+    CHECK(bits[1]);
+
+    /* Bit 0 is the low bit of byte 0, bit 8 the low bit of byte 1 */
+    const uint8_t* bytes = span.Data();
+    CHECK((bytes[0] & 0x03) == 0x03);
+    CHECK((bytes[1] & 0x01) == 0);
+    CHECK((bytes[1] & 0x40) != 0);
+
+    const LsbBits& view = bits;
+    ConstBitSpan const_span = view.Span();
+    CHECK(const_span.Count() == 16);
+
+    CHECK(LsbBits().Span().Empty());
+}
+
+TEST(VectorFromSpan) {
+    std::vector<uint8_t> bytes = RandomBytes(32, 3);
+    for (size_t offset : {size_t(0), size_t(5)}) {
+        for (size_t size : {size_t(0), size_t(3), size_t(32), size_t(200)}) {
+            ConstBitSpan span(bytes.data(), size, offset);
+            LsbBits bits(span);
+            CHECK(bits.Size() == size);
+            bool all_match = true;
+            for (size_t pos = 0; pos < size; pos++) {
+                all_match = all_match && bits[pos] == span[pos];
+            }
+            CHECK(all_match);
+
+            /* Bits copied past the size do not leak into comparisons or growth */
+            LsbBits copy;
+            for (size_t pos = 0; pos < size; pos++) {
+                copy.PushBack(span[pos]);
+            }
+            CHECK(bits == copy);
+            bits.Resize(size + 5, false);
+            CHECK(bits.Span().Subspan(size, 5).Count() == 0);
+        }
+    }
+}
+
+TEST(MsbOrderIsUnchanged) {
+    stdlike::Vector<bool> bits(40, false);
+    bits[0] = true;
+    bits[33] = true;
+    CHECK(bits.Data()[0] == 0x80000000u);
+    CHECK(bits.Data()[1] == 0x40000000u);
+
+    LsbBits lsb(40, false);
+    lsb[0] = true;
+    lsb[33] = true;
+    CHECK(lsb.Data()[0] == 1u);
+    CHECK(lsb.Data()[1] == 2u);
+
+    /* Same bits in the same order, different layout */
+    CHECK(std::equal(bits.begin(), bits.end(), lsb.begin(), lsb.end()));
+}
+
+}  // namespace
+
+TEST_MAIN()
@@ -0,0 +1,230 @@
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+#include <utility>
+
+#include <stdlike/compact_vector.hpp>
+
+#include "test.hpp"
+
+namespace {
+
+using stdlike::CompactVector;
+
+/* Bytes handed out by every CountingAllocator rebind */
+int64_t live_bytes = 0;
+
+template <typename Type>
+class CountingAllocator {
+public:
+    using value_type = Type;
+
+    CountingAllocator() = default;
+
+    template <typename Other>
+    CountingAllocator(const CountingAllocator<Other>&) {
+    }
+
+    Type* allocate(size_t elems_n) {
+        live_bytes += static_cast<int64_t>(elems_n * sizeof(Type));
+        return std::allocator<Type>().allocate(elems_n);
+    }
+
+    void deallocate(Type* ptr, size_t elems_n) {
+        live_bytes -= static_cast<int64_t>(elems_n * sizeof(Type));
+        std::allocator<Type>().deallocate(ptr, elems_n);
+    }
+
+    template <typename Other>
+    bool operator==(const CountingAllocator<Other>&) const {
+        return true;
+    }
+};
+
+/* Copies throw once the budget runs out, moves may throw too */
+struct Fragile {
+    static inline int copies_left = 1000;
+    static inline int64_t live = 0;
+
+    int value = 0;
+
+    explicit Fragile(int init) : value(init) {
+        live++;
+    }
+
+    Fragile(const Fragile& other) : value(other.value) {
+        if (copies_left-- <= 0) {
+            throw std::runtime_error("copy");
+        }
+        live++;
+    }
+
+    Fragile(Fragile&& other) : value(other.value) {
+        if (copies_left-- <= 0) {
+            throw std::runtime_error("move");
+        }
+        live++;
+    }
+
+    Fragile& operator=(const Fragile& other) = default;
+
+    ~Fragile() {
+        live--;
+    }
+};
+
+template <typename Type>
+using Counted = CompactVector<Type, CountingAllocator<Type>>;
+
+TEST(Basics) {
+    CompactVector<int> empty;
+    CHECK(empty.Empty() && empty.Capacity() == 0 && empty.Data() == nullptr);
+    CHECK(empty.Begin() == empty.End());
+    static_assert(sizeof(CompactVector<int>) == sizeof(void*));
+
+    CompactVector<int> vec;
+    for (int value = 0; value < 1000; value++) {
+        vec.PushBack(value);
+    }
+    CHECK(vec.Size() == 1000 && vec.Capacity() >= 1000);
+    CHECK(vec.Front() == 0 && vec.Back() == 999 && vec.At(500) == 500);
+
+    vec.Insert(vec.Begin() + 1, -1);
+    CHECK(vec[1] == -1 && vec[2] == 1 && vec.Size() == 1001);
+    vec.Erase(vec.Begin());
+    CHECK(vec[0] == -1 && vec.Size() == 1000);
+    vec.PopBack();
+    CHECK(vec.Back() == 998);
+
+    vec.Resize(10);
+    vec.ShrinkToFit();
+    CHECK(vec.Capacity() == 10);
+    vec.Clear();
+    vec.ShrinkToFit();
+    CHECK(vec.Capacity() == 0 && vec.Data() == nullptr);
+}
+
+TEST(ElementsOfTheVectorItself) {
+    CompactVector<std::string> vec(1, "value");
+    vec.ShrinkToFit();
+    for (int round = 0; round < 5; round++) {
+        vec.PushBack(vec[0]);
+        vec.Insert(vec.Begin(), vec.Back());
+        vec.Resize(vec.Size() + 3, vec[1]);
+    }
+    CHECK(vec.Size() == 1 + 5 * 5);
+    bool all_equal = true;
+    for (const std::string& text : vec) {
+        all_equal = all_equal && text == "value";
+    }
+    CHECK(all_equal);
+}
+
+TEST(CopiesAndMoves) {
+    CompactVector<std::string> vec(3, "abc");
+    CompactVector<std::string> copy = vec;
+    copy[0] = "x";
+    CHECK(vec[0] == "abc" && copy[0] == "x");
+
+    CompactVector<std::string> moved = std::move(copy);
+    CHECK(copy.Empty() && moved.Size() == 3);
+
+    copy = moved;
+    CHECK(copy == moved);
+    copy = copy;
+    CHECK(copy == moved);
+    vec = std::move(moved);
+    CHECK(vec == copy);
+
+    CompactVector<std::string> empty;
+    CompactVector<std::string> empty_copy = empty;
+    CHECK(empty_copy.Empty() && empty_copy.Data() == nullptr);
+}
+
+TEST(ComparisonAndHash) {
+    CompactVector<int> lhs(3, 1);
+    CompactVector<int> rhs(3, 1);
+    CHECK(lhs == rhs);
+    rhs.PushBack(0);
+    CHECK(lhs != rhs && lhs < rhs);
+    rhs[0] = 0;
+    CHECK(lhs > rhs);
+
+    std::unordered_set<CompactVector<int>> keys;
+    keys.insert(lhs);
+    keys.insert(CompactVector<int>(3, 1));
+    keys.insert(CompactVector<int>());
+    CHECK(keys.size() == 2);
+    CHECK(stdlike::Hash<CompactVector<double>>()(CompactVector<double>(2, 0.0)) ==
+          stdlike::Hash<CompactVector<double>>()(CompactVector<double>(2, -0.0)));
+}
+
+TEST(TooManyElements) {
+    int64_t before = live_bytes;
+    Counted<uint8_t> vec;
+    CHECK_THROWS(vec.Resize(Counted<uint8_t>::kMaxSize + 1), std::length_error);
+    CHECK_THROWS(vec.Reserve(Counted<uint8_t>::kMaxSize + 1), std::length_error);
+    CHECK(vec.Empty() && vec.Capacity() == 0);
+
+    vec.Resize(10, 1);
+    CHECK_THROWS(vec.Resize(Counted<uint8_t>::kMaxSize + 1), std::length_error);
+    CHECK(vec.Size() == 10 && vec.Capacity() == 10);
+    CHECK(live_bytes > before);
+
+    vec = Counted<uint8_t>();
+    CHECK(live_bytes == before);
+}
+
+TEST(ThrowingConstructionFreesTheBlock) {
+    int64_t before = live_bytes;
+    Fragile::live = 0;
+    {
+        Fragile value(7);
+        Fragile::copies_left = 5;
+        CHECK_THROWS(Counted<Fragile> filled(10, value), std::runtime_error);
+        CHECK(Fragile::live == 1);
+        CHECK(live_bytes == before);
+
+        Fragile::copies_left = 1000;
+        Counted<Fragile> vec(10, value);
+        Fragile::copies_left = 3;
+        CHECK_THROWS(Counted<Fragile> copy(vec), std::runtime_error);
+        CHECK(Fragile::live == 11);
+        Fragile::copies_left = 1000;
+    }
+    CHECK(Fragile::live == 0);
+    CHECK(live_bytes == before);
+}
+
+TEST(ThrowingGrowthKeepsTheElements) {
+    int64_t before = live_bytes;
+    Fragile::live = 0;
+    {
+        Fragile::copies_left = 1000;
+        Counted<Fragile> vec;
+        for (int value = 0; value < 8; value++) {
+            vec.PushBack(Fragile(value));
+        }
+        vec.ShrinkToFit();
+        int64_t block_bytes = live_bytes - before;
+
+        Fragile::copies_left = 4;
+        CHECK_THROWS(vec.Reserve(100), std::runtime_error);
+        CHECK(vec.Size() == 8 && vec.Capacity() == 8);
+        CHECK(vec[0].value == 0 && vec[7].value == 7);
+        CHECK(Fragile::live == 8);
+        CHECK(live_bytes - before == block_bytes);
+
+        Fragile::copies_left = 1000;
+        vec.Reserve(100);
+        CHECK(vec[7].value == 7 && Fragile::live == 8);
+    }
+    CHECK(Fragile::live == 0);
+    CHECK(live_bytes == before);
+}
+
+}  // namespace
+
+TEST_MAIN()
@@ -0,0 +1,221 @@
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <compare>
+#include <functional>
+#include <limits>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <stdlike/vector.hpp>
+
+#include "test.hpp"
+
+namespace {
+
+/* One byte without padding, so bytes are unique, but equality ignores case */
+struct NoCaseChar {
+    char value;
+};
+
+int Folded(NoCaseChar chr) {
+    return std::tolower(static_cast<unsigned char>(chr.value));
+}
+
+bool operator==(NoCaseChar lhs, NoCaseChar rhs) {
+    return Folded(lhs) == Folded(rhs);
+}
+
+std::weak_ordering operator<=>(NoCaseChar lhs, NoCaseChar rhs) {
+    return Folded(lhs) <=> Folded(rhs);
+}
+
+static_assert(std::has_unique_object_representations_v<NoCaseChar>);
+
+}  // namespace
+
+template <>
+struct std::hash<NoCaseChar> {
+    size_t operator()(NoCaseChar chr) const {
+        return std::hash<int>()(Folded(chr));
+    }
+};
+
+namespace {
+
+using stdlike::Vector;
+
+template <typename VectorType>
+uint64_t HashOf(const VectorType& vec) {
+    return stdlike::Hash<VectorType>()(vec);
+}
+
+template <typename Type>
+Vector<Type> From(const std::vector<Type>& values) {
+    Vector<Type> vec;
+    for (const Type& value : values) {
+        vec.PushBack(value);
+    }
+    return vec;
+}
+
+TEST(Equality) {
+    CHECK(Vector<int>() == Vector<int>());
+    CHECK(Vector<int>() != Vector<int>(1, 0));
+    CHECK(Vector<int>(3, 1) == Vector<int>(3, 1));
+    CHECK(Vector<int>(3, 1) != Vector<int>(4, 1));
+
+    /* Differences past the first memcmp block */
+    Vector<uint8_t> bytes(1000, 7);
+    Vector<uint8_t> other = bytes;
+    other[999] = 8;
+    CHECK(bytes != other);
+    other[999] = 7;
+    CHECK(bytes == other);
+
+    /* Equal values with different bytes, and NaN */
+    CHECK(Vector<double>(2, 0.0) == Vector<double>(2, -0.0));
+    CHECK(Vector<double>(2, std::numeric_limits<double>::quiet_NaN()) !=
+          Vector<double>(2, std::numeric_limits<double>::quiet_NaN()));
+
+    CHECK(Vector<std::string>(2, "abc") == Vector<std::string>(2, "abc"));
+    CHECK(Vector<std::string>(2, "abc") != Vector<std::string>(2, "abd"));
+}
+
+TEST(OrderingMatchesStdVector) {
+    std::mt19937 random(42);
+    for (size_t iteration = 0; iteration < 2000; iteration++) {
+        size_t size = random() % 300;
+        std::vector<int32_t> lhs(size);
+        for (int32_t& value : lhs) {
+            value = static_cast<int32_t>(random() % 5) - 2;
+        }
+
+        std::vector<int32_t> rhs = lhs;
+        if (random() % 2 == 0) {
+            rhs.resize(random() % 300, -1);
+        }
+        if (!rhs.empty() && random() % 2 == 0) {
+            rhs[random() % rhs.size()] = static_cast<int32_t>(random() % 5) - 2;
+        }
+
+        CHECK((From(lhs) <=> From(rhs)) == (lhs <=> rhs));
+        CHECK((From(lhs) == From(rhs)) == (lhs == rhs));
+    }
+
+    /* Signed and unsigned bytes, memcmp alone would get the first one wrong */
+    CHECK(Vector<int8_t>(1, -1) < Vector<int8_t>(1, 1));
+    CHECK(Vector<uint8_t>(1, 255) > Vector<uint8_t>(1, 1));
+
+    /* A prefix orders first */
+    CHECK(Vector<int>() < Vector<int>(1, std::numeric_limits<int>::min()));
+    CHECK(Vector<int>(2, 5) < Vector<int>(3, 5));
+
+    /* Partial ordering for floats */
+    Vector<double> nan(1, std::numeric_limits<double>::quiet_NaN());
+    CHECK((nan <=> nan) == std::partial_ordering::unordered);
+    CHECK((Vector<double>(1, -0.0) <=> Vector<double>(1, 0.0)) == std::partial_ordering::equivalent);
+
+    CHECK(Vector<std::string>(1, "a") < Vector<std::string>(1, "b"));
+}
+
+template <typename BitsType>
+void CheckBits() {
+    std::mt19937 random(7);
+    for (size_t iteration = 0; iteration < 2000; iteration++) {
+        std::vector<bool> lhs(random() % 100);
+        for (size_t pos = 0; pos < lhs.size(); pos++) {
+            lhs[pos] = random() % 2;
+        }
+        std::vector<bool> rhs = lhs;
+        if (random() % 2 == 0) {
+            rhs.resize(random() % 100, random() % 2);
+        }
+        if (!rhs.empty() && random() % 2 == 0) {
+            rhs[random() % rhs.size()].flip();
+        }
+
+        BitsType lhs_bits;
+        BitsType rhs_bits;
+        for (bool bit : lhs) {
+            lhs_bits.PushBack(bit);
+        }
+        for (bool bit : rhs) {
+            rhs_bits.PushBack(bit);
+        }
+
+        CHECK((lhs_bits <=> rhs_bits) == (lhs <=> rhs));
+        CHECK((lhs_bits == rhs_bits) == (lhs == rhs));
+        if (lhs == rhs) {
+            CHECK(HashOf(lhs_bits) == HashOf(rhs_bits));
+        }
+    }
+
+    /* Stale bits past the size are ignored */
+    BitsType ones(40, true);
+    ones.Resize(3);
+    BitsType fresh(3, true);
+    CHECK(ones == fresh);
+    CHECK((ones <=> fresh) == 0);
+    CHECK(HashOf(ones) == HashOf(fresh));
+    CHECK(BitsType() == BitsType());
+    CHECK(BitsType() < BitsType(1, false));
+}
+
+TEST(Bits) {
+    CheckBits<Vector<bool>>();
+    CheckBits<stdlike::BitVector<stdlike::BitOrder::kLsbFirst>>();
+}
+
+TEST(HashFollowsEquality) {
+    CHECK(HashOf(Vector<int>()) == HashOf(Vector<int>()));
+    CHECK(HashOf(Vector<int>(100, 3)) == HashOf(Vector<int>(100, 3)));
+    CHECK(HashOf(Vector<int>(100, 3)) != HashOf(Vector<int>(100, 4)));
+    CHECK(HashOf(Vector<int>(100, 3)) != HashOf(Vector<int>(101, 3)));
+    CHECK(HashOf(Vector<double>(4, 0.0)) == HashOf(Vector<double>(4, -0.0)));
+    CHECK(HashOf(Vector<std::string>(2, "x")) == HashOf(Vector<std::string>(2, "x")));
+
+    /* Empty and single zero element vectors differ */
+    CHECK(HashOf(Vector<std::string>()) != HashOf(Vector<std::string>(1, "")));
+    CHECK(HashOf(Vector<bool>()) != HashOf(Vector<bool>(1, false)));
+}
+
+TEST(ElementOperatorsWin) {
+    Vector<NoCaseChar> lower = From<NoCaseChar>({{'a'}, {'b'}, {'c'}});
+    Vector<NoCaseChar> upper = From<NoCaseChar>({{'A'}, {'B'}, {'C'}});
+    CHECK(lower == upper);
+    CHECK(std::is_eq(lower <=> upper));
+    CHECK(HashOf(lower) == HashOf(upper));
+
+    upper.PushBack({'a'});
+    CHECK(lower != upper && lower < upper);
+    upper[1] = {'A'};
+    CHECK(lower > upper);
+
+    static_assert(stdlike::detail::BytewiseComparable<uint16_t>);
+    static_assert(stdlike::detail::BytewiseComparable<const char*>);
+    static_assert(!stdlike::detail::BytewiseComparable<NoCaseChar>);
+    static_assert(!stdlike::detail::BytewiseComparable<float>);
+}
+
+TEST(UnorderedKeys) {
+    std::unordered_set<Vector<int>> keys;
+    for (int value = 0; value < 100; value++) {
+        keys.insert(Vector<int>(static_cast<size_t>(value % 10), value % 7));
+    }
+    CHECK(keys.size() == 1 + 9 * 7);
+    CHECK(keys.count(Vector<int>(3, 2)) == 1);
+    CHECK(keys.count(Vector<int>(30, 2)) == 0);
+
+    std::unordered_set<Vector<bool>> bit_keys;
+    bit_keys.insert(Vector<bool>(33, true));
+    Vector<bool> shrunk(64, true);
+    shrunk.Resize(33);
+    CHECK(bit_keys.count(shrunk) == 1);
+}
+
+}  // namespace
+
+TEST_MAIN()
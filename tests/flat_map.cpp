@@ -0,0 +1,135 @@
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <list>
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <stdlike/flat_map.hpp>
+
+#include "test.hpp"
+
+namespace {
+
+using stdlike::FlatMap;
+using stdlike::Vector;
+
+template <typename Key, typename Value>
+bool Holds(const FlatMap<Key, Value>& map, const std::map<Key, Value>& expected) {
+    if (map.Size() != expected.size()) {
+        return false;
+    }
+    auto expected_it = expected.begin();
+    for (auto [key, value] : map) {
+        if (key != expected_it->first || value != expected_it->second) {
+            return false;
+        }
+        ++expected_it;
+    }
+    return true;
+}
+
+TEST(InsertFindErase) {
+    FlatMap<int, std::string> empty;
+    CHECK(empty.Empty() && empty.Begin() == empty.End());
+    CHECK(empty.Find(1) == empty.End() && !empty.Contains(1) && empty.Count(1) == 0);
+    CHECK(empty.LowerBound(1) == empty.End() && empty.Erase(1) == 0);
+
+    FlatMap<int, std::string> map = {{3, "c"}, {1, "a"}, {3, "x"}};
+    CHECK(map.Size() == 2 && map.At(3) == "c");
+
+    auto [pos, inserted] = map.Insert(2, "b");
+    CHECK(inserted && pos.Index() == 1 && pos.GetKey() == 2 && pos.GetValue() == "b");
+    CHECK(!map.Insert(2, "z").second && map.At(2) == "b");
+    CHECK(!map.InsertOrAssign(2, "z").second && map.At(2) == "z");
+    CHECK(map.InsertOrAssign(4, "d").second);
+
+    map[5] = "e";
+    CHECK(map[5] == "e" && map[6].empty() && map.Size() == 6);
+
+    CHECK((*map.LowerBound(4)).second == "d" && map.UpperBound(6) == map.End());
+    CHECK(map.Erase(6) == 1 && map.Erase(6) == 0);
+    CHECK(map.Erase(map.Find(1)).GetKey() == 2);
+    CHECK(map.Keys().Size() == map.Values().Size() && map.Keys()[0] == 2 && map.Values()[0] == "z");
+
+    for (auto [key, value] : map) {
+        value += "!";
+    }
+    CHECK(map.At(5) == "e!");
+
+    map.Clear();
+    CHECK(map.Empty() && map == empty);
+}
+
+TEST(ValuesOfTheMapItself) {
+    FlatMap<int, std::string> map = {{0, std::string(40, 'a')}};
+    map.ShrinkToFit();
+    for (int key = 1; key < 20; key++) {
+        /* Inserted in front, so the source value shifts too */
+        map.Insert(-key, map.At(1 - key));
+        map.InsertOrAssign(1 - key, map.At(-key));
+    }
+    CHECK(map.Size() == 20);
+    for (auto [key, value] : map) {
+        CHECK(value == std::string(40, 'a'));
+    }
+
+    FlatMap<int, int> ints = {{10, 7}};
+    ints.ShrinkToFit();
+    for (int key = 9; key > 0; key--) {
+        ints.Insert(key, ints.Values().Back());
+    }
+    CHECK(std::count(ints.Values().begin(), ints.Values().end(), 7) == 10);
+}
+
+TEST(InsertRangeMatchesStdMap) {
+    std::mt19937 rng(7);
+    FlatMap<uint32_t, uint64_t> map;
+    std::map<uint32_t, uint64_t> expected;
+    for (size_t round = 0; round < 20; round++) {
+        std::vector<std::pair<uint32_t, uint64_t>> entries;
+        for (size_t pos = 0; pos < round * 41; pos++) {
+            entries.emplace_back(static_cast<uint32_t>(rng() % 3000), rng());
+        }
+        map.InsertRange(entries);
+        /* std::map::insert also keeps present values and the first of equal new keys */
+        expected.insert(entries.begin(), entries.end());
+        CHECK(Holds(map, expected));
+    }
+
+    std::list<std::pair<uint32_t, uint64_t>> listed = {{5000, 1}, {5000, 2}};
+    map.InsertRange(listed);
+    map.InsertRange(std::vector<std::pair<uint32_t, uint64_t>>());
+    map.InsertRange({{5001, 3}});
+    expected.insert(listed.begin(), listed.end());
+    expected.insert({5001, 3});
+    CHECK(Holds(map, expected));
+    CHECK(map.At(5000) == 1);
+}
+
+TEST(SortedUniqueAndSwap) {
+    Vector<int> keys;
+    Vector<uint8_t> values;
+    for (int key = 0; key < 64; key++) {
+        keys.PushBack(key * 3);
+        values.PushBack(static_cast<uint8_t>(key % 2));
+    }
+    FlatMap<int, uint8_t> map(stdlike::sorted_unique, std::move(keys), std::move(values));
+    CHECK(map.Size() == 64 && map.At(63) == 1 && !map.Contains(64));
+
+    const FlatMap<int, uint8_t>& view = map;
+    FlatMap<int, uint8_t>::ConstIterator pos = view.Find(3);
+    CHECK(pos.GetValue() == 1 && (*pos).first == 3 && pos[1].first == 6);
+    CHECK(view.End() - view.Begin() == 64);
+
+    FlatMap<int, uint8_t> other = {{1, 1}};
+    map.Swap(other);
+    CHECK(map.Size() == 1 && other.Size() == 64 && map != other);
+}
+
+}  // namespace
+
+TEST_MAIN()
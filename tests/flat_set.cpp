@@ -0,0 +1,124 @@
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <functional>
+#include <list>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <stdlike/flat_set.hpp>
+
+#include "test.hpp"
+
+namespace {
+
+using stdlike::FlatSet;
+using stdlike::Vector;
+
+template <typename Key, typename Compare>
+bool Holds(const FlatSet<Key, Compare>& set, const std::set<Key, Compare>& expected) {
+    return set.Size() == expected.size() && std::equal(set.begin(), set.end(), expected.begin(), expected.end());
+}
+
+TEST(BranchlessBounds) {
+    /* Every size up to a few levels, every key between and on the values */
+    for (size_t size = 0; size < 40; size++) {
+        std::vector<int> values;
+        for (size_t pos = 0; pos < size; pos++) {
+            values.push_back(static_cast<int>(pos / 3) * 2);
+        }
+        for (int key = -1; key <= static_cast<int>(size); key++) {
+            size_t lower = stdlike::detail::BranchlessLowerBound(values.data(), size, key, std::less<int>());
+            size_t upper = stdlike::detail::BranchlessUpperBound(values.data(), size, key, std::less<int>());
+            CHECK(lower == static_cast<size_t>(std::lower_bound(values.begin(), values.end(), key) - values.begin()));
+            CHECK(upper == static_cast<size_t>(std::upper_bound(values.begin(), values.end(), key) - values.begin()));
+        }
+    }
+}
+
+TEST(InsertFindErase) {
+    FlatSet<int> empty;
+    CHECK(empty.Empty() && empty.Size() == 0);
+    CHECK(empty.Begin() == empty.End());
+    CHECK(empty.Find(1) == empty.End() && !empty.Contains(1) && empty.Count(1) == 0);
+    CHECK(empty.LowerBound(1) == empty.End() && empty.UpperBound(1) == empty.End());
+    CHECK(empty.Erase(1) == 0);
+
+    FlatSet<int> set = {5, 1, 3, 1};
+    CHECK(set.Size() == 3 && *set.Begin() == 1);
+
+    auto [pos, inserted] = set.Insert(4);
+    CHECK(inserted && *pos == 4 && pos - set.Begin() == 2);
+    auto [same, again] = set.Insert(4);
+    CHECK(!again && same == pos);
+
+    /* A key of the set itself is found, nothing moves */
+    set.Insert(*set.Begin());
+    CHECK(set.Size() == 4);
+
+    CHECK(set.Contains(3) && !set.Contains(2) && set.Count(5) == 1);
+    CHECK(*set.LowerBound(2) == 3 && *set.UpperBound(3) == 4 && set.UpperBound(5) == set.End());
+
+    CHECK(set.Erase(3) == 1 && set.Erase(3) == 0);
+    CHECK(*set.Erase(set.Find(1)) == 4);
+    CHECK(set.Keys().Size() == 2 && set.Keys()[0] == 4 && set.Keys()[1] == 5);
+
+    set.Clear();
+    CHECK(set.Empty() && set == empty);
+}
+
+TEST(InsertRangeMatchesStdSet) {
+    std::mt19937 rng(5);
+    FlatSet<uint32_t> set;
+    std::set<uint32_t> expected;
+    for (size_t round = 0; round < 20; round++) {
+        std::vector<uint32_t> keys;
+        for (size_t pos = 0; pos < round * 37; pos++) {
+            keys.push_back(static_cast<uint32_t>(rng() % 2000));
+        }
+        set.InsertRange(keys);
+        expected.insert(keys.begin(), keys.end());
+        CHECK(Holds(set, expected));
+    }
+
+    /* Unsized ranges, empty ranges and the set's own keys */
+    std::list<uint32_t> listed = {7, 3, 7, 100000};
+    set.InsertRange(listed);
+    expected.insert(listed.begin(), listed.end());
+    set.InsertRange(std::vector<uint32_t>());
+    set.InsertRange(set.Keys());
+    set.InsertRange({1, 2});
+    expected.insert({1, 2});
+    CHECK(Holds(set, expected));
+}
+
+TEST(SortedUniqueAndComparators) {
+    Vector<int> sorted;
+    for (int key = 0; key < 100; key += 2) {
+        sorted.PushBack(key);
+    }
+    const int* data = sorted.Data();
+    FlatSet<int> set(stdlike::sorted_unique, std::move(sorted));
+    CHECK(set.Size() == 50 && set.Keys().Data() == data);
+    CHECK(set.Contains(42) && !set.Contains(43));
+
+    FlatSet<int, std::greater<int>> descending = {1, 3, 2};
+    CHECK(*descending.Begin() == 3 && *descending.LowerBound(2) == 2 && *descending.UpperBound(2) == 1);
+    std::set<int, std::greater<int>> expected = {1, 2, 3};
+    CHECK(Holds(descending, expected));
+
+    FlatSet<std::string> strings = {"pear", "apple", "fig"};
+    strings.InsertRange({"fig", "kiwi"});
+    CHECK(strings.Size() == 4 && *strings.Begin() == "apple" && strings.Contains("kiwi"));
+
+    FlatSet<int> other = {9};
+    set.Swap(other);
+    CHECK(set.Size() == 1 && other.Size() == 50);
+    CHECK(set != other);
+}
+
+}  // namespace
+
+TEST_MAIN()
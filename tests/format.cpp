@@ -0,0 +1,133 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include <stdlike/format.hpp>
+
+#include "test.hpp"
+
+namespace {
+
+using stdlike::FormatOptions;
+using stdlike::Vector;
+
+/* printf reference for count copies of value joined by single spaces */
+std::string Repeated(int precision, double value, size_t count) {
+    char number[2048];
+    std::snprintf(number, sizeof(number), "%.*g", precision, value);
+    std::string text;
+    for (size_t pos = 0; pos < count; pos++) {
+        text += (pos ? " " : "");
+        text += number;
+    }
+    return text;
+}
+
+TEST(Integers) {
+    Vector<int> vec;
+    vec.PushBack(-5);
+    vec.PushBack(0);
+    vec.PushBack(std::numeric_limits<int>::max());
+    CHECK(stdlike::Format(vec) == "-5 0 2147483647");
+    CHECK(stdlike::Format(vec, FormatOptions{", "}) == "-5, 0, 2147483647");
+    CHECK(stdlike::Format(Vector<int>()).empty());
+
+    Vector<char> chars(3, 'x');
+    CHECK(stdlike::Format(chars, FormatOptions{""}) == "xxx");
+}
+
+TEST(FloatsRoundTrip) {
+    Vector<double> vec;
+    for (int value = 1; value < 1000; value++) {
+        vec.PushBack(1.0 / value);
+    }
+    Vector<double> parsed;
+    CHECK(stdlike::Parse(stdlike::Format(vec), parsed) == vec.Size());
+    CHECK(stdlike::Format(parsed) == stdlike::Format(vec));
+
+    CHECK(stdlike::Format(Vector<double>(2, 0.125), FormatOptions{" ", 2}) == "0.12 0.12");
+}
+
+TEST(LongFloatWithPrecision) {
+    /* The exact value of denorm_min has 751 significant digits */
+    double tiny = std::numeric_limits<double>::denorm_min();
+    Vector<double> vec(8, tiny);
+    std::string text;
+    stdlike::Format(vec, text, FormatOptions{" ", 800});
+    CHECK(text == Repeated(800, tiny, 8));
+
+    /* Longer than the whole format buffer */
+    Vector<long double> longer(3, std::numeric_limits<long double>::denorm_min());
+    std::string long_text = stdlike::Format(longer, FormatOptions{" ", 20000});
+    CHECK(long_text.size() > 3 * 4096);
+    Vector<long double> parsed;
+    CHECK(stdlike::Parse(long_text, parsed) == 3);
+    CHECK(stdlike::Format(parsed, FormatOptions{" ", 20000}) == long_text);
+}
+
+TEST(StreamOutput) {
+    Vector<double> vec(8, std::numeric_limits<double>::denorm_min());
+    std::ostringstream stream;
+    stream.precision(800);
+    stream << vec;
+    CHECK(stream.str() == Repeated(800, vec[0], 8));
+
+    std::ostringstream hex;
+    hex << std::hex << Vector<int>(2, 255);
+    CHECK(hex.str() == "ff ff");
+}
+
+TEST(Bits) {
+    for (size_t size : {size_t(0), size_t(1), size_t(32), size_t(70)}) {
+        Vector<bool> bits;
+        std::string expected;
+        for (size_t pos = 0; pos < size; pos++) {
+            bits.PushBack(pos % 3 == 0);
+            expected += (pos ? " " : "");
+            expected += (pos % 3 == 0) ? "1" : "0";
+        }
+        CHECK(stdlike::Format(bits) == expected);
+
+        Vector<bool> parsed;
+        CHECK(stdlike::Parse(expected, parsed) == size);
+        CHECK(stdlike::Format(parsed) == expected);
+
+        stdlike::BitVector<stdlike::BitOrder::kLsbFirst> lsb_bits;
+        for (size_t pos = 0; pos < size; pos++) {
+            lsb_bits.PushBack(pos % 3 == 0);
+        }
+        CHECK(stdlike::Format(lsb_bits) == expected);
+    }
+    CHECK(stdlike::Format(Vector<bool>(3, true), FormatOptions{","}) == "1,1,1");
+}
+
+TEST(CallableSinkGetsLargePieces) {
+    Vector<uint64_t> vec(10000, std::numeric_limits<uint64_t>::max());
+    size_t calls = 0;
+    size_t bytes = 0;
+    stdlike::Format(vec, [&](const char*, size_t size) {
+        calls++;
+        bytes += size;
+    });
+    CHECK(bytes == 10000 * 21 - 1);
+    CHECK(calls < bytes / 1024);
+}
+
+TEST(ParseErrors) {
+    Vector<int> vec;
+    CHECK(stdlike::Parse("1,2;3\t4\n", vec) == 4);
+    CHECK(stdlike::Parse("", vec) == 0);
+    CHECK_THROWS(stdlike::Parse("1 x 3", vec), std::invalid_argument);
+    CHECK_THROWS(stdlike::Parse("99999999999", vec), std::invalid_argument);
+
+    Vector<bool> bits;
+    CHECK_THROWS(stdlike::Parse("1 2", bits), std::invalid_argument);
+}
+
+}  // namespace
+
+TEST_MAIN()
@@ -0,0 +1,185 @@
+#ifndef STDLIKE_INSTRUMENT
+#define STDLIKE_INSTRUMENT 1
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include <stdlike/vector.hpp>
+
+#include "test.hpp"
+
+namespace {
+
+using stdlike::Vector;
+using stdlike::instrument::SiteStats;
+
+/* Merged statistics of the sites on one line of this file */
+SiteStats AtLine(uint32_t line) {
+    SiteStats stats;
+    for (const stdlike::instrument::SiteReport& report : stdlike::instrument::Snapshot()) {
+        if (report.line == line && std::strstr(report.file, "instrument.cpp")) {
+            stats.Merge(report.stats);
+        }
+    }
+    return stats;
+}
+
+TEST(ReallocationsAreChargedToTheCaller) {
+    stdlike::instrument::Reset();
+    Vector<uint64_t> vec;
+    uint32_t line = __LINE__ + 2;
+    for (uint64_t value = 0; value < 1000; value++) {
+        vec.PushBack(value);
+    }
+
+    SiteStats stats = AtLine(line);
+    CHECK(stats.allocations == stats.reallocations + 1);
+    CHECK(stats.reallocations >= 9 && stats.reallocations <= 10);
+    CHECK(stats.bytes_copied >= 511 * sizeof(uint64_t));
+    CHECK(stats.peak_capacity == vec.Capacity() * sizeof(uint64_t));
+    CHECK(stats.max_slack > 0);
+    CHECK(stats.slack_samples == stats.allocations);
+}
+
+TEST(ReserveAvoidsReallocations) {
+    stdlike::instrument::Reset();
+    Vector<uint32_t> vec;
+    uint32_t reserve_line = __LINE__ + 1;
+    vec.Reserve(1000);
+    uint32_t line = __LINE__ + 2;
+    for (uint32_t value = 0; value < 1000; value++) {
+        vec.PushBack(value);
+    }
+
+    SiteStats reserve = AtLine(reserve_line);
+    CHECK(reserve.reserves == 1);
+    CHECK(reserve.allocations == 1);
+    CHECK(reserve.reallocations == 0);
+    CHECK(reserve.peak_capacity == 1000 * sizeof(uint32_t));
+    CHECK(AtLine(line).allocations == 0);
+
+    /* A Reserve below the capacity is counted but allocates nothing */
+    uint32_t again_line = __LINE__ + 1;
+    vec.Reserve(10);
+    CHECK(AtLine(again_line).reserves == 1);
+    CHECK(AtLine(again_line).allocations == 0);
+}
+
+TEST(ParallelResizeIsChargedToTheCaller) {
+    stdlike::instrument::Reset();
+    Vector<uint64_t> vec;
+    uint32_t line = __LINE__ + 1;
+    vec.Resize(stdlike::par, 1000, 1);
+
+    SiteStats stats = AtLine(line);
+    CHECK(stats.allocations == 1);
+    CHECK(stats.peak_capacity == 1000 * sizeof(uint64_t));
+}
+
+TEST(ShrinkToFit) {
+    stdlike::instrument::Reset();
+    Vector<int> vec(100, 1);
+    vec.Resize(10);
+    uint32_t line = __LINE__ + 1;
+    vec.ShrinkToFit();
+
+    SiteStats stats = AtLine(line);
+    CHECK(stats.shrinks == 1);
+    CHECK(stats.allocations == 1);
+    CHECK(stats.bytes_copied == 10 * sizeof(int));
+    CHECK(vec.Capacity() == 10);
+}
+
+TEST(EmptyVectorsAllocateNoBytes) {
+    stdlike::instrument::Reset();
+    {
+        Vector<double> vec;
+        Vector<bool> bits;
+        Vector<double> copy(vec);
+        CHECK(vec.Empty() && bits.Empty() && copy.Empty());
+    }
+    uint64_t bytes = 0;
+    uint64_t peak = 0;
+    for (const stdlike::instrument::SiteReport& report : stdlike::instrument::Snapshot()) {
+        bytes += report.stats.bytes_allocated;
+        peak += report.stats.peak_capacity;
+    }
+    CHECK(bytes == 0);
+    CHECK(peak == 0);
+}
+
+TEST(Bits) {
+    stdlike::instrument::Reset();
+    uint32_t line = __LINE__ + 1;
+    Vector<bool> bits(64, true);
+    uint32_t push_line = __LINE__ + 2;
+    for (size_t pos = 0; pos < 1000; pos++) {
+        bits.PushBack(pos % 2 == 0);
+    }
+
+    SiteStats constructed = AtLine(line);
+    CHECK(constructed.allocations == 1);
+    CHECK(constructed.peak_capacity == 64 / 8);
+
+    SiteStats pushed = AtLine(push_line);
+    CHECK(pushed.reallocations > 0);
+    CHECK(pushed.allocations == pushed.reallocations);
+    CHECK(pushed.peak_capacity == bits.Capacity() / 8);
+}
+
+TEST(ThreadsAreMerged) {
+    stdlike::instrument::Reset();
+    uint32_t line = 0;
+    auto work = [&line]() {
+        Vector<int> vec;
+        line = __LINE__ + 1;
+        vec.Reserve(16);
+    };
+    std::thread first(work);
+    first.join();
+    std::thread second(work);
+    second.join();
+    work();
+
+    CHECK(AtLine(line).reserves == 3);
+    CHECK(AtLine(line).allocations == 3);
+
+    stdlike::instrument::Reset();
+    CHECK(AtLine(line).reserves == 0);
+}
+
+TEST(ReportOrdersByReallocations) {
+    stdlike::instrument::Reset();
+    Vector<int> few;
+    Vector<int> many;
+    uint32_t few_line = __LINE__ + 2;
+    for (int value = 0; value < 4; value++) {
+        few.PushBack(value);
+    }
+    uint32_t many_line = __LINE__ + 2;
+    for (int value = 0; value < 4000; value++) {
+        many.PushBack(value);
+    }
+
+    char* data = nullptr;
+    size_t size = 0;
+    FILE* file = open_memstream(&data, &size);
+    stdlike::instrument::Report(file, 1);
+    std::fclose(file);
+    std::string text(data, size);
+    std::free(data);
+
+    CHECK(text.find("reallocs") != std::string::npos);
+    CHECK(text.find("instrument.cpp:" + std::to_string(many_line)) != std::string::npos);
+    CHECK(text.find("instrument.cpp:" + std::to_string(few_line)) == std::string::npos);
+}
+
+}  // namespace
+
+TEST_MAIN()
@@ -0,0 +1,209 @@
+#ifndef STDLIKE_ITERATOR_DEBUG
+#define STDLIKE_ITERATOR_DEBUG 1
+#endif
+
+#include <csignal>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <stdlike/vector.hpp>
+
+#include "test.hpp"
+
+namespace {
+
+using stdlike::Vector;
+
+/* Runs func in a child process, true if it aborted */
+template <typename Func>
+bool Aborts(Func func) {
+    pid_t pid = ::fork();
+    if (pid == 0) {
+        int null_fd = ::open("/dev/null", O_WRONLY);
+        ::dup2(null_fd, STDERR_FILENO);
+        func();
+        ::_exit(0);
+    }
+
+    int status = 0;
+    ::waitpid(pid, &status, 0);
+    return WIFSIGNALED(status) && WTERMSIG(status) == SIGABRT;
+}
+
+static_assert(std::contiguous_iterator<Vector<int>::Iterator>);
+static_assert(std::contiguous_iterator<Vector<int>::ConstIterator>);
+static_assert(std::random_access_iterator<Vector<bool>::Iterator>);
+static_assert(std::is_convertible_v<Vector<int>::Iterator, Vector<int>::ConstIterator>);
+static_assert(std::is_convertible_v<Vector<bool>::Iterator, Vector<bool>::ConstIterator>);
+static_assert(!std::is_convertible_v<Vector<int>::ConstIterator, Vector<int>::Iterator>);
+
+#if STDLIKE_ITERATOR_DEBUG
+
+TEST(ValidIteratorsWork) {
+    Vector<int> vec(100, 0);
+    std::iota(vec.Begin(), vec.End(), 0);
+    std::sort(vec.Begin(), vec.End(), [](int lhs, int rhs) {
+        return lhs > rhs;
+    });
+    CHECK(*vec.Begin() == 99);
+    CHECK(vec.End()[-1] == 0);
+    CHECK(vec.End() - vec.Begin() == 100);
+
+    const Vector<int>& view = vec;
+    Vector<int>::ConstIterator iter = vec.Begin() + 10;
+    CHECK(*iter == 89);
+    CHECK(std::find(view.Begin(), view.End(), 5) - view.Begin() == 94);
+
+    Vector<int>::Iterator pos = vec.Insert(vec.Begin() + 1, -1);
+    CHECK(*pos == -1);
+    pos = vec.Erase(pos);
+    CHECK(*pos == 98);
+
+    Vector<int> empty;
+    size_t visited = 0;
+    for ([[maybe_unused]] int value : empty) {
+        visited++;
+    }
+    CHECK(empty.Begin() == empty.End());
+    CHECK(visited == 0);
+}
+
+TEST(StaleAfterReallocation) {
+    CHECK(Aborts([]() {
+        Vector<int> vec(4, 1);
+        Vector<int>::Iterator iter = vec.Begin();
+        vec.Reserve(100);
+        return *iter;
+    }));
+    CHECK(Aborts([]() {
+        Vector<int> vec(4, 1);
+        Vector<int>::ConstIterator iter = vec.Begin();
+        vec.ShrinkToFit();
+        vec.PushBack(2);
+        return *iter;
+    }));
+    CHECK(Aborts([]() {
+        Vector<int> vec(4, 1);
+        Vector<int>::Iterator iter = vec.Begin();
+        vec.Insert(vec.End(), 5);
+        vec.Insert(iter, 5);
+    }));
+
+    /* Reserve that fits keeps the iterators */
+    CHECK(!Aborts([]() {
+        Vector<int> vec(4, 1);
+        vec.Reserve(100);
+        Vector<int>::Iterator iter = vec.Begin();
+        vec.Reserve(50);
+        vec.PushBack(2);
+        return *iter;
+    }));
+}
+
+TEST(StaleAfterAssignment) {
+    CHECK(Aborts([]() {
+        Vector<int> vec(4, 1);
+        Vector<int>::Iterator iter = vec.Begin();
+        vec = Vector<int>(4, 2);
+        return *iter;
+    }));
+    CHECK(Aborts([]() {
+        Vector<int> vec(4, 1);
+        Vector<int> other(4, 2);
+        Vector<int>::Iterator iter = vec.Begin();
+        vec = other;
+        return *iter;
+    }));
+}
+
+TEST(OutOfRange) {
+    CHECK(Aborts([]() {
+        Vector<int> vec(4, 1);
+        return *vec.End();
+    }));
+    CHECK(Aborts([]() {
+        Vector<int> vec(4, 1);
+        return vec.Begin()[4];
+    }));
+    CHECK(Aborts([]() {
+        Vector<int> empty;
+        return *empty.Begin();
+    }));
+    CHECK(Aborts([]() {
+        Vector<int>::Iterator iter;
+        return *iter;
+    }));
+}
+
+TEST(ForeignPositions) {
+    CHECK(Aborts([]() {
+        Vector<int> vec(4, 1);
+        Vector<int> other(4, 1);
+        vec.Insert(other.Begin(), 5);
+    }));
+    CHECK(Aborts([]() {
+        Vector<int> vec(4, 1);
+        Vector<int> other(4, 1);
+        vec.Erase(other.Begin());
+    }));
+    CHECK(Aborts([]() {
+        Vector<int> vec(4, 1);
+        Vector<int> other(4, 1);
+        return other.End() - vec.Begin();
+    }));
+}
+
+TEST(Bits) {
+    Vector<bool> bits(70, false);
+    for (Vector<bool>::Iterator iter = bits.Begin(); iter != bits.End(); iter += 3) {
+        *iter = true;
+        if (bits.End() - iter < 3) {
+            break;
+        }
+    }
+    CHECK(std::count(bits.Begin(), bits.End(), true) == 24);
+    CHECK(bits.Insert(bits.Begin() + 1, true) - bits.Begin() == 1);
+
+    CHECK(Aborts([]() {
+        Vector<bool> stale(32, true);
+        Vector<bool>::Iterator iter = stale.Begin();
+        stale.PushBack(false);
+        return static_cast<bool>(*iter);
+    }));
+    CHECK(Aborts([]() {
+        Vector<bool> vec(33, true);
+        return static_cast<bool>(*vec.End());
+    }));
+    CHECK(Aborts([]() {
+        Vector<bool> vec(8, true);
+        Vector<bool> other(8, true);
+        vec.Erase(other.Begin());
+    }));
+}
+
+#else
+
+TEST(ReleaseIteratorsArePointers) {
+    static_assert(std::is_same_v<Vector<int>::Iterator, int*>);
+    static_assert(std::is_same_v<Vector<int>::ConstIterator, const int*>);
+    static_assert(sizeof(Vector<bool>::Iterator) <= 2 * sizeof(void*));
+
+    Vector<int> vec(10, 3);
+    CHECK(vec.Begin() == vec.Data());
+    CHECK(vec.End() - vec.Begin() == 10);
+}
+
+#endif  // STDLIKE_ITERATOR_DEBUG
+
+}  // namespace
+
+TEST_MAIN()
@@ -0,0 +1,158 @@
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <list>
+#include <random>
+#include <ranges>
+#include <string>
+#include <vector>
+
+#include <stdlike/jagged_vector.hpp>
+
+#include "test.hpp"
+
+namespace {
+
+using stdlike::JaggedVector;
+using stdlike::Vector;
+
+template <typename Type>
+bool RowIs(std::span<const Type> row, std::initializer_list<Type> expected) {
+    return std::ranges::equal(row, expected);
+}
+
+TEST(AppendAndAccess) {
+    JaggedVector<int> empty;
+    CHECK(empty.Empty() && empty.Size() == 0 && empty.ValuesCount() == 0);
+    CHECK(empty.Begin() == empty.End());
+    CHECK(empty.Offsets().Empty());
+    CHECK(empty == JaggedVector<int>());
+
+    JaggedVector<int> rows = {{1, 2, 3}, {}, {4}};
+    CHECK(rows.Size() == 3 && rows.ValuesCount() == 4);
+    CHECK(RowIs<int>(rows[0], {1, 2, 3}) && rows[1].empty() && RowIs<int>(rows.At(2), {4}));
+    CHECK(rows.RowSize(0) == 3 && rows.RowSize(1) == 0);
+    CHECK(std::ranges::equal(rows.Offsets(), std::vector<size_t>{0, 3, 3, 4}));
+
+    /* Rows from every kind of range */
+    std::vector<int> from_std = {5, 6};
+    rows.AppendRow(from_std);
+    std::list<int> from_list = {7, 8, 9};
+    rows.AppendRow(from_list);
+    rows.AppendRow(std::views::iota(0, 4) | std::views::filter([](int value) { return value % 2 == 1; }));
+    rows.AppendRow(std::vector<short>{10, 11});
+    CHECK(RowIs<int>(rows[3], {5, 6}) && RowIs<int>(rows[4], {7, 8, 9}));
+    CHECK(RowIs<int>(rows[5], {1, 3}) && RowIs<int>(rows[6], {10, 11}));
+
+    rows.AppendRow();
+    rows.PushBack(12);
+    rows.PushBack(13);
+    CHECK(RowIs<int>(rows.Back(), {12, 13}));
+
+    rows.PopRow();
+    CHECK(rows.Size() == 7 && RowIs<int>(rows.Back(), {10, 11}));
+
+    size_t total = 0;
+    for (std::span<int> row : rows) {
+        total += row.size();
+    }
+    CHECK(total == rows.ValuesCount());
+
+    rows.Clear();
+    CHECK(rows.Empty() && rows == empty);
+}
+
+TEST(RowsOfTheVectorItself) {
+    JaggedVector<int> rows;
+    rows.AppendRow({1, 2, 3});
+    rows.ShrinkToFit();
+    for (int round = 0; round < 10; round++) {
+        rows.AppendRow(rows[0]);
+        rows.AppendRow(rows[0] | std::views::transform([](int value) { return value * 2; }));
+        rows.AppendRow(rows[0] | std::views::filter([](int value) { return value != 2; }));
+        rows.AppendRow();
+        rows.PushBack(rows[0][2]);
+    }
+    CHECK(rows.Size() == 41);
+    for (size_t row = 1; row < rows.Size(); row += 4) {
+        CHECK(RowIs<int>(rows[row], {1, 2, 3}));
+        CHECK(RowIs<int>(rows[row + 1], {2, 4, 6}));
+        CHECK(RowIs<int>(rows[row + 2], {1, 3}));
+        CHECK(RowIs<int>(rows[row + 3], {3}));
+    }
+
+    /* Non-trivial values take the copying path */
+    JaggedVector<std::string> strings = {{"a", "bb"}};
+    strings.ShrinkToFit();
+    for (int round = 0; round < 10; round++) {
+        strings.AppendRow(strings.Back());
+        strings.PushBack(strings[0][1]);
+    }
+    CHECK(strings.Back().size() == 12 && strings.Back()[11] == "bb");
+}
+
+TEST(Builder) {
+    JaggedVector<int>::Builder builder;
+    builder.Add(2, 20);
+    builder.Add(0, 0);
+    builder.Add(2, 21);
+    builder.ReserveRows(5);
+    CHECK(builder.Size() == 3);
+
+    JaggedVector<int> built = builder.Build();
+    CHECK(built.Size() == 5);
+    CHECK(RowIs<int>(built[0], {0}) && built[1].empty() && RowIs<int>(built[2], {20, 21}));
+    CHECK(built[3].empty() && built[4].empty());
+
+    builder.Clear();
+    CHECK(builder.Size() == 0 && builder.Build().Empty());
+}
+
+TEST(FromPairs) {
+    for (size_t pairs_n : {size_t(0), size_t(10), stdlike::kParallelThreshold * 3 + 7}) {
+        std::mt19937 rng(static_cast<uint32_t>(pairs_n));
+        size_t rows_n = pairs_n / 5 + 1;
+        Vector<uint32_t> sources;
+        Vector<uint32_t> targets;
+        for (size_t pos = 0; pos < pairs_n; pos++) {
+            sources.PushBack(static_cast<uint32_t>(rng() % rows_n));
+            targets.PushBack(static_cast<uint32_t>(pos));
+        }
+
+        JaggedVector<uint32_t> serial = JaggedVector<uint32_t>::FromPairs(rows_n, sources, targets);
+        JaggedVector<uint32_t> parallel = JaggedVector<uint32_t>::FromPairs(stdlike::par, rows_n, sources, targets);
+        CHECK(serial.Size() == rows_n && serial.ValuesCount() == pairs_n);
+        CHECK(serial.Offsets() == parallel.Offsets());
+
+        bool all_match = true;
+        for (size_t row = 0; row < rows_n; row++) {
+            /* Serial keeps input order, parallel the same values in any order */
+            all_match = all_match && std::ranges::is_sorted(serial[row]);
+            std::vector<uint32_t> values(parallel[row].begin(), parallel[row].end());
+            std::ranges::sort(values);
+            all_match = all_match && std::ranges::equal(values, serial[row]);
+            for (uint32_t value : serial[row]) {
+                all_match = all_match && sources[value] == row;
+            }
+        }
+        CHECK(all_match);
+    }
+}
+
+TEST(CopiesAndSwap) {
+    JaggedVector<int> rows = {{1}, {2, 3}};
+    JaggedVector<int> copy = rows;
+    copy[0][0] = 9;
+    CHECK(rows[0][0] == 1 && copy != rows);
+
+    JaggedVector<int> other = {{4}};
+    rows.Swap(other);
+    CHECK(rows.Size() == 1 && other.Size() == 2 && other[1][1] == 3);
+
+    JaggedVector<int> moved = std::move(other);
+    CHECK(moved.Size() == 2);
+}
+
+}  // namespace
+
+TEST_MAIN()
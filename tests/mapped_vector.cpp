@@ -0,0 +1,156 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include <unistd.h>
+
+#include <stdlike/mapped_vector.hpp>
+
+#include "test.hpp"
+
+namespace {
+
+using stdlike::MappedVector;
+using stdlike::MapMode;
+
+/* A fresh path in the temporary directory, removed when the test ends */
+class TempPath {
+public:
+    explicit TempPath(const char* name)
+        : path_(std::filesystem::temp_directory_path() / (std::to_string(::getpid()) + "_" + name)) {
+        std::filesystem::remove(path_);
+    }
+
+    ~TempPath() {
+        std::filesystem::remove(path_);
+    }
+
+    const char* Get() const {
+        return path_.c_str();
+    }
+
+private:
+    std::filesystem::path path_;
+};
+
+size_t OpenFdsCount() {
+    size_t count = 0;
+    for ([[maybe_unused]] const auto& entry : std::filesystem::directory_iterator("/proc/self/fd")) {
+        count++;
+    }
+    return count;
+}
+
+TEST(PersistsAcrossReopen) {
+    TempPath path("persist.vec");
+    {
+        MappedVector<uint64_t> vec(path.Get());
+        CHECK(vec.Empty());
+        for (uint64_t value = 0; value < 10000; value++) {
+            vec.PushBack(value * 3);
+        }
+        vec.Flush();
+    }
+
+    MappedVector<uint64_t> vec(path.Get(), MapMode::kReadOnly);
+    const MappedVector<uint64_t>& view = vec;
+    CHECK(view.Size() == 10000);
+    CHECK(view[9999] == 29997);
+    CHECK(view.At(1) == 3);
+}
+
+TEST(PushBackOfOwnElement) {
+    TempPath path("alias.vec");
+    MappedVector<int> vec(path.Get());
+    vec.PushBack(7);
+    vec.ShrinkToFit();
+    CHECK(vec.Capacity() == 1);
+    vec.PushBack(vec[0]);
+    CHECK(vec.Size() == 2 && vec[1] == 7);
+}
+
+TEST(ResizeAndPop) {
+    TempPath path("resize.vec");
+    MappedVector<int> vec(path.Get());
+    vec.Resize(100, 5);
+    CHECK(vec.Size() == 100 && vec.Back() == 5);
+    vec.PopBack();
+    CHECK(vec.Size() == 99);
+    vec.Clear();
+    vec.PopBack();
+    CHECK(vec.Empty());
+}
+
+TEST(ReadOnlyModifiersThrow) {
+    TempPath path("readonly.vec");
+    {
+        MappedVector<int> vec(path.Get());
+        vec.Resize(10, 1);
+    }
+
+    MappedVector<int> vec(path.Get(), MapMode::kReadOnly);
+    CHECK_THROWS(vec.PushBack(1), std::logic_error);
+    CHECK_THROWS(vec.PopBack(), std::logic_error);
+    CHECK_THROWS(vec.Clear(), std::logic_error);
+    CHECK_THROWS(vec.Resize(20), std::logic_error);
+    CHECK_THROWS(vec.Reserve(1000), std::logic_error);
+    CHECK_THROWS(vec.ShrinkToFit(), std::logic_error);
+    CHECK_THROWS(vec.At(0) = 2, std::logic_error);
+    CHECK(vec.Size() == 10);
+}
+
+TEST(MovedFromIsEmpty) {
+    TempPath path("moved.vec");
+    MappedVector<int> vec(path.Get());
+    vec.PushBack(1);
+
+    MappedVector<int> other = std::move(vec);
+    CHECK(other.Size() == 1);
+    CHECK(vec.Size() == 0);
+    CHECK(vec.Empty());
+    CHECK(vec.Capacity() == 0);
+}
+
+TEST(FailedOpenClosesTheFile) {
+    size_t before = OpenFdsCount();
+
+    /* ftruncate fails on a character device */
+    CHECK_THROWS(MappedVector<int>("/dev/null"), std::system_error);
+    CHECK(OpenFdsCount() == before);
+
+    TempPath path("foreign.vec");
+    {
+        std::FILE* file = std::fopen(path.Get(), "wb");
+        std::fputs("definitely not a vector file, but longer than the header is. ......................", file);
+        std::fclose(file);
+    }
+    CHECK_THROWS(MappedVector<int>(path.Get()), std::runtime_error);
+    CHECK(OpenFdsCount() == before);
+
+    TempPath empty("empty.vec");
+    std::fclose(std::fopen(empty.Get(), "wb"));
+    CHECK_THROWS(MappedVector<int>(empty.Get(), MapMode::kReadOnly), std::runtime_error);
+    CHECK(OpenFdsCount() == before);
+
+    TempPath missing("missing.vec");
+    CHECK_THROWS(MappedVector<int>(missing.Get(), MapMode::kReadOnly), std::system_error);
+    CHECK(OpenFdsCount() == before);
+}
+
+TEST(ElementSizeMismatch) {
+    TempPath path("mismatch.vec");
+    {
+        MappedVector<uint32_t> vec(path.Get());
+        vec.PushBack(1);
+    }
+    CHECK_THROWS(MappedVector<uint64_t>(path.Get()), std::runtime_error);
+}
+
+}  // namespace
+
+TEST_MAIN()
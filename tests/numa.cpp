@@ -0,0 +1,109 @@
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <stdlike/numa.hpp>
+
+#include "test.hpp"
+
+namespace {
+
+using stdlike::NumaAllocator;
+using stdlike::NumaPartition;
+using stdlike::NumaPolicy;
+using stdlike::PartitionedVector;
+using stdlike::Vector;
+
+/* Partitions of vec cover [0, Size()) in order, without gaps or overlaps */
+template <typename Type>
+bool CoversInOrder(const PartitionedVector<Type>& vec) {
+    size_t next = 0;
+    for (const NumaPartition& partition : vec.Partitions()) {
+        if (partition.begin > partition.end || (partition.begin != next && partition.begin != partition.end)) {
+            return false;
+        }
+        next = partition.begin == partition.end ? next : partition.end;
+    }
+    return next == vec.Size();
+}
+
+TEST(NodesAreKnown) {
+    CHECK(stdlike::NumaNodesCount() >= 1);
+    CHECK(stdlike::NumaNodes().size() == stdlike::NumaNodesCount());
+    CHECK(stdlike::CurrentNumaNode() <= stdlike::NumaNodes().back());
+}
+
+TEST(AllocatorGivesZeroedPages) {
+    NumaAllocator<uint64_t> alloc;
+    CHECK(alloc.Allocate(0) == nullptr);
+    alloc.Deallocate(nullptr, 0);
+
+    uint64_t* data = alloc.AllocateZeroed(100000);
+    for (size_t pos = 0; pos < 100000; pos++) {
+        CHECK(data[pos] == 0);
+    }
+    alloc.Deallocate(data, 100000);
+
+    CHECK_THROWS((void)alloc.Allocate(alloc.MaxSize() + 1), std::bad_alloc);
+}
+
+TEST(VectorWithInterleavedPages) {
+    Vector<std::string, NumaAllocator<std::string>> vec;
+    for (size_t pos = 0; pos < 1000; pos++) {
+        vec.PushBack(std::to_string(pos));
+    }
+    CHECK(vec.Size() == 1000);
+    CHECK(vec[999] == "999");
+
+    Vector<bool, NumaAllocator<bool>> flags(5000, true);
+    flags.PushBack(false);
+    CHECK(flags.Size() == 5001 && flags[0] && !flags[5000]);
+}
+
+TEST(PartitionsCoverTheVector) {
+    PartitionedVector<double> empty;
+    CHECK(empty.PartitionsCount() == stdlike::NumaNodesCount());
+    CHECK(CoversInOrder(empty));
+
+    for (size_t size : {size_t(1), size_t(511), size_t(512), size_t(1 << 20) + 3}) {
+        PartitionedVector<int64_t> vec(size, 3);
+        CHECK(vec.Size() == size);
+        CHECK(CoversInOrder(vec));
+
+        int64_t sum = 0;
+        for (const NumaPartition& partition : vec.Partitions()) {
+            for (size_t pos = partition.begin; pos < partition.end; pos++) {
+                sum += vec[pos];
+            }
+        }
+        CHECK(sum == 3 * static_cast<int64_t>(size));
+    }
+}
+
+TEST(PartitionsFollowReallocation) {
+    PartitionedVector<uint32_t> vec;
+    for (uint32_t value = 0; value < 100000; value++) {
+        vec.PushBack(value);
+    }
+    CHECK(CoversInOrder(vec));
+
+    vec.Resize(10);
+    CHECK(CoversInOrder(vec));
+    vec.ShrinkToFit();
+    CHECK(CoversInOrder(vec));
+}
+
+TEST(LocalRange) {
+    PartitionedVector<int> vec(100000, 0);
+    size_t first_node = stdlike::NumaNodes().front();
+    NumaPartition local = vec.LocalRange(first_node);
+    CHECK(local.node == first_node);
+    CHECK(local.begin == 0);
+
+    NumaPartition missing = vec.LocalRange(stdlike::NumaNodes().back() + 1);
+    CHECK(missing.begin == missing.end);
+}
+
+}  // namespace
+
+TEST_MAIN()
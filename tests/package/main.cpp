@@ -0,0 +1,16 @@
+#include <cstdio>
+
+#include <safe/print.hpp>
+#include <stdlike/algorithm.hpp>
+#include <stdlike/vector.hpp>
+
+int main() {
+    stdlike::Vector<int> vec;
+    for (int value = 10; value > 0; value--) {
+        vec.PushBack(value);
+    }
+    stdlike::Sort(stdlike::par, vec);
+
+    safe::Print("%\n", vec);
+    return vec[0] == 1 && vec[9] == 10 ? 0 : 1;
+}
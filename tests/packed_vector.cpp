@@ -0,0 +1,177 @@
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <stdlike/packed_vector.hpp>
+
+#include "test.hpp"
+
+namespace {
+
+using stdlike::PackedVector;
+using stdlike::Vector;
+
+template <size_t kBits>
+std::vector<uint64_t> RandomValues(size_t size) {
+    std::mt19937_64 rng(kBits * 1000 + size);
+    std::vector<uint64_t> values(size);
+    for (uint64_t& value : values) {
+        value = rng() & PackedVector<kBits>::kMask;
+    }
+    return values;
+}
+
+template <size_t kBits>
+bool Holds(const PackedVector<kBits>& packed, const std::vector<uint64_t>& values) {
+    return packed.Size() == values.size() && std::equal(packed.begin(), packed.end(), values.begin());
+}
+
+template <size_t kBits>
+void CheckWidth() {
+    for (size_t size : {size_t(0), size_t(1), size_t(63), size_t(64), size_t(65), size_t(1000)}) {
+        std::vector<uint64_t> values = RandomValues<kBits>(size);
+
+        PackedVector<kBits> pushed;
+        for (uint64_t value : values) {
+            pushed.PushBack(value);
+        }
+        CHECK(Holds(pushed, values));
+        CHECK(PackedVector<kBits>::WordsFor(size) == (size * kBits + 63) / 64);
+
+        /* Set through proxies, in reverse so that every value spans its neighbours' words */
+        PackedVector<kBits> assigned(size);
+        for (size_t pos = size; pos-- > 0;) {
+            assigned[pos] = values[pos];
+        }
+        CHECK(assigned == pushed);
+
+        /* Bulk conversion from both word widths */
+        PackedVector<kBits> packed;
+        if constexpr (kBits <= 32) {
+            Vector<uint32_t> narrow;
+            for (uint64_t value : values) {
+                narrow.PushBack(static_cast<uint32_t>(value));
+            }
+            packed.Pack(narrow);
+            CHECK(packed == pushed);
+
+            Vector<uint32_t> unpacked(3, 7);
+            packed.Unpack(unpacked);
+            CHECK(unpacked == narrow);
+        }
+
+        Vector<uint64_t> wide;
+        for (uint64_t value : values) {
+            wide.PushBack(value);
+        }
+        packed.Pack(wide);
+        CHECK(packed == pushed);
+        Vector<uint64_t> unpacked;
+        packed.Unpack(unpacked);
+        CHECK(unpacked == wide);
+
+        /* Shrinking keeps the bits past the end zero, so equality stays word-wise */
+        if (size > 1) {
+            PackedVector<kBits> shrunk = pushed;
+            shrunk.Resize(size / 2);
+            PackedVector<kBits> prefix;
+            for (size_t pos = 0; pos < size / 2; pos++) {
+                prefix.PushBack(values[pos]);
+            }
+            CHECK(shrunk == prefix);
+
+            shrunk.PopBack();
+            prefix.Resize(prefix.Size() - 1);
+            CHECK(shrunk == prefix);
+
+            shrunk.Resize(size / 2 + 5, PackedVector<kBits>::kMask);
+            CHECK(shrunk.Back() == PackedVector<kBits>::kMask);
+            CHECK(shrunk[size / 2 - 2] == values[size / 2 - 2]);
+        }
+    }
+}
+
+TEST(Widths) {
+    CheckWidth<1>();
+    CheckWidth<5>();
+    CheckWidth<7>();
+    CheckWidth<17>();
+    CheckWidth<32>();
+    CheckWidth<33>();
+    CheckWidth<63>();
+    CheckWidth<64>();
+}
+
+TEST(Construction) {
+    PackedVector<3> empty;
+    CHECK(empty.Empty());
+    CHECK(empty.Begin() == empty.End());
+    CHECK(empty == PackedVector<3>(0, 5));
+
+    PackedVector<3> sevens(100, 7);
+    CHECK(sevens.Size() == 100);
+    CHECK(std::count(sevens.begin(), sevens.end(), 7u) == 100);
+    CHECK(sevens.Front() == 7 && sevens.Back() == 7 && sevens.At(50) == 7);
+
+    PackedVector<3> copy = sevens;
+    copy[0] = 1;
+    CHECK(sevens[0] == 7);
+
+    PackedVector<3> moved = std::move(copy);
+    CHECK(moved[0] == 1);
+    CHECK(copy.Empty());
+
+    copy = std::move(moved);
+    CHECK(copy.Size() == 100 && moved.Empty());
+
+    copy.Clear();
+    CHECK(copy.Empty() && copy == PackedVector<3>());
+}
+
+TEST(Capacity) {
+    PackedVector<10> vec;
+    vec.Reserve(1000);
+    CHECK(vec.Capacity() >= 1000);
+    CHECK(vec.Empty());
+
+    vec.Resize(10);
+    vec.ShrinkToFit();
+    CHECK(vec.Capacity() >= 10 && vec.Capacity() < 20);
+}
+
+TEST(IteratorsAndProxies) {
+    static_assert(std::random_access_iterator<PackedVector<9>::ConstIterator>);
+    static_assert(std::is_convertible_v<PackedVector<9>::Iterator, PackedVector<9>::ConstIterator>);
+
+    PackedVector<9> vec;
+    for (uint64_t value = 0; value < 300; value++) {
+        vec.PushBack((value * 37) % 512);
+    }
+
+    PackedVector<9>::Iterator iter = vec.Begin() + 10;
+    *iter = 500;
+    iter[1] = vec[0];
+    CHECK(vec[10] == 500 && vec[11] == 0);
+    CHECK(vec.End() - vec.Begin() == 300);
+    CHECK((vec.Begin() < iter) && (iter - 10 == vec.Begin()));
+
+    PackedVector<9>::ConstIterator const_iter = iter;
+    CHECK(*const_iter == 500);
+
+    swap(vec[0], vec[10]);
+    CHECK(vec[0] == 500 && vec[10] == 0);
+
+    uint64_t max_value = *std::max_element(vec.begin(), vec.end());
+    std::sort(vec.begin(), vec.end());
+    CHECK(std::is_sorted(vec.begin(), vec.end()));
+    CHECK(vec.Back() == max_value);
+    CHECK(vec.Size() == 300);
+}
+
+}  // namespace
+
+TEST_MAIN()
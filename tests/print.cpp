@@ -0,0 +1,105 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <string>
+#include <string_view>
+
+#include <safe/print.hpp>
+
+#include "test.hpp"
+
+namespace {
+
+using stdlike::Vector;
+
+/* Collects what Print writes to a FILE* */
+class Capture {
+public:
+    Capture() : file_(open_memstream(&data_, &size_)) {
+    }
+
+    Capture(const Capture&) = delete;
+    Capture& operator=(const Capture&) = delete;
+
+    ~Capture() {
+        std::fclose(file_);
+        std::free(data_);
+    }
+
+    FILE* File() const {
+        return file_;
+    }
+
+    std::string Text() {
+        std::fflush(file_);
+        return std::string(data_, size_);
+    }
+
+private:
+    char* data_ = nullptr;
+    size_t size_ = 0;
+    FILE* file_ = nullptr;
+};
+
+TEST(Placeholders) {
+    Capture out;
+    safe::Print(out.File(), "x = %, y = %\n", 1, -2.5);
+    safe::Print(out.File(), "100%% done, % left%%\n", 0u);
+    safe::Print(out.File(), "no placeholders");
+    CHECK(out.Text() == "x = 1, y = -2.5\n100% done, 0 left%\nno placeholders");
+}
+
+TEST(ArgumentKinds) {
+    Capture out;
+    std::string name = "vec";
+    std::string_view view = "view";
+    safe::Print(out.File(), "%|%|%|%|%|%", true, false, 'c', name, view, "literal");
+    CHECK(out.Text() == "true|false|c|vec|view|literal");
+
+    Capture limits;
+    safe::Print(limits.File(), "% %", std::numeric_limits<int64_t>::min(), std::numeric_limits<uint64_t>::max());
+    CHECK(limits.Text() == "-9223372036854775808 18446744073709551615");
+}
+
+TEST(Pointers) {
+    Capture out;
+    int value = 0;
+    safe::Print(out.File(), "%", &value);
+    char expected[64];
+    std::snprintf(expected, sizeof(expected), "%p", static_cast<void*>(&value));
+    CHECK(out.Text() == expected);
+
+    Capture null;
+    const char* missing = nullptr;
+    safe::Print(null.File(), "[%]", missing);
+    CHECK(null.Text() == "[(null)]");
+}
+
+TEST(Vectors) {
+    Capture out;
+    Vector<int> ints(3, 7);
+    Vector<double> empty;
+    Vector<bool> bits(2, true);
+    bits.PushBack(false);
+    safe::Print(out.File(), "% % %", ints, empty, bits);
+    CHECK(out.Text() == "[7, 7, 7] [] [1, 1, 0]");
+}
+
+TEST(OutputLongerThanTheBuffer) {
+    Capture out;
+    std::string text(10000, 'a');
+    Vector<uint64_t> vec(2000, 123456789);
+    safe::Print(out.File(), "%-%", text, vec);
+
+    std::string result = out.Text();
+    CHECK(result.size() == 10000 + 1 + 2 + 2000 * 9 + 1999 * 2);
+    CHECK(result.compare(0, 10000, text) == 0);
+    CHECK(result.substr(10000, 11) == "-[123456789");
+    CHECK(result.back() == ']');
+}
+
+}  // namespace
+
+TEST_MAIN()
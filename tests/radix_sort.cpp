@@ -0,0 +1,177 @@
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <stdlike/algorithm.hpp>
+#include <stdlike/vector.hpp>
+
+#include "test.hpp"
+
+namespace {
+
+using stdlike::par;
+using stdlike::Vector;
+
+constexpr size_t kLarge = stdlike::kParallelThreshold * 4 + 123;
+
+template <typename Type>
+Vector<Type> Random(size_t size, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    Vector<Type> vec;
+    for (size_t pos = 0; pos < size; pos++) {
+        if constexpr (std::is_floating_point_v<Type>) {
+            double mantissa = static_cast<double>(rng() % 2000) - 1000.0;
+            vec.PushBack(static_cast<Type>(std::ldexp(mantissa, int(rng() % 40) - 20)));
+        } else {
+            vec.PushBack(static_cast<Type>(rng()));
+        }
+    }
+    return vec;
+}
+
+/* Serial and parallel radix sort give what std::sort gives */
+template <typename Type>
+void CheckAgainstStdSort(size_t size) {
+    Vector<Type> serial = Random<Type>(size, size);
+    Vector<Type> parallel = serial;
+    std::vector<Type> expected(serial.begin(), serial.end());
+    std::sort(expected.begin(), expected.end());
+
+    stdlike::RadixSort(serial);
+    stdlike::RadixSort(par, parallel);
+    CHECK(std::equal(serial.begin(), serial.end(), expected.begin(), expected.end()));
+    CHECK(parallel == serial);
+}
+
+TEST(MatchesStdSort) {
+    for (size_t size : {size_t(0), size_t(1), size_t(255), size_t(256), size_t(1000), kLarge}) {
+        CheckAgainstStdSort<uint8_t>(size);
+        CheckAgainstStdSort<int16_t>(size);
+        CheckAgainstStdSort<uint32_t>(size);
+        CheckAgainstStdSort<int32_t>(size);
+        CheckAgainstStdSort<uint64_t>(size);
+        CheckAgainstStdSort<int64_t>(size);
+        CheckAgainstStdSort<float>(size);
+        CheckAgainstStdSort<double>(size);
+    }
+}
+
+TEST(ExtremesAndConstantDigits) {
+    Vector<int64_t> vec;
+    for (size_t pos = 0; pos < 1000; pos++) {
+        vec.PushBack(pos % 3 == 0 ? std::numeric_limits<int64_t>::min() : std::numeric_limits<int64_t>::max());
+        vec.PushBack(-1);
+        vec.PushBack(0);
+    }
+    stdlike::RadixSort(vec);
+    CHECK(std::is_sorted(vec.begin(), vec.end()));
+    CHECK(vec[0] == std::numeric_limits<int64_t>::min());
+    CHECK(vec.Back() == std::numeric_limits<int64_t>::max());
+
+    /* Every digit is the same, nothing moves */
+    Vector<uint32_t> same(1000, 0xdeadbeef);
+    stdlike::RadixSort(par, same);
+    CHECK(same == Vector<uint32_t>(1000, 0xdeadbeef));
+}
+
+TEST(FloatTotalOrder) {
+    double nan = std::numeric_limits<double>::quiet_NaN();
+    double inf = std::numeric_limits<double>::infinity();
+    Vector<double> vec;
+    for (size_t round = 0; round < 100; round++) {
+        for (double value : {nan, -nan, inf, -inf, 0.0, -0.0, 1.5, -1.5, std::numeric_limits<double>::denorm_min()}) {
+            vec.PushBack(value);
+        }
+    }
+    stdlike::RadixSort(vec);
+
+    CHECK(std::isnan(vec[0]) && std::signbit(vec[0]));
+    CHECK(std::isinf(vec[100]) && vec[100] < 0);
+    CHECK(std::fpclassify(vec[300]) == FP_ZERO && std::signbit(vec[300]) && !std::signbit(vec[400]));
+    CHECK(std::isnan(vec.Back()) && !std::signbit(vec.Back()));
+    for (size_t pos = 1; pos < vec.Size(); pos++) {
+        CHECK(!(vec[pos] < vec[pos - 1]));
+    }
+}
+
+struct Record {
+    uint32_t id;
+    int16_t group;
+    float score;
+};
+
+TEST(KeyExtractorIsStable) {
+    for (size_t size : {size_t(100), size_t(5000), kLarge}) {
+        std::mt19937 rng(3);
+        Vector<Record> serial;
+        for (uint32_t id = 0; id < size; id++) {
+            int16_t group = static_cast<int16_t>(static_cast<int>(rng() % 64) - 32);
+            serial.PushBack({id, group, static_cast<float>(rng() % 7)});
+        }
+        Vector<Record> parallel = serial;
+
+        auto group = [](const Record& record) {
+            return record.group;
+        };
+        stdlike::RadixSort(serial, group);
+        stdlike::RadixSort(par, parallel, group);
+
+        for (size_t pos = 1; pos < size; pos++) {
+            const Record& prev = serial[pos - 1];
+            const Record& cur = serial[pos];
+            CHECK(prev.group < cur.group || (prev.group == cur.group && prev.id < cur.id));
+            CHECK(parallel[pos].id == cur.id);
+        }
+    }
+
+    /* A key returned by reference */
+    Vector<Record> by_score;
+    for (uint32_t id = 0; id < 1000; id++) {
+        by_score.PushBack({id, 0, static_cast<float>(1000 - id)});
+    }
+    stdlike::RadixSort(by_score, [](const Record& record) -> const float& {
+        return record.score;
+    });
+    CHECK(by_score[0].id == 999 && by_score[999].id == 0);
+}
+
+TEST(ThrowingKeyReleasesTheScratch) {
+    for (size_t size : {size_t(1000), kLarge}) {
+        Vector<uint32_t> vec = Random<uint32_t>(size, 4);
+        std::atomic<size_t> calls = 0;
+        auto key = [&calls, size](uint32_t value) {
+            if (calls.fetch_add(1) == size + size / 2) {
+                throw std::runtime_error("key");
+            }
+            return value;
+        };
+        CHECK_THROWS(stdlike::RadixSort(vec, key), std::runtime_error);
+        calls = 0;
+        CHECK_THROWS(stdlike::RadixSort(par, vec.Data(), vec.Data() + vec.Size(), key), std::runtime_error);
+    }
+}
+
+TEST(PointerRanges) {
+    Vector<uint32_t> vec = Random<uint32_t>(3000, 9);
+    std::vector<uint32_t> expected(vec.begin() + 1000, vec.begin() + 2000);
+    std::sort(expected.begin(), expected.end());
+
+    uint32_t head = vec[0];
+    stdlike::RadixSort(vec.Data() + 1000, vec.Data() + 2000);
+    CHECK(std::equal(expected.begin(), expected.end(), vec.Data() + 1000));
+    CHECK(vec[0] == head);
+
+    stdlike::RadixSort(par, vec.Data(), vec.Data());
+    stdlike::RadixSort(par, vec.Data(), vec.Data() + vec.Size());
+    CHECK(std::is_sorted(vec.begin(), vec.end()));
+}
+
+}  // namespace
+
+TEST_MAIN()
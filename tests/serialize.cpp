@@ -0,0 +1,211 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+
+#include <unistd.h>
+
+#include <stdlike/serialize.hpp>
+
+#include "test.hpp"
+
+namespace {
+
+using stdlike::BinaryHeader;
+using stdlike::BinaryView;
+using stdlike::Vector;
+
+/* Both ends of a pipe, small payloads fit into its buffer */
+class Pipe {
+public:
+    Pipe() {
+        if (::pipe(fds_) != 0) {
+            throw std::runtime_error("pipe");
+        }
+    }
+
+    ~Pipe() {
+        ::close(fds_[0]);
+        this->CloseWriteEnd();
+    }
+
+    void CloseWriteEnd() {
+        if (fds_[1] >= 0) {
+            ::close(fds_[1]);
+            fds_[1] = -1;
+        }
+    }
+
+    int ReadEnd() const {
+        return fds_[0];
+    }
+
+    int WriteEnd() const {
+        return fds_[1];
+    }
+
+private:
+    int fds_[2] = {-1, -1};
+};
+
+template <typename VectorType>
+VectorType RoundTrip(const VectorType& vec) {
+    Pipe pipe;
+    stdlike::Write(pipe.WriteEnd(), vec);
+    VectorType result;
+    stdlike::Read(pipe.ReadEnd(), result);
+    return result;
+}
+
+template <typename VectorType>
+bool Equal(const VectorType& lhs, const VectorType& rhs) {
+    if (lhs.Size() != rhs.Size()) {
+        return false;
+    }
+    for (size_t pos = 0; pos < lhs.Size(); pos++) {
+        if (lhs[pos] != rhs[pos]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Header followed by payload_bytes of zeros, as a buffer for BinaryView */
+Vector<uint64_t> Serialized(const BinaryHeader& header) {
+    Vector<uint64_t> buffer(sizeof(BinaryHeader) / 8 + header.payload_bytes / 8 + 1, 0);
+    std::memcpy(buffer.Data(), &header, sizeof(header));
+    return buffer;
+}
+
+TEST(RoundTripElements) {
+    Vector<uint32_t> vec;
+    for (uint32_t value = 0; value < 1000; value++) {
+        vec.PushBack(value * 7);
+    }
+    CHECK(Equal(RoundTrip(vec), vec));
+    CHECK(RoundTrip(Vector<double>()).Empty());
+}
+
+TEST(RoundTripBits) {
+    for (size_t size : {size_t(0), size_t(1), size_t(31), size_t(32), size_t(33), size_t(1000)}) {
+        Vector<bool> bits;
+        stdlike::BitVector<stdlike::BitOrder::kLsbFirst> lsb_bits;
+        for (size_t pos = 0; pos < size; pos++) {
+            bits.PushBack(pos % 3 == 0);
+            lsb_bits.PushBack(pos % 5 == 0);
+        }
+        CHECK(Equal(RoundTrip(bits), bits));
+        CHECK(Equal(RoundTrip(lsb_bits), lsb_bits));
+    }
+}
+
+TEST(BitOrderMismatch) {
+    Pipe pipe;
+    stdlike::Write(pipe.WriteEnd(), Vector<bool>(10, true));
+    stdlike::BitVector<stdlike::BitOrder::kLsbFirst> bits;
+    CHECK_THROWS(stdlike::Read(pipe.ReadEnd(), bits), std::runtime_error);
+}
+
+TEST(TypeMismatchAndCorruption) {
+    {
+        Pipe pipe;
+        stdlike::Write(pipe.WriteEnd(), Vector<uint32_t>(10, 1));
+        Vector<uint64_t> wide;
+        CHECK_THROWS(stdlike::Read(pipe.ReadEnd(), wide), std::runtime_error);
+    }
+    {
+        Pipe pipe;
+        stdlike::Write(pipe.WriteEnd(), Vector<uint32_t>(10, 1));
+        Vector<bool> bits;
+        CHECK_THROWS(stdlike::Read(pipe.ReadEnd(), bits), std::runtime_error);
+    }
+    {
+        Pipe pipe;
+        BinaryHeader header;
+        header.magic = 0;
+        CHECK(::write(pipe.WriteEnd(), &header, sizeof(header)) == sizeof(header));
+        Vector<int> vec;
+        CHECK_THROWS(stdlike::Read(pipe.ReadEnd(), vec), std::runtime_error);
+    }
+}
+
+TEST(TruncatedStream) {
+    Pipe pipe;
+    BinaryHeader header;
+    header.element_size = sizeof(int);
+    header.size = 4;
+    header.payload_bytes = 16;
+    CHECK(::write(pipe.WriteEnd(), &header, sizeof(header)) == sizeof(header));
+    pipe.CloseWriteEnd();
+
+    Vector<int> vec;
+    CHECK_THROWS(stdlike::Read(pipe.ReadEnd(), vec), std::runtime_error);
+}
+
+TEST(OverflowingSizeIsRejected) {
+    /* size * element_size wraps around to a small, matching payload_bytes */
+    BinaryHeader header;
+    header.element_size = sizeof(uint64_t);
+    header.size = (uint64_t(1) << 61) + 1;
+    header.payload_bytes = header.size * sizeof(uint64_t);
+    CHECK(header.payload_bytes == 8);
+
+    Vector<uint64_t> buffer = Serialized(header);
+    CHECK_THROWS(BinaryView<uint64_t>(buffer.Data(), buffer.Size() * 8, false), std::runtime_error);
+
+    Pipe pipe;
+    CHECK(::write(pipe.WriteEnd(), buffer.Data(), buffer.Size() * 8) == ssize_t(buffer.Size() * 8));
+    Vector<uint64_t> vec;
+    CHECK_THROWS(stdlike::Read(pipe.ReadEnd(), vec, false), std::runtime_error);
+
+    /* (size + 31) / 32 wraps for bit vectors */
+    BinaryHeader bits_header;
+    bits_header.flags = stdlike::BinaryHeader::kBitVector;
+    bits_header.element_size = sizeof(uint32_t);
+    bits_header.size = UINT64_MAX - 3;
+    bits_header.payload_bytes = 0;
+    Pipe bits_pipe;
+    CHECK(::write(bits_pipe.WriteEnd(), &bits_header, sizeof(bits_header)) == sizeof(bits_header));
+    Vector<bool> bits;
+    CHECK_THROWS(stdlike::Read(bits_pipe.ReadEnd(), bits, false), std::runtime_error);
+}
+
+TEST(BinaryViewInPlace) {
+    Vector<int32_t> vec;
+    for (int32_t value = 0; value < 100; value++) {
+        vec.PushBack(-value);
+    }
+
+    Pipe pipe;
+    stdlike::Write(pipe.WriteEnd(), vec);
+    Vector<uint64_t> buffer(sizeof(BinaryHeader) / 8 + 50, 0);
+    CHECK(::read(pipe.ReadEnd(), buffer.Data(), sizeof(BinaryHeader) + 400) == ssize_t(sizeof(BinaryHeader) + 400));
+
+    BinaryView<int32_t> view(buffer.Data(), sizeof(BinaryHeader) + 400);
+    CHECK(view.Size() == 100);
+    CHECK(view[99] == -99);
+
+    CHECK_THROWS(BinaryView<int32_t>(buffer.Data(), sizeof(BinaryHeader) + 399), std::runtime_error);
+    CHECK_THROWS(BinaryView<int32_t>(buffer.Data(), 10), std::runtime_error);
+    buffer[sizeof(BinaryHeader) / 8] ^= 1;
+    CHECK_THROWS(BinaryView<int32_t>(buffer.Data(), sizeof(BinaryHeader) + 400), std::runtime_error);
+}
+
+TEST(FileHelpers) {
+    std::filesystem::path path =
+        std::filesystem::temp_directory_path() / (std::to_string(::getpid()) + "_serialize.vec");
+    Vector<uint16_t> vec(1000, 42);
+    stdlike::WriteFile(path.c_str(), vec);
+
+    Vector<uint16_t> result;
+    stdlike::ReadFile(path.c_str(), result);
+    std::filesystem::remove(path);
+    CHECK(Equal(result, vec));
+    CHECK_THROWS(stdlike::ReadFile(path.c_str(), result), std::system_error);
+}
+
+}  // namespace
+
+TEST_MAIN()
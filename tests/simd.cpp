@@ -0,0 +1,168 @@
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+
+#include <stdlike/simd.hpp>
+
+#include "test.hpp"
+
+namespace {
+
+using stdlike::Vector;
+
+/* Runs check(find, count) for every kernel level the CPU has */
+template <typename Type, typename Check>
+void ForEachLevel(Check check) {
+    check(
+        [](const Type* data, size_t size, Type value) {
+            return stdlike::detail::scalar::Find(data, size, value);
+        },
+        [](const Type* data, size_t size, Type value) {
+            return stdlike::detail::scalar::Count(data, size, value);
+        });
+#if STDLIKE_SIMD_X86
+    if (__builtin_cpu_supports("avx2")) {
+        check(
+            [](const Type* data, size_t size, Type value) {
+                return stdlike::detail::avx2::Find(data, size, value);
+            },
+            [](const Type* data, size_t size, Type value) {
+                return stdlike::detail::avx2::Count(data, size, value);
+            });
+    }
+    if (__builtin_cpu_supports("avx512f")) {
+        check(
+            [](const Type* data, size_t size, Type value) {
+                return stdlike::detail::avx512::Find(data, size, value);
+            },
+            [](const Type* data, size_t size, Type value) {
+                return stdlike::detail::avx512::Count(data, size, value);
+            });
+    }
+#endif
+}
+
+template <typename Type>
+void CheckFindAndCount() {
+    ForEachLevel<Type>([](auto find, auto count) {
+        /* Every size up to a few registers, the value at every position */
+        for (size_t size = 0; size < 70; size++) {
+            Vector<Type> vec(size, Type(1));
+            CHECK(find(vec.Data(), size, Type(2)) == size);
+            CHECK(count(vec.Data(), size, Type(1)) == size);
+            for (size_t pos = 0; pos < size; pos++) {
+                vec[pos] = Type(2);
+                CHECK(find(vec.Data(), size, Type(2)) == pos);
+                CHECK(count(vec.Data(), size, Type(2)) == 1);
+                vec[pos] = Type(1);
+            }
+        }
+    });
+}
+
+TEST(FindAndCountAtEveryLevel) {
+    CheckFindAndCount<int32_t>();
+    CheckFindAndCount<int64_t>();
+    CheckFindAndCount<float>();
+    CheckFindAndCount<double>();
+}
+
+TEST(MixedValueTypes) {
+    Vector<long> longs(10, 3);
+    longs[7] = 5;
+    CHECK(stdlike::Find(longs, 5) == 7);
+    CHECK(stdlike::Count(longs, 3) == 9);
+    CHECK(stdlike::Contains(longs, 5));
+
+    Vector<double> doubles(10, 0.5);
+    doubles[2] = 1;
+    CHECK(stdlike::Find(doubles, 1) == 2);
+    CHECK(stdlike::Count(doubles, 0.5f) == 9);
+
+    Vector<float> floats(10, 0.25f);
+    CHECK(stdlike::Count(floats, 0.25) == 10);
+    CHECK(!stdlike::Contains(floats, 1));
+
+    Vector<int32_t> ints(5, 1);
+    CHECK(stdlike::Find(ints.Data(), ints.Data() + ints.Size(), 1L) == ints.Data());
+    CHECK(stdlike::Count(ints.Data(), ints.Data() + ints.Size(), '\1') == 5);
+}
+
+TEST(EmptyVectors) {
+    Vector<int32_t> empty;
+    CHECK(stdlike::Find(empty, 0) == 0);
+    CHECK(stdlike::Count(empty, 0) == 0);
+    CHECK(!stdlike::Contains(empty, 0));
+    CHECK(stdlike::Sum(empty) == 0);
+    CHECK(stdlike::ArgMax(empty) == 0);
+
+    stdlike::MinMaxResult<int32_t> minmax = stdlike::MinMax(empty);
+    CHECK(minmax.min == std::numeric_limits<int32_t>::max());
+    CHECK(minmax.max == std::numeric_limits<int32_t>::lowest());
+
+    stdlike::MinMaxResult<double> float_minmax = stdlike::MinMax(Vector<double>());
+    CHECK(std::isinf(float_minmax.min) && float_minmax.min > 0);
+    CHECK(std::isinf(float_minmax.max) && float_minmax.max < 0);
+}
+
+TEST(FloatingPointEquality) {
+    double nan = std::numeric_limits<double>::quiet_NaN();
+    Vector<double> vec(40, nan);
+    CHECK(stdlike::Find(vec, nan) == vec.Size());
+    CHECK(stdlike::Count(vec, nan) == 0);
+
+    vec[33] = -0.0;
+    CHECK(stdlike::Find(vec, 0.0) == 33);
+
+    /* NaNs are skipped by MinMax and ArgMax */
+    vec[10] = 7.0;
+    vec[20] = -7.0;
+    stdlike::MinMaxResult<double> minmax = stdlike::MinMax(vec);
+    CHECK(minmax.min < -6.5 && minmax.max > 6.5);
+    CHECK(stdlike::ArgMax(vec) == 10);
+    CHECK(stdlike::ArgMax(Vector<float>(5, std::numeric_limits<float>::quiet_NaN())) == 5);
+}
+
+TEST(ReductionsMatchScalarLoops) {
+    std::mt19937 random(11);
+    for (size_t size : {size_t(1), size_t(7), size_t(15), size_t(16), size_t(17), size_t(1000), size_t(1023)}) {
+        Vector<int32_t> ints;
+        Vector<int64_t> longs;
+        Vector<float> floats;
+        int64_t int_sum = 0;
+        int64_t long_sum = 0;
+        int32_t int_max = std::numeric_limits<int32_t>::lowest();
+        size_t int_argmax = 0;
+        for (size_t pos = 0; pos < size; pos++) {
+            int32_t value = static_cast<int32_t>(random());
+            ints.PushBack(value);
+            int_sum += value;
+            if (value > int_max) {
+                int_max = value;
+                int_argmax = pos;
+            }
+
+            longs.PushBack(static_cast<int64_t>(random()) << 20);
+            long_sum += longs.Back();
+            floats.PushBack(static_cast<float>(random() % 1000));
+        }
+
+        CHECK(stdlike::Sum(ints) == int_sum);
+        CHECK(stdlike::Sum(longs) == long_sum);
+        CHECK(stdlike::MinMax(ints).max == int_max);
+        CHECK(stdlike::ArgMax(ints) == int_argmax);
+
+        /* Integer valued floats add up exactly in double precision */
+        double float_sum = 0;
+        for (float value : floats) {
+            float_sum += value;
+        }
+        CHECK(std::fabs(stdlike::Sum(floats) - float_sum) < 0.5);
+    }
+}
+
+}  // namespace
+
+TEST_MAIN()
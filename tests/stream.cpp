@@ -0,0 +1,203 @@
+#include <cstddef>
+#include <cstdint>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+#include <unistd.h>
+
+#include <stdlike/stream.hpp>
+
+#include "test.hpp"
+
+namespace {
+
+using stdlike::Vector;
+using stdlike::VectorReader;
+using stdlike::VectorWriter;
+
+class Pipe {
+public:
+    Pipe() {
+        if (::pipe(fds_) != 0) {
+            throw std::runtime_error("pipe");
+        }
+    }
+
+    ~Pipe() {
+        ::close(fds_[0]);
+        this->CloseWriteEnd();
+    }
+
+    void CloseWriteEnd() {
+        if (fds_[1] >= 0) {
+            ::close(fds_[1]);
+            fds_[1] = -1;
+        }
+    }
+
+    int ReadEnd() const {
+        return fds_[0];
+    }
+
+    int WriteEnd() const {
+        return fds_[1];
+    }
+
+private:
+    int fds_[2] = {-1, -1};
+};
+
+/* Streams size elements through a pipe in chunks of chunk_size, the writer runs in its own thread */
+Vector<uint64_t> RoundTrip(size_t size, size_t chunk_size) {
+    Pipe pipe;
+    std::thread producer([&pipe, size, chunk_size]() {
+        VectorWriter<uint64_t> writer(pipe.WriteEnd(), chunk_size);
+        for (uint64_t value = 0; value < size; value++) {
+            writer.PushBack(value * value);
+        }
+        writer.Close();
+    });
+
+    Vector<uint64_t> result;
+    {
+        VectorReader<uint64_t> reader(pipe.ReadEnd(), chunk_size);
+        reader.ReadAll(result);
+    }
+    producer.join();
+    return result;
+}
+
+TEST(RoundTripThroughPipe) {
+    for (size_t size : {size_t(0), size_t(1), size_t(999), size_t(1000), size_t(100000)}) {
+        Vector<uint64_t> result = RoundTrip(size, 1000);
+        CHECK(result.Size() == size);
+        for (size_t pos = 0; pos < result.Size(); pos++) {
+            CHECK(result[pos] == pos * pos);
+        }
+    }
+}
+
+TEST(NextHandsOutFrames) {
+    Pipe pipe;
+    std::thread producer([&pipe]() {
+        VectorWriter<int32_t> writer(pipe.WriteEnd(), 4);
+        Vector<int32_t> values(10, 7);
+        writer.Write(values);
+        writer.Flush();
+        writer.PushBack(8);
+    });
+
+    VectorReader<int32_t> reader(pipe.ReadEnd(), 4);
+    Vector<int32_t> chunk;
+    size_t frames = 0;
+    size_t elements = 0;
+    while (reader.Next(chunk)) {
+        CHECK(chunk.Size() <= 4);
+        frames++;
+        elements += chunk.Size();
+    }
+    producer.join();
+    CHECK(elements == 11);
+    CHECK(frames == 4);
+}
+
+TEST(PlainVectorIsNotAStream) {
+    Pipe pipe;
+    stdlike::Write(pipe.WriteEnd(), Vector<uint64_t>(10, 1));
+    CHECK_THROWS(VectorReader<uint64_t>(pipe.ReadEnd()), std::runtime_error);
+}
+
+TEST(StreamIsNotAPlainVector) {
+    Pipe pipe;
+    {
+        VectorWriter<uint64_t> writer(pipe.WriteEnd());
+        writer.Write(Vector<uint64_t>(10, 1));
+    }
+    Vector<uint64_t> vec;
+    CHECK_THROWS(stdlike::Read(pipe.ReadEnd(), vec, false), std::runtime_error);
+}
+
+TEST(WritesAfterCloseThrow) {
+    Pipe pipe;
+    VectorWriter<uint32_t> writer(pipe.WriteEnd());
+    writer.PushBack(1);
+    writer.Close();
+    writer.Close();
+    CHECK_THROWS(writer.PushBack(2), std::logic_error);
+    CHECK_THROWS(writer.Write(Vector<uint32_t>(3, 1)), std::logic_error);
+    CHECK_THROWS(writer.Flush(), std::logic_error);
+
+    /* What was written before Close is a complete stream */
+    VectorReader<uint32_t> reader(pipe.ReadEnd());
+    Vector<uint32_t> result;
+    reader.ReadAll(result);
+    CHECK(result.Size() == 1 && result[0] == 1);
+}
+
+TEST(ElementTypeMismatch) {
+    Pipe pipe;
+    {
+        VectorWriter<uint32_t> writer(pipe.WriteEnd());
+        writer.PushBack(1);
+    }
+    CHECK_THROWS(VectorReader<uint64_t>(pipe.ReadEnd()), std::runtime_error);
+}
+
+TEST(OversizedFrameIsRejected) {
+    Pipe pipe;
+    {
+        VectorWriter<uint8_t> writer(pipe.WriteEnd(), 100);
+        writer.Write(Vector<uint8_t>(100, 1));
+    }
+
+    VectorReader<uint8_t> reader(pipe.ReadEnd(), 10);
+    Vector<uint8_t> chunk;
+    CHECK_THROWS(reader.Next(chunk), std::runtime_error);
+}
+
+TEST(TruncatedStream) {
+    Pipe pipe;
+    {
+        stdlike::BinaryHeader header;
+        header.flags = stdlike::BinaryHeader::kStream;
+        header.element_size = sizeof(uint16_t);
+        uint64_t elems_n = 5;
+        CHECK(::write(pipe.WriteEnd(), &header, sizeof(header)) == sizeof(header));
+        CHECK(::write(pipe.WriteEnd(), &elems_n, sizeof(elems_n)) == sizeof(elems_n));
+        pipe.CloseWriteEnd();
+    }
+
+    VectorReader<uint16_t> reader(pipe.ReadEnd());
+    Vector<uint16_t> chunk;
+    CHECK_THROWS(reader.Next(chunk), std::runtime_error);
+}
+
+TEST(DestroyWhileWaitingForData) {
+    /* The writer sends the header and then stalls with the pipe open */
+    Pipe pipe;
+    stdlike::BinaryHeader header;
+    header.flags = stdlike::BinaryHeader::kStream;
+    header.element_size = sizeof(uint32_t);
+    CHECK(::write(pipe.WriteEnd(), &header, sizeof(header)) == sizeof(header));
+
+    {
+        VectorReader<uint32_t> reader(pipe.ReadEnd());
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    /* Also in the middle of a frame */
+    uint64_t elems_n = 100;
+    uint32_t first = 1;
+    CHECK(::write(pipe.WriteEnd(), &header, sizeof(header)) == sizeof(header));
+    CHECK(::write(pipe.WriteEnd(), &elems_n, sizeof(elems_n)) == sizeof(elems_n));
+    CHECK(::write(pipe.WriteEnd(), &first, sizeof(first)) == sizeof(first));
+    {
+        VectorReader<uint32_t> reader(pipe.ReadEnd());
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+}
+
+}  // namespace
+
+TEST_MAIN()
@@ -0,0 +1,131 @@
+#ifndef TESTS_TEST_HPP
+#define TESTS_TEST_HPP
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <string>
+#include <utility>
+
+/*
+ * Minimal test harness, the counterpart of bench/benchmark.hpp:
+ *
+ *   TEST(PushBackGrows) {
+ *       stdlike::Vector<int> vec;
+ *       vec.PushBack(1);
+ *       CHECK(vec.Size() == 1);
+ *       CHECK_THROWS(vec.Reserve(SIZE_MAX), std::bad_alloc);
+ *   }
+ *   TEST_MAIN()
+ *
+ * A failed CHECK prints its location and ends the current test, the other
+ * tests still run. The exit status is non-zero if any test failed, so
+ * ctest and make only need the status.
+ *
+ * Options: --filter=<substring>
+ */
+
+namespace test {
+
+/* Thrown by a failed CHECK, caught by the runner */
+struct Failure {
+    const char* file = nullptr;
+    int line = 0;
+    std::string what = "";
+};
+
+struct Test {
+    const char* name = nullptr;
+    void (*func)() = nullptr;
+};
+
+inline std::deque<Test>& Registry() {
+    static std::deque<Test> tests;
+    return tests;
+}
+
+inline bool Register(const char* name, void (*func)()) {
+    Registry().push_back({name, func});
+    return true;
+}
+
+[[noreturn]] inline void Fail(const char* file, int line, std::string what) {
+    throw Failure{file, line, std::move(what)};
+}
+
+#define TEST_CONCAT_IMPL(lhs, rhs) lhs##rhs
+#define TEST_CONCAT(lhs, rhs) TEST_CONCAT_IMPL(lhs, rhs)
+
+#define TEST(name)                                                                             \
+    static void TEST_CONCAT(Test_, name)();                                                    \
+    [[maybe_unused]] static const bool TEST_CONCAT(test_registered_, name) =                   \
+        ::test::Register(#name, TEST_CONCAT(Test_, name));                                     \
+    static void TEST_CONCAT(Test_, name)()
+
+#define CHECK(...)                                                      \
+    do {                                                                \
+        if (!(__VA_ARGS__)) {                                           \
+            ::test::Fail(__FILE__, __LINE__, "CHECK(" #__VA_ARGS__ ")"); \
+        }                                                               \
+    } while (false)
+
+#define CHECK_THROWS(expr, Exception)                                                           \
+    do {                                                                                        \
+        bool test_thrown_ = false;                                                              \
+        try {                                                                                   \
+            expr;                                                                               \
+        } catch (const Exception&) {                                                            \
+            test_thrown_ = true;                                                                \
+        }                                                                                       \
+        if (!test_thrown_) {                                                                    \
+            ::test::Fail(__FILE__, __LINE__, "CHECK_THROWS(" #expr ", " #Exception ") did not throw"); \
+        }                                                                                       \
+    } while (false)
+
+inline int RunTests(int argc, char** argv) {
+    const char* filter = "";
+    for (int arg = 1; arg < argc; arg++) {
+        if (std::strncmp(argv[arg], "--filter=", 9) == 0) {
+            filter = argv[arg] + 9;
+        } else {
+            std::fprintf(stderr, "unknown option %s\n", argv[arg]);
+            return 1;
+        }
+    }
+
+    int failed = 0;
+    size_t run = 0;
+    for (const Test& test : Registry()) {
+        if (std::strstr(test.name, filter) == nullptr) {
+            continue;
+        }
+
+        run++;
+        try {
+            test.func();
+            std::printf("[ OK ] %s\n", test.name);
+        } catch (const Failure& failure) {
+            std::printf("[FAIL] %s\n       %s:%d: %s\n", test.name, failure.file, failure.line, failure.what.c_str());
+            failed++;
+        } catch (const std::exception& error) {
+            std::printf("[FAIL] %s\n       unexpected exception: %s\n", test.name, error.what());
+            failed++;
+        }
+        std::fflush(stdout);
+    }
+
+    std::printf("%zu tests, %d failed\n", run, failed);
+    return failed == 0 ? 0 : 1;
+}
+
+}  // namespace test
+
+#define TEST_MAIN()                           \
+    int main(int argc, char** argv) {         \
+        return ::test::RunTests(argc, argv);  \
+    }
+
+#endif  // TESTS_TEST_HPP
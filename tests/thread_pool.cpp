@@ -0,0 +1,144 @@
+#include <cstddef>
+#include <cstdlib>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+#include <stdlike/execution.hpp>
+#include <stdlike/thread_pool.hpp>
+#include <stdlike/vector.hpp>
+
+#include "test.hpp"
+
+namespace {
+
+using stdlike::ThreadPool;
+
+TEST(SpawnAndJoin) {
+    ThreadPool pool(2);
+    ThreadPool::TaskGroup group;
+    std::atomic<size_t> done = 0;
+    for (size_t task = 0; task < 100; task++) {
+        pool.Spawn(group, [&done] {
+            done++;
+        });
+    }
+    pool.Join(group);
+    CHECK(group.Done());
+    CHECK(done == 100);
+}
+
+TEST(JoinRethrowsFirstException) {
+    ThreadPool pool(2);
+    ThreadPool::TaskGroup group;
+    std::atomic<size_t> done = 0;
+    for (size_t task = 0; task < 10; task++) {
+        pool.Spawn(group, [&done, task] {
+            if (task % 3 == 0) {
+                throw std::runtime_error("task failed");
+            }
+            done++;
+        });
+    }
+    CHECK_THROWS(pool.Join(group), std::runtime_error);
+    CHECK(done == 6);
+
+    /* The group is usable again after the rethrow */
+    pool.Spawn(group, [&done] {
+        done++;
+    });
+    pool.Join(group);
+    CHECK(done == 7);
+}
+
+TEST(NestedSpawn) {
+    ThreadPool pool(2);
+    ThreadPool::TaskGroup outer;
+    std::atomic<size_t> done = 0;
+    for (size_t task = 0; task < 8; task++) {
+        pool.Spawn(outer, [&pool, &done] {
+            ThreadPool::TaskGroup inner;
+            for (size_t sub = 0; sub < 8; sub++) {
+                pool.Spawn(inner, [&done] {
+                    done++;
+                });
+            }
+            pool.Join(inner);
+        });
+    }
+    pool.Join(outer);
+    CHECK(done == 64);
+}
+
+TEST(DestructorRunsQueuedTasks) {
+    ThreadPool::TaskGroup group;
+    std::atomic<size_t> done = 0;
+    {
+        ThreadPool pool(1);
+        for (size_t task = 0; task < 1000; task++) {
+            pool.Spawn(group, [&done] {
+                done++;
+            });
+        }
+    }
+    CHECK(group.Done());
+    CHECK(done == 1000);
+
+    /* Nobody but the destructor is left to run them */
+    {
+        ThreadPool pool(0);
+        for (size_t task = 0; task < 10; task++) {
+            pool.Spawn(group, [&done] {
+                done++;
+            });
+        }
+        CHECK(done == 1000);
+    }
+    CHECK(group.Done());
+    CHECK(done == 1010);
+}
+
+TEST(NoWorkers) {
+    /* The joining thread runs everything */
+    ThreadPool pool(0);
+    CHECK(pool.ThreadsCount() == 0);
+
+    std::atomic<size_t> sum = 0;
+    pool.ParallelFor(0, 1000, 10, [&sum](size_t begin, size_t end) {
+        sum += end - begin;
+    });
+    CHECK(sum == 1000);
+
+    ThreadPool::TaskGroup group;
+    pool.Spawn(group, [] {
+        throw std::logic_error("no worker needed");
+    });
+    CHECK_THROWS(pool.Join(group), std::logic_error);
+}
+
+TEST(DefaultCountsTheCaller) {
+    size_t hardware = std::thread::hardware_concurrency();
+    CHECK(stdlike::ConcurrencyLevel() == ThreadPool::Default().ThreadsCount() + 1);
+    if (std::getenv("STDLIKE_NUM_THREADS") == nullptr && hardware > 0) {
+        CHECK(stdlike::ConcurrencyLevel() == hardware);
+    }
+}
+
+TEST(ParallelForCoversRangeOnce) {
+    ThreadPool pool(3);
+    for (size_t size : {size_t(0), size_t(1), size_t(7), size_t(10000)}) {
+        stdlike::Vector<int> seen(size, 0);
+        pool.ParallelFor(0, size, 16, [&seen](size_t begin, size_t end) {
+            for (size_t pos = begin; pos < end; pos++) {
+                seen[pos]++;
+            }
+        });
+        for (size_t pos = 0; pos < size; pos++) {
+            CHECK(seen[pos] == 1);
+        }
+    }
+}
+
+}  // namespace
+
+TEST_MAIN()
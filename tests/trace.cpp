@@ -0,0 +1,190 @@
+#ifndef STDLIKE_TRACE
+#define STDLIKE_TRACE 1
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include <stdlike/vector.hpp>
+
+#include "test.hpp"
+
+namespace {
+
+using stdlike::Vector;
+using stdlike::trace::Event;
+using stdlike::trace::EventKind;
+
+/* Events of one kind recorded since the last drain */
+std::vector<Event> Drained(EventKind kind) {
+    std::vector<Event> events;
+    stdlike::trace::Drain(events);
+    std::erase_if(events, [kind](const Event& event) {
+        return event.kind != kind;
+    });
+    return events;
+}
+
+/* Traces everything from min_bytes up, restores the threshold on exit */
+class Threshold {
+public:
+    explicit Threshold(size_t min_bytes) : previous_(stdlike::trace::MinBytes()) {
+        stdlike::trace::SetMinBytes(min_bytes);
+        std::vector<Event> stale;
+        stdlike::trace::Drain(stale);
+    }
+
+    Threshold(const Threshold&) = delete;
+    Threshold& operator=(const Threshold&) = delete;
+
+    ~Threshold() {
+        stdlike::trace::SetMinBytes(previous_);
+    }
+
+private:
+    size_t previous_ = 0;
+};
+
+TEST(SmallOperationsAreNotTraced) {
+    Threshold threshold(1 << 20);
+    Vector<int> vec;
+    for (int value = 0; value < 1000; value++) {
+        vec.PushBack(value);
+    }
+    vec.Insert(vec.Begin(), 1);
+    vec.Erase(vec.Begin());
+    Vector<int> copy(vec);
+
+    std::vector<Event> events;
+    stdlike::trace::Drain(events);
+    CHECK(events.empty());
+}
+
+TEST(Reallocations) {
+    Threshold threshold(4096);
+    Vector<uint64_t> vec;
+    vec.Reserve(100);
+    vec.Reserve(1000);
+
+    std::vector<Event> events = Drained(EventKind::kReallocation);
+    CHECK(events.size() == 1);
+    CHECK(events[0].bytes == 1000 * sizeof(uint64_t));
+    CHECK(events[0].start_ns > 0);
+
+    Vector<bool> bits;
+    bits.Reserve(1 << 16);
+    events = Drained(EventKind::kReallocation);
+    CHECK(events.size() == 1);
+    CHECK(events[0].bytes == (1 << 16) / 8);
+}
+
+TEST(Shifts) {
+    Threshold threshold(1000);
+    Vector<int> vec(1000, 1);
+    vec.Insert(vec.Begin() + 10, 2);
+    vec.Erase(vec.Begin());
+    vec.Erase(vec.End() - 1);
+
+    std::vector<Event> events = Drained(EventKind::kShift);
+    CHECK(events.size() == 2);
+    CHECK(events[0].bytes == 990 * sizeof(int));
+    CHECK(events[1].bytes == 1001 * sizeof(int));
+
+    Vector<bool> bits(1 << 14, true);
+    bits.Insert(bits.Begin(), false);
+    events = Drained(EventKind::kShift);
+    CHECK(events.size() == 1);
+    CHECK(events[0].bytes == (1 << 14) / 8);
+}
+
+TEST(BulkCopies) {
+    Threshold threshold(1024);
+    Vector<int> empty;
+    Vector<int> empty_copy(empty);
+    CHECK(Drained(EventKind::kCopy).empty());
+
+    Vector<int> vec(1024, 3);
+    Vector<int> copy(vec);
+    std::vector<Event> events = Drained(EventKind::kCopy);
+    CHECK(events.size() == 1);
+    CHECK(events[0].bytes == 1024 * sizeof(int));
+}
+
+TEST(ThreadsGetTheirOwnRings) {
+    Threshold threshold(1);
+    uint32_t main_thread = 0;
+    {
+        Vector<int> vec;
+        vec.Reserve(16);
+        std::vector<Event> events = Drained(EventKind::kReallocation);
+        CHECK(events.size() == 1);
+        main_thread = events[0].thread;
+    }
+
+    /* Events of a finished thread are still drained */
+    std::thread worker([]() {
+        Vector<int> vec;
+        vec.Reserve(16);
+    });
+    worker.join();
+
+    std::vector<Event> events = Drained(EventKind::kReallocation);
+    CHECK(events.size() == 1);
+    CHECK(events[0].thread != main_thread);
+}
+
+TEST(FullRingDropsEvents) {
+    Threshold threshold(0);
+    Vector<int> vec;
+    for (size_t pos = 0; pos < stdlike::trace::detail::kRingCapacity + 10; pos++) {
+        vec.Reserve(pos + 1);
+    }
+
+    std::vector<Event> events;
+    uint64_t dropped = stdlike::trace::Drain(events);
+    CHECK(events.size() == stdlike::trace::detail::kRingCapacity);
+    CHECK(dropped >= 10);
+}
+
+TEST(ChromeTrace) {
+    Threshold threshold(4096);
+    Vector<char> vec;
+    vec.Reserve(1 << 13);
+    vec.Reserve(1 << 14);
+
+    std::filesystem::path path = std::filesystem::temp_directory_path() / (std::to_string(::getpid()) + "_trace.json");
+    CHECK(stdlike::trace::WriteChromeTrace(path.c_str()));
+
+    std::ifstream file(path);
+    std::stringstream text;
+    text << file.rdbuf();
+    std::filesystem::remove(path);
+
+    std::string json = text.str();
+    CHECK(json.find("\"traceEvents\": [") != std::string::npos);
+    CHECK(json.find("\"name\": \"Vector::Reallocate\"") != std::string::npos);
+    CHECK(json.find("\"bytes\": 8192}},\n") != std::string::npos);
+    CHECK(json.find("\"bytes\": 16384}}\n]}\n") != std::string::npos);
+
+    /* Events are written once */
+    CHECK(stdlike::trace::WriteChromeTrace(path.c_str()));
+    std::ifstream again(path);
+    std::stringstream again_text;
+    again_text << again.rdbuf();
+    std::filesystem::remove(path);
+    CHECK(again_text.str().find("Vector::Reallocate") == std::string::npos);
+
+    CHECK(!stdlike::trace::WriteChromeTrace("/nonexistent/trace.json"));
+}
+
+}  // namespace
+
+TEST_MAIN()
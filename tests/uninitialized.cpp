@@ -0,0 +1,162 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include <stdlike/vector.hpp>
+
+#include "test.hpp"
+
+namespace {
+
+using stdlike::Vector;
+
+/* Counts live objects and how they were made */
+struct Tracked {
+    static inline int64_t live = 0;
+    static inline int64_t copies = 0;
+
+    int value = -1;
+
+    Tracked() {
+        live++;
+    }
+
+    Tracked(const Tracked& other) : value(other.value) {
+        live++;
+        copies++;
+    }
+
+    Tracked& operator=(const Tracked& other) = default;
+
+    ~Tracked() {
+        live--;
+    }
+};
+
+TEST(DefaultInitConstructor) {
+    Vector<uint32_t> empty(stdlike::default_init, 0);
+    CHECK(empty.Empty());
+
+    Vector<uint32_t> vec(stdlike::default_init, 1000);
+    CHECK(vec.Size() == 1000);
+    CHECK(vec.Capacity() == 1000);
+    std::memset(vec.Data(), 0xff, vec.Size() * sizeof(uint32_t));
+    CHECK(vec[999] == UINT32_MAX);
+
+    {
+        Tracked::live = 0;
+        Tracked::copies = 0;
+        Vector<Tracked> objects(stdlike::default_init, 10);
+        CHECK(Tracked::live == 10);
+        CHECK(Tracked::copies == 0);
+        CHECK(objects[9].value == -1);
+    }
+    CHECK(Tracked::live == 0);
+
+    Vector<std::string> strings(stdlike::default_init, 3);
+    CHECK(strings[2].empty());
+}
+
+TEST(ResizeForOverwriteKeepsTrivialMemory) {
+    Vector<int> vec(10, 7);
+    vec.ResizeForOverwrite(2);
+    CHECK(vec.Size() == 2);
+    CHECK(vec.Capacity() == 10);
+
+    /* Growing within the capacity writes nothing */
+    vec.ResizeForOverwrite(10);
+    CHECK(vec.Size() == 10);
+    CHECK(vec[9] == 7);
+
+    vec.ResizeForOverwrite(100);
+    CHECK(vec.Size() == 100);
+    CHECK(vec[0] == 7 && vec[9] == 7);
+
+    vec.ResizeForOverwrite(0);
+    CHECK(vec.Empty());
+
+    Vector<int> empty;
+    empty.ResizeForOverwrite(0);
+    CHECK(empty.Empty() && empty.Capacity() == 0);
+}
+
+TEST(ResizeForOverwriteConstructsObjects) {
+    Tracked::live = 0;
+    Tracked::copies = 0;
+    {
+        Vector<Tracked> vec;
+        vec.ResizeForOverwrite(5);
+        CHECK(Tracked::live == 5);
+        vec[4].value = 4;
+
+        vec.ResizeForOverwrite(50);
+        CHECK(Tracked::live == 50);
+        CHECK(vec[4].value == 4);
+        CHECK(vec[49].value == -1);
+
+        vec.ResizeForOverwrite(3);
+        CHECK(Tracked::live == 3);
+    }
+    CHECK(Tracked::live == 0);
+}
+
+TEST(AppendUninitialized) {
+    Vector<uint8_t> vec;
+    CHECK(vec.AppendUninitialized(0) == vec.Data());
+    CHECK(vec.Empty());
+
+    /* Appending in pieces at least doubles the capacity */
+    size_t reallocations = 0;
+    for (size_t piece = 0; piece < 1000; piece++) {
+        const uint8_t* before = vec.Data();
+        uint8_t* tail = vec.AppendUninitialized(3);
+        reallocations += (vec.Data() != before);
+        CHECK(tail == vec.Data() + vec.Size() - 3);
+        tail[0] = tail[1] = tail[2] = static_cast<uint8_t>(piece);
+    }
+    CHECK(vec.Size() == 3000);
+    CHECK(reallocations <= 12);
+    CHECK(vec[0] == 0 && vec[2999] == static_cast<uint8_t>(999));
+
+    Tracked::live = 0;
+    {
+        Vector<Tracked> objects(2, Tracked());
+        Tracked* tail = objects.AppendUninitialized(3);
+        CHECK(tail == objects.Data() + 2);
+        CHECK(Tracked::live == 5);
+        CHECK(tail[2].value == -1);
+    }
+    CHECK(Tracked::live == 0);
+}
+
+TEST(Bits) {
+    Vector<bool> bits(stdlike::default_init, 70);
+    CHECK(bits.Size() == 70);
+    for (size_t pos = 0; pos < bits.Size(); pos++) {
+        bits[pos] = (pos % 2 == 0);
+    }
+
+    bits.ResizeForOverwrite(10);
+    CHECK(bits.Size() == 10);
+    bits.ResizeForOverwrite(70);
+    CHECK(bits.Size() == 70);
+    CHECK(bits[68] && !bits[69]);
+
+    Vector<bool>::Iterator tail = bits.AppendUninitialized(40);
+    CHECK(bits.Size() == 110);
+    CHECK(tail - bits.Begin() == 70);
+    for (size_t pos = 0; pos < 40; pos++) {
+        tail[static_cast<ptrdiff_t>(pos)] = true;
+    }
+    CHECK(bits[109] && bits[70]);
+
+    Vector<bool> empty;
+    CHECK(empty.AppendUninitialized(0) == empty.End());
+    empty.ResizeForOverwrite(0);
+    CHECK(empty.Empty());
+}
+
+}  // namespace
+
+TEST_MAIN()
@@ -0,0 +1,66 @@
+#include <cstddef>
+#include <string>
+
+#include <stdlike/vector.hpp>
+
+#include "test.hpp"
+
+namespace {
+
+using stdlike::Vector;
+
+bool AllAre(const Vector<std::string>& vec, const std::string& expected) {
+    for (const std::string& text : vec) {
+        if (text != expected) {
+            return false;
+        }
+    }
+    return true;
+}
+
+TEST(PushBackOwnElements) {
+    /* Long enough to live on the heap, so a dangling copy is caught */
+    std::string text(40, 'a');
+    Vector<std::string> vec(1, text);
+    vec.ShrinkToFit();
+    for (size_t round = 0; round < 20; round++) {
+        vec.PushBack(vec[0]);
+        vec.PushBack(vec.Back());
+    }
+    CHECK(vec.Size() == 41 && AllAre(vec, text));
+}
+
+TEST(InsertOwnElements) {
+    Vector<std::string> vec;
+    for (char chr = 'a'; chr < 'e'; chr++) {
+        vec.PushBack(std::string(40, chr));
+    }
+    vec.ShrinkToFit();
+
+    /* Growing, then shifting the value itself */
+    vec.Insert(vec.Begin() + 1, vec[3]);
+    CHECK(vec.Size() == 5 && vec[1] == std::string(40, 'd') && vec[4] == std::string(40, 'd'));
+    vec.Insert(vec.Begin(), vec[2]);
+    CHECK(vec[0] == std::string(40, 'b') && vec[3] == std::string(40, 'b'));
+    vec.Insert(vec.End(), vec[0]);
+    CHECK(vec.Back() == std::string(40, 'b') && vec.Size() == 7);
+}
+
+TEST(ResizeWithOwnElement) {
+    Vector<std::string> vec(2, std::string(40, 'x'));
+    vec.ShrinkToFit();
+    vec.Resize(100, vec[1]);
+    CHECK(vec.Size() == 100 && AllAre(vec, std::string(40, 'x')));
+
+    vec.ShrinkToFit();
+    vec.Resize(stdlike::par, 200, vec.Back());
+    CHECK(vec.Size() == 200 && AllAre(vec, std::string(40, 'x')));
+
+    Vector<std::string> empty;
+    empty.Resize(0, std::string());
+    CHECK(empty.Empty());
+}
+
+}  // namespace
+
+TEST_MAIN()
@@ -0,0 +1,128 @@
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <stdexcept>
+#include <string>
+
+#include <stdlike/execution.hpp>
+#include <stdlike/vector.hpp>
+
+#include "test.hpp"
+
+namespace {
+
+using stdlike::par;
+using stdlike::Vector;
+
+/* Large enough for ParallelFor to split the range into several chunks */
+constexpr size_t kLarge = stdlike::kParallelThreshold * 3 + 17;
+
+template <typename Type>
+bool Equal(const Vector<Type>& lhs, const Vector<Type>& rhs) {
+    if (lhs.Size() != rhs.Size()) {
+        return false;
+    }
+    for (size_t pos = 0; pos < lhs.Size(); pos++) {
+        if (lhs[pos] != rhs[pos]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+TEST(ParallelFillConstructor) {
+    Vector<int> vec(par, kLarge, 7);
+    CHECK(vec.Size() == kLarge);
+    CHECK(vec.Capacity() == kLarge);
+    for (size_t pos = 0; pos < vec.Size(); pos++) {
+        CHECK(vec[pos] == 7);
+    }
+}
+
+TEST(ParallelFillConstructorZeroValue) {
+    Vector<uint64_t> vec(par, kLarge, 0);
+    for (size_t pos = 0; pos < vec.Size(); pos++) {
+        CHECK(vec[pos] == 0);
+    }
+}
+
+TEST(ParallelFillConstructorEmpty) {
+    Vector<int> vec(par, 0, 1);
+    CHECK(vec.Empty());
+}
+
+TEST(ParallelCopyConstructor) {
+    Vector<std::string> source(kLarge / 16, std::string("long enough to live on the heap"));
+    source.PushBack("last");
+    Vector<std::string> copy(par, source);
+    CHECK(Equal(copy, source));
+    CHECK(copy.Capacity() == source.Capacity());
+}
+
+TEST(ParallelAssign) {
+    Vector<int> source(kLarge, 3);
+    Vector<int> target(10, 1);
+    target.Assign(par, source);
+    CHECK(Equal(target, source));
+
+    Vector<int> empty;
+    target.Assign(par, empty);
+    CHECK(target.Empty());
+}
+
+TEST(ParallelAssignSelf) {
+    Vector<std::string> vec(kLarge / 16, std::string("long enough to live on the heap"));
+    Vector<std::string> expected = vec;
+    Vector<std::string>& alias = vec;
+    vec.Assign(par, alias);
+    CHECK(Equal(vec, expected));
+}
+
+TEST(CopyAssignSelf) {
+    Vector<std::string> vec(100, std::string("long enough to live on the heap"));
+    Vector<std::string> expected = vec;
+    Vector<std::string>& alias = vec;
+    vec = alias;
+    CHECK(Equal(vec, expected));
+}
+
+TEST(ParallelResizeAndClear) {
+    Vector<int> vec;
+    vec.Resize(par, kLarge, 5);
+    CHECK(vec.Size() == kLarge);
+    CHECK(vec[0] == 5 && vec[kLarge - 1] == 5);
+
+    vec.Resize(par, 10);
+    CHECK(vec.Size() == 10);
+    vec.Clear(par);
+    CHECK(vec.Empty());
+}
+
+TEST(ParallelForCoversRange) {
+    std::atomic<size_t> sum = 0;
+    Vector<uint8_t> seen(kLarge, 0);
+    stdlike::ParallelFor(0, kLarge, 1000, [&](size_t begin, size_t end) {
+        for (size_t pos = begin; pos < end; pos++) {
+            seen[pos]++;
+        }
+        sum += end - begin;
+    });
+    CHECK(sum == kLarge);
+    for (size_t pos = 0; pos < kLarge; pos++) {
+        CHECK(seen[pos] == 1);
+    }
+}
+
+TEST(ParallelForRethrows) {
+    CHECK_THROWS(stdlike::ParallelFor(0, kLarge, 1000,
+                                      [](size_t, size_t end) {
+                                          if (end == kLarge) {
+                                              throw std::runtime_error("chunk failed");
+                                          }
+                                      }),
+                 std::runtime_error);
+}
+
+}  // namespace
+
+TEST_MAIN()
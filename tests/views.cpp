@@ -0,0 +1,135 @@
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <utility>
+
+#include <stdlike/views.hpp>
+
+#include "test.hpp"
+
+namespace {
+
+using stdlike::Vector;
+
+template <typename Type>
+bool Is(const Vector<Type>& vec, std::initializer_list<Type> expected) {
+    if (vec.Size() != expected.size()) {
+        return false;
+    }
+    size_t pos = 0;
+    for (const Type& value : expected) {
+        if (vec[pos++] != value) {
+            return false;
+        }
+    }
+    return true;
+}
+
+Vector<int> Iota(size_t size, int first = 0) {
+    Vector<int> vec;
+    for (size_t pos = 0; pos < size; pos++) {
+        vec.PushBack(first + static_cast<int>(pos));
+    }
+    return vec;
+}
+
+TEST(MapAndFilter) {
+    Vector<int> vec = Iota(10);
+    Vector<int> squares = stdlike::Map(vec, [](int value) {
+        return value * value;
+    });
+    CHECK(squares.Size() == 10 && squares[3] == 9 && squares[9] == 81);
+
+    auto even = [](int value) {
+        return value % 2 == 0;
+    };
+    Vector<int> evens = stdlike::Filter(vec, even);
+    CHECK(Is<int>(evens, {0, 2, 4, 6, 8}));
+
+    /* Map over a filter is pushed forward, Filter has no size */
+    Vector<std::string> names = stdlike::Map(stdlike::Filter(vec, even), [](int value) {
+        return std::to_string(value);
+    });
+    CHECK(Is<std::string>(names, {"0", "2", "4", "6", "8"}));
+}
+
+TEST(ZipSliceStride) {
+    Vector<int> lhs = Iota(5);
+    Vector<int> rhs = Iota(3, 10);
+    Vector<std::pair<int, int>> pairs = stdlike::Zip(lhs, rhs);
+    CHECK(pairs.Size() == 3);
+    CHECK(pairs[2] == std::make_pair(2, 12));
+
+    Vector<int> vec = Iota(10);
+    CHECK(Is<int>(Vector<int>(stdlike::Slice(vec, 2, 5)), {2, 3, 4}));
+    CHECK(Is<int>(Vector<int>(stdlike::Slice(vec, 8, 100)), {8, 9}));
+    CHECK(Vector<int>(stdlike::Slice(vec, 5, 2)).Empty());
+    CHECK(Is<int>(Vector<int>(stdlike::Stride(vec, 3)), {0, 3, 6, 9}));
+    CHECK(Is<int>(Vector<int>(stdlike::Stride(stdlike::Slice(vec, 1, 10), 4)), {1, 5, 9}));
+}
+
+TEST(ArithmeticExpressions) {
+    Vector<double> lhs(100, 2.0);
+    Vector<double> rhs(100, 3.0);
+    Vector<double> add(100, 1.0);
+    Vector<double> result = lhs * rhs + add;
+    CHECK(result.Size() == 100);
+    for (size_t pos = 0; pos < result.Size(); pos++) {
+        CHECK(result[pos] > 6.5 && result[pos] < 7.5);
+    }
+
+    Vector<int> ints = Iota(4);
+    CHECK(Is<int>(Vector<int>(ints * 2 - 1), {-1, 1, 3, 5}));
+    CHECK(Is<int>(Vector<int>(10 - ints), {10, 9, 8, 7}));
+    CHECK(Is<int>(Vector<int>(-ints), {0, -1, -2, -3}));
+    CHECK(Is<int>(Vector<int>(ints / 2), {0, 0, 1, 1}));
+
+    /* The shorter operand sets the size */
+    Vector<int> shorter = Iota(2, 5);
+    CHECK(Is<int>(Vector<int>(ints + shorter), {5, 7}));
+}
+
+TEST(EmptySources) {
+    Vector<int> empty;
+    CHECK(Vector<int>(stdlike::Map(empty, [](int value) { return value; })).Empty());
+    CHECK(Vector<int>(stdlike::Filter(empty, [](int) { return true; })).Empty());
+    CHECK(Vector<int>(empty + empty).Empty());
+    CHECK(Vector<int>(stdlike::Stride(empty, 2)).Empty());
+    CHECK(Vector<std::pair<int, int>>(stdlike::Zip(empty, Iota(3))).Empty());
+}
+
+TEST(AssignReadingTheTarget) {
+    Vector<int> vec = Iota(6);
+    vec = vec * vec;
+    CHECK(Is<int>(vec, {0, 1, 4, 9, 16, 25}));
+
+    vec = stdlike::Slice(vec, 2, 6) + vec;
+    CHECK(Is<int>(vec, {4, 10, 20, 34}));
+
+    vec = stdlike::Filter(vec, [](int value) {
+        return value > 10;
+    });
+    CHECK(Is<int>(vec, {20, 34}));
+}
+
+TEST(IntoBitVector) {
+    Vector<int> vec = Iota(100);
+    Vector<bool> even = stdlike::Map(vec, [](int value) {
+        return value % 2 == 0;
+    });
+    CHECK(even.Size() == 100);
+    for (size_t pos = 0; pos < even.Size(); pos++) {
+        CHECK(even[pos] == (pos % 2 == 0));
+    }
+
+    even = stdlike::Filter(stdlike::Map(vec, [](int value) { return value < 40; }), [](bool bit) { return bit; });
+    CHECK(even.Size() == 40);
+
+    even = vec - 50;
+    CHECK(even.Size() == 100 && even[0] && !even[50] && even[99]);
+}
+
+}  // namespace
+
+TEST_MAIN()
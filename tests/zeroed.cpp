@@ -0,0 +1,129 @@
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#include <stdlike/vector.hpp>
+
+#include "test.hpp"
+
+namespace {
+
+using stdlike::Vector;
+
+struct alignas(64) Wide {
+    uint64_t words[8];
+};
+
+template <typename Type>
+bool AllEqual(const Vector<Type>& vec, size_t start, const Type& value) {
+    for (size_t pos = start; pos < vec.Size(); pos++) {
+        if (!(vec[pos] == value)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+TEST(AllocateZeroed) {
+    stdlike::Allocator<uint64_t> allocator;
+    CHECK(allocator.AllocateZeroed(0) == nullptr);
+
+    for (size_t elems_n : {size_t(1), size_t(1000), size_t(1) << 20}) {
+        uint64_t* data = allocator.AllocateZeroed(elems_n);
+        size_t nonzero = 0;
+        for (size_t pos = 0; pos < elems_n; pos++) {
+            nonzero += (data[pos] != 0);
+        }
+        CHECK(nonzero == 0);
+        allocator.Deallocate(data, elems_n);
+    }
+    CHECK_THROWS((void)allocator.AllocateZeroed(SIZE_MAX / 4), std::bad_alloc);
+
+    /* Over-aligned types take the aligned_alloc path */
+    stdlike::Allocator<Wide> wide_allocator;
+    Wide* wide = wide_allocator.AllocateZeroed(3);
+    CHECK(reinterpret_cast<uintptr_t>(wide) % 64 == 0);
+    CHECK(wide[2].words[7] == 0);
+    wide_allocator.Deallocate(wide, 3);
+}
+
+TEST(ZeroFilledConstruction) {
+    Vector<int> empty(0, 0);
+    CHECK(empty.Empty());
+
+    Vector<int> ints(1 << 20, 0);
+    CHECK(AllEqual(ints, 0, 0));
+
+    Vector<int> sevens(1000, 7);
+    CHECK(AllEqual(sevens, 0, 7));
+
+    /* -0.0 is not all zero bytes */
+    Vector<double> negative_zeros(100, -0.0);
+    CHECK(std::signbit(negative_zeros[99]));
+    Vector<double> zeros(100, 0.0);
+    CHECK(!std::signbit(zeros[99]));
+
+    Vector<Wide> wide(10, Wide{});
+    CHECK(wide[9].words[7] == 0);
+}
+
+TEST(ZeroResize) {
+    Vector<int> vec(10, 5);
+    vec.Resize(2);
+
+    /* Within the capacity the old elements are overwritten */
+    vec.Resize(10, 0);
+    CHECK(vec[0] == 5 && vec[1] == 5);
+    CHECK(AllEqual(vec, 2, 0));
+
+    /* Past the capacity the tail comes from a zeroed buffer */
+    vec.Resize(100000);
+    CHECK(vec[1] == 5);
+    CHECK(AllEqual(vec, 2, 0));
+
+    vec.Resize(200000, 3);
+    CHECK(AllEqual(vec, 100000, 3));
+}
+
+TEST(Bits) {
+    Vector<bool> empty(0, false);
+    CHECK(empty.Empty());
+
+    for (size_t size : {size_t(1), size_t(31), size_t(32), size_t(33), size_t(100000)}) {
+        Vector<bool> zeros(size, false);
+        CHECK(AllEqual(zeros, 0, false));
+        Vector<bool> ones(size, true);
+        CHECK(AllEqual(ones, 0, true));
+    }
+
+    /* Bits left behind by a shrink are cleared on growth */
+    Vector<bool> bits(70, true);
+    bits.Resize(3);
+    bits.Resize(70, false);
+    CHECK(bits[2] && !bits[3]);
+    CHECK(AllEqual(bits, 3, false));
+
+    bits.Resize(3);
+    bits.Resize(100000, false);
+    CHECK(AllEqual(bits, 3, false));
+
+    bits.Resize(100033, true);
+    CHECK(AllEqual(bits, 100000, true));
+    CHECK(*(bits.End() - 1));
+}
+
+TEST(BitsSelfAssignment) {
+    Vector<bool> bits(100, true);
+    const Vector<bool>& alias = bits;
+    bits = alias;
+    CHECK(bits.Size() == 100 && bits.Count() == 100);
+
+    Vector<bool> other(40, false);
+    bits = other;
+    CHECK(bits.Size() == 40 && bits.Count() == 0);
+}
+
+}  // namespace
+
+TEST_MAIN()